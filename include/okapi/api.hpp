@@ -14,6 +14,9 @@
 #include "okapi/api/chassis/model/skidSteerModel.hpp"
 #include "okapi/api/chassis/model/threeEncoderSkidSteerModel.hpp"
 #include "okapi/api/chassis/model/xDriveModel.hpp"
+#include "okapi/api/chassis/simulator/chassisSimulator.hpp"
+#include "okapi/api/chassis/simulator/skidSteerSimulator.hpp"
+#include "okapi/api/chassis/simulator/xDriveSimulator.hpp"
 #include "okapi/impl/chassis/controller/chassisControllerFactory.hpp"
 #include "okapi/impl/chassis/model/chassisModelFactory.hpp"
 
@@ -26,21 +29,35 @@
 #include "okapi/api/control/async/asyncWrapper.hpp"
 #include "okapi/api/control/controllerInput.hpp"
 #include "okapi/api/control/controllerOutput.hpp"
+#include "okapi/api/control/controllerPipeline.hpp"
+#include "okapi/api/control/iterative/iterativeGainScheduledPosPidController.hpp"
 #include "okapi/api/control/iterative/iterativeMotorVelocityController.hpp"
 #include "okapi/api/control/iterative/iterativePosPidController.hpp"
 #include "okapi/api/control/iterative/iterativeVelPidController.hpp"
 #include "okapi/api/control/util/controllerRunner.hpp"
+#include "okapi/api/control/util/controllerSweep.hpp"
+#include "okapi/api/control/util/feedforward.hpp"
 #include "okapi/api/control/util/flywheelSimulator.hpp"
+#include "okapi/api/control/util/nelderMeadOptimizer.hpp"
+#include "okapi/api/control/util/particleSwarmOptimizer.hpp"
+#include "okapi/api/control/util/pathVelocityPlanner.hpp"
 #include "okapi/api/control/util/pidTuner.hpp"
+#include "okapi/api/control/util/pidTunerOptimizer.hpp"
+#include "okapi/api/control/util/ramsete.hpp"
+#include "okapi/api/control/util/relayTuner.hpp"
 #include "okapi/api/control/util/settledUtil.hpp"
+#include "okapi/api/control/util/simulatedPidTuner.hpp"
 #include "okapi/impl/control/async/asyncControllerFactory.hpp"
 #include "okapi/impl/control/iterative/iterativeControllerFactory.hpp"
 #include "okapi/impl/control/util/controllerRunnerFactory.hpp"
+#include "okapi/impl/control/util/controllerSweepFactory.hpp"
 #include "okapi/impl/control/util/pidTunerFactory.hpp"
 #include "okapi/impl/control/util/settledUtilFactory.hpp"
 
+#include "okapi/api/device/motor/simulatedMotor.hpp"
 #include "okapi/api/device/rotarysensor/continuousRotarySensor.hpp"
 #include "okapi/api/device/rotarysensor/rotarySensor.hpp"
+#include "okapi/api/device/rotarysensor/simulatedIntegratedEncoder.hpp"
 #include "okapi/impl/device/adiUltrasonic.hpp"
 #include "okapi/impl/device/button/adiButton.hpp"
 #include "okapi/impl/device/button/controllerButton.hpp"
@@ -54,17 +71,27 @@
 #include "okapi/impl/device/vision.hpp"
 
 #include "okapi/api/filter/averageFilter.hpp"
+#include "okapi/api/filter/biquadFilter.hpp"
 #include "okapi/api/filter/composableFilter.hpp"
 #include "okapi/api/filter/demaFilter.hpp"
 #include "okapi/api/filter/ekfFilter.hpp"
 #include "okapi/api/filter/emaFilter.hpp"
 #include "okapi/api/filter/filter.hpp"
+#include "okapi/api/filter/filterChain.hpp"
 #include "okapi/api/filter/filteredControllerInput.hpp"
+#include "okapi/api/filter/kalmanFilter.hpp"
 #include "okapi/api/filter/medianFilter.hpp"
 #include "okapi/api/filter/passthroughFilter.hpp"
+#include "okapi/api/filter/runningAverageFilter.hpp"
+#include "okapi/api/filter/savitzkyGolayVelMath.hpp"
+#include "okapi/api/filter/slidingMedianFilter.hpp"
 #include "okapi/api/filter/velMath.hpp"
 #include "okapi/impl/filter/velMathFactory.hpp"
 
+#include "okapi/api/odometry/odomState.hpp"
+#include "okapi/api/odometry/odometry.hpp"
+#include "okapi/api/odometry/poseHistory.hpp"
+
 #include "okapi/api/units/QAcceleration.hpp"
 #include "okapi/api/units/QAngle.hpp"
 #include "okapi/api/units/QAngularAcceleration.hpp"
@@ -84,8 +111,12 @@
 
 #include "okapi/api/util/abstractRate.hpp"
 #include "okapi/api/util/abstractTimer.hpp"
+#include "okapi/api/util/leftRightBuffer.hpp"
 #include "okapi/api/util/mathUtil.hpp"
+#include "okapi/api/util/matrix.hpp"
+#include "okapi/api/util/parallelFor.hpp"
 #include "okapi/api/util/supplier.hpp"
+#include "okapi/api/util/timestampedHistory.hpp"
 #include "okapi/api/util/timeUtil.hpp"
 #include "okapi/impl/util/rate.hpp"
 #include "okapi/impl/util/timeUtilFactory.hpp"
@@ -190,6 +190,13 @@ class ChassisModel : public ReadOnlyChassisModel {
    */
   virtual void setMaxVoltage(double imaxVoltage);
 
+  /**
+   * Returns the maximum voltage in mV. Voltage-mode commands in [-1, 1] are scaled by this.
+   *
+   * @return the maximum voltage
+   */
+  double getMaxVoltage() const;
+
   protected:
   double maxVelocity;
   double maxVoltage;
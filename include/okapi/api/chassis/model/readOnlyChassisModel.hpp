@@ -8,6 +8,7 @@
 #pragma once
 
 #include "okapi/api/coreProsAPI.hpp"
+#include <cstddef>
 #include <valarray>
 
 namespace okapi {
@@ -26,5 +27,16 @@ class ReadOnlyChassisModel {
    * @return sensor readings (format is implementation dependent)
    */
   virtual std::valarray<std::int32_t> getSensorVals() const = 0;
+
+  /**
+   * Read the sensors into an array without allocating, for control loops. The default
+   * implementation copies from getSensorVals(), which allocates; models override it to read their
+   * sensors directly.
+   *
+   * @param ovalues filled with the sensor readings in the same format as getSensorVals()
+   * @param icount the length of ovalues. Extra readings are not written.
+   * @return the number of readings written
+   */
+  virtual std::size_t fillSensorVals(std::int32_t *ovalues, std::size_t icount) const;
 };
 } // namespace okapi
@@ -37,6 +37,15 @@ class ThreeEncoderSkidSteerModel : public SkidSteerModel {
    */
   std::valarray<std::int32_t> getSensorVals() const override;
 
+  /**
+   * Read the sensors into an array without allocating.
+   *
+   * @param ovalues filled with the sensor readings in the format {left, right, middle}
+   * @param icount the length of ovalues
+   * @return the number of readings written
+   */
+  std::size_t fillSensorVals(std::int32_t *ovalues, std::size_t icount) const override;
+
   /**
    * Reset the sensors to their zero point.
    */
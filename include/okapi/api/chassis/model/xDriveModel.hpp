@@ -10,10 +10,19 @@
 #include "okapi/api/chassis/model/chassisModel.hpp"
 #include "okapi/api/device/motor/abstractMotor.hpp"
 #include "okapi/api/device/rotarysensor/continuousRotarySensor.hpp"
+#include <array>
 
 namespace okapi {
 class XDriveModel : public ChassisModel {
   public:
+  /**
+   * How setWheelCommands() drives the motors.
+   */
+  enum class commandMode {
+    velocity, ///< Commands are scaled by the maximum velocity
+    voltage   ///< Commands are scaled by the maximum voltage
+  };
+
   /**
    * Model for an x drive (wheels at 45 deg from a skid steer drive). When all motors are powered
    * +100%, the robot should move forward in a straight line.
@@ -112,6 +121,30 @@ class XDriveModel : public ChassisModel {
   virtual void
   xArcade(double irightSpeed, double iforwardSpeed, double iyaw, double ithreshold = 0) const;
 
+  /**
+   * Drive the robot from a kinematic command. All four wheel outputs are computed first and then
+   * scaled down together if any is out of [-1, 1], so the robot keeps moving in the commanded
+   * direction at the highest speed it can (unlike xArcade(), which clamps each wheel).
+   *
+   * @param iforwardSpeed speed in the forward direction
+   * @param irightSpeed speed to the right
+   * @param iyaw speed around the vertical axis, clockwise
+   * @param imode whether to use velocity or voltage mode
+   */
+  virtual void driveHolonomic(double iforwardSpeed,
+                              double irightSpeed,
+                              double iyaw,
+                              commandMode imode = commandMode::voltage) const;
+
+  /**
+   * Set the output of every wheel at once. If any output is out of [-1, 1], all of them are
+   * scaled down together by the same amount.
+   *
+   * @param ispeeds the outputs of the top left, top right, bottom right, and bottom left wheels
+   * @param imode whether to use velocity or voltage mode
+   */
+  virtual void setWheelCommands(const std::array<double, 4> &ispeeds, commandMode imode) const;
+
   /**
    * Power the left side motors. Uses velocity mode.
    *
@@ -133,6 +166,15 @@ class XDriveModel : public ChassisModel {
    */
   std::valarray<std::int32_t> getSensorVals() const override;
 
+  /**
+   * Read the sensors into an array without allocating.
+   *
+   * @param ovalues filled with the sensor readings in the format {left, right}
+   * @param icount the length of ovalues
+   * @return the number of readings written
+   */
+  std::size_t fillSensorVals(std::int32_t *ovalues, std::size_t icount) const override;
+
   /**
    * Reset the sensors to their zero point.
    */
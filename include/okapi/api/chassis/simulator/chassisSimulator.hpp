@@ -0,0 +1,120 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/device/motor/simulatedMotor.hpp"
+#include "okapi/api/units/QAngle.hpp"
+#include "okapi/api/units/QAngularSpeed.hpp"
+#include "okapi/api/units/QLength.hpp"
+#include "okapi/api/units/QMass.hpp"
+#include "okapi/api/units/QSpeed.hpp"
+#include "okapi/api/units/QTime.hpp"
+#include <memory>
+#include <vector>
+
+namespace okapi {
+/**
+ * Simulates a chassis driven by SimulatedMotors as a rigid body in the plane. Each step, the
+ * motors' torques push the chassis through their wheels, the chassis velocity and pose are
+ * integrated, and the motors are moved to match the chassis. Steps run in virtual time, so the
+ * chassis models and controllers can drive the motors while the simulation is stepped as fast as
+ * it can be computed.
+ *
+ * The pose uses x forward and y to the left of the starting heading, with theta counterclockwise.
+ */
+class ChassisSimulator {
+  public:
+  struct Pose {
+    QLength x{0 * meter};
+    QLength y{0 * meter};
+    QAngle theta{0 * radian};
+  };
+
+  virtual ~ChassisSimulator();
+
+  /**
+   * Advances the simulation by the given time. Long steps are split into steps of at most one
+   * millisecond.
+   *
+   * @param idt the time to advance by
+   */
+  void step(QTime idt);
+
+  /**
+   * @return the pose of the chassis
+   */
+  Pose getPose() const;
+
+  /**
+   * Moves the chassis to the given pose without changing its velocity.
+   *
+   * @param ipose the new pose
+   */
+  void setPose(const Pose &ipose);
+
+  /**
+   * @return the velocity of the chassis along its heading
+   */
+  QSpeed getForwardVelocity() const;
+
+  /**
+   * @return the velocity of the chassis to its left
+   */
+  QSpeed getStrafeVelocity() const;
+
+  /**
+   * @return the counterclockwise angular velocity of the chassis
+   */
+  QAngularSpeed getAngularVelocity() const;
+
+  /**
+   * @return the virtual time the chassis has been simulated for
+   */
+  QTime getTime() const;
+
+  protected:
+  struct Wheel {
+    std::shared_ptr<SimulatedMotor> motor;
+    double motorCount; // Identical motors geared together on this wheel
+    double x, y;       // Position relative to the center of the chassis, m
+    double dirX, dirY; // Unit vector the wheel pushes along when the motor turns forward
+  };
+
+  static constexpr double maxStep = 0.001; // s
+
+  std::vector<Wheel> wheels;
+  const double wheelRadius;     // m
+  const double mass;            // kg
+  const double momentOfInertia; // kg*m^2
+  const bool nonHolonomic;      // Whether the chassis cannot slide sideways
+
+  double x{0}, y{0}, theta{0};   // World frame pose
+  double vx{0}, vy{0}, omega{0}; // Chassis frame velocity
+  double time{0};                // s
+
+  /**
+   * A chassis simulator.
+   *
+   * @param iwheels the wheels of the chassis
+   * @param iwheelDiameter the diameter of the wheels
+   * @param imass the mass of the chassis
+   * @param imomentOfInertia the moment of inertia of the chassis about its center in kg*m^2
+   * @param inonHolonomic whether the chassis cannot slide sideways
+   */
+  ChassisSimulator(std::vector<Wheel> iwheels,
+                   QLength iwheelDiameter,
+                   QMass imass,
+                   double imomentOfInertia,
+                   bool inonHolonomic);
+
+  /**
+   * @return the velocity of the wheel's motor in rad/s for the current chassis velocity
+   */
+  double wheelVelocity(const Wheel &iwheel) const;
+};
+} // namespace okapi
@@ -0,0 +1,39 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/chassis/simulator/chassisSimulator.hpp"
+
+namespace okapi {
+/**
+ * Simulates a differential (skid-steer) chassis. Use the motors with a SkidSteerModel to drive it.
+ * The wheels cannot slide sideways and do not scrub when turning.
+ */
+class SkidSteerSimulator : public ChassisSimulator {
+  public:
+  /**
+   * Simulates a differential (skid-steer) chassis.
+   *
+   * @param ileftMotor the motor driving the left side
+   * @param irightMotor the motor driving the right side
+   * @param iwheelDiameter the diameter of the wheels
+   * @param iwheelbaseWidth the distance between the left and right wheels
+   * @param imass the mass of the chassis
+   * @param imomentOfInertia the moment of inertia of the chassis about its center in kg*m^2
+   * @param imotorsPerSide the number of motors each motor stands in for, like a MotorGroup of
+   * identical motors
+   */
+  SkidSteerSimulator(const std::shared_ptr<SimulatedMotor> &ileftMotor,
+                     const std::shared_ptr<SimulatedMotor> &irightMotor,
+                     QLength iwheelDiameter,
+                     QLength iwheelbaseWidth,
+                     QMass imass = 5 * kg,
+                     double imomentOfInertia = 0.25,
+                     std::size_t imotorsPerSide = 2);
+};
+} // namespace okapi
@@ -0,0 +1,42 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/chassis/simulator/chassisSimulator.hpp"
+
+namespace okapi {
+/**
+ * Simulates an X-drive chassis with omni wheels at 45 degrees in each corner. Use the motors with
+ * an XDriveModel to drive it; the motor directions match XDriveModel's.
+ */
+class XDriveSimulator : public ChassisSimulator {
+  public:
+  /**
+   * Simulates an X-drive chassis.
+   *
+   * @param itopLeftMotor the top left motor
+   * @param itopRightMotor the top right motor
+   * @param ibottomRightMotor the bottom right motor
+   * @param ibottomLeftMotor the bottom left motor
+   * @param iwheelDiameter the diameter of the wheels
+   * @param iwheelbaseWidth the distance between the left and right wheels
+   * @param iwheelbaseLength the distance between the front and back wheels
+   * @param imass the mass of the chassis
+   * @param imomentOfInertia the moment of inertia of the chassis about its center in kg*m^2
+   */
+  XDriveSimulator(const std::shared_ptr<SimulatedMotor> &itopLeftMotor,
+                  const std::shared_ptr<SimulatedMotor> &itopRightMotor,
+                  const std::shared_ptr<SimulatedMotor> &ibottomRightMotor,
+                  const std::shared_ptr<SimulatedMotor> &ibottomLeftMotor,
+                  QLength iwheelDiameter,
+                  QLength iwheelbaseWidth,
+                  QLength iwheelbaseLength,
+                  QMass imass = 5 * kg,
+                  double imomentOfInertia = 0.25);
+};
+} // namespace okapi
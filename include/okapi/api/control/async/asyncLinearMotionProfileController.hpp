@@ -8,12 +8,15 @@
 #pragma once
 
 #include "okapi/api/control/async/asyncPositionController.hpp"
+#include "okapi/api/control/controllerInput.hpp"
 #include "okapi/api/control/controllerOutput.hpp"
+#include "okapi/api/control/util/feedforward.hpp"
 #include "okapi/api/units/QAngle.hpp"
 #include "okapi/api/units/QLength.hpp"
 #include "okapi/api/util/logging.hpp"
 #include "okapi/api/util/timeUtil.hpp"
 #include <atomic>
+#include <functional>
 #include <map>
 
 extern "C" {
@@ -156,6 +159,33 @@ class AsyncLinearMotionProfileController : public AsyncPositionController<std::s
    */
   bool isDisabled() const override;
 
+  /**
+   * Follows paths by writing the output of the given feedforward model instead of each segment's
+   * velocity divided by the maximum velocity. The gains should produce the controller output's
+   * units (usually [-1, 1]) from the profile's units. If kP is nonzero and a position input is
+   * given, the position error is corrected for. Takes effect the next time a path is followed.
+   *
+   * @param igains the feedforward gains
+   * @param iposition the measured position, used for kP and the tracking callback, or nullptr
+   */
+  void setFeedforward(const Feedforward::Gains &igains,
+                      const std::shared_ptr<ControllerInput<double>> &iposition = nullptr);
+
+  /**
+   * Follows paths by writing each segment's velocity divided by the maximum velocity (the default).
+   * Takes effect the next time a path is followed.
+   */
+  void disableFeedforward();
+
+  /**
+   * Sets a function which is called at every step of a path with how closely it is being followed.
+   * The measured position is only filled in if a position input was given to setFeedforward().
+   * Takes effect the next time a path is followed.
+   *
+   * @param icallback called with the tracking sample, or nullptr to remove it
+   */
+  void setTrackingCallback(std::function<void(const ProfileTrackingSample &)> icallback);
+
   /**
    * Starts the internal thread. This should not be called by normal users. This method is called
    * by the AsyncControllerFactory when making a new instance of this class.
@@ -177,6 +207,17 @@ class AsyncLinearMotionProfileController : public AsyncPositionController<std::s
   double currentProfilePosition{0};
   TimeUtil timeUtil;
 
+  // The settings paths are followed with. The setters change them under settingsMutex and each path
+  // copies them once when it starts, so changing them never races the path being followed.
+  struct PathSettings {
+    bool useFeedforward{false};
+    Feedforward feedforward{Feedforward::Gains{}};
+    std::shared_ptr<ControllerInput<double>> positionInput;
+    std::function<void(const ProfileTrackingSample &)> trackingCallback;
+  };
+  PathSettings settings;
+  CrossplatformMutex settingsMutex;
+
   std::string currentPath{""};
   std::atomic_bool isRunning{false};
   std::atomic_bool disabled{false};
@@ -190,5 +231,12 @@ class AsyncLinearMotionProfileController : public AsyncPositionController<std::s
    * Follow the supplied path. Must follow the disabled lifecycle.
    */
   virtual void executeSinglePath(const TrajectoryPair &path, std::unique_ptr<AbstractRate> rate);
+
+  /**
+   * Copies the path settings while holding settingsMutex.
+   *
+   * @return the current path settings
+   */
+  PathSettings getSettings();
 };
 } // namespace okapi
@@ -10,6 +10,12 @@
 #include "okapi/api/chassis/controller/chassisScales.hpp"
 #include "okapi/api/chassis/model/skidSteerModel.hpp"
 #include "okapi/api/control/async/asyncPositionController.hpp"
+#include "okapi/api/control/controllerInput.hpp"
+#include "okapi/api/control/util/feedforward.hpp"
+#include "okapi/api/control/util/pathVelocityPlanner.hpp"
+#include "okapi/api/control/util/ramsete.hpp"
+#include "okapi/api/device/rotarysensor/continuousRotarySensor.hpp"
+#include "okapi/api/odometry/odomState.hpp"
 #include "okapi/api/units/QAngle.hpp"
 #include "okapi/api/units/QAngularSpeed.hpp"
 #include "okapi/api/units/QLength.hpp"
@@ -17,6 +23,7 @@
 #include "okapi/api/util/logging.hpp"
 #include "okapi/api/util/timeUtil.hpp"
 #include <atomic>
+#include <functional>
 #include <map>
 
 extern "C" {
@@ -32,6 +39,18 @@ struct Point {
 
 class AsyncMotionProfileController : public AsyncPositionController<std::string, Point> {
   public:
+  /**
+   * Gains for the encoder follower. The output is a fraction of the maximum voltage, so for
+   * example kV is about one over the maximum velocity of the chassis.
+   */
+  struct FollowerGains {
+    double kP{0};    // Output per meter of position error
+    double kD{0};    // Output per meter per second of change in position error
+    double kV{0};    // Output per meter per second of target velocity
+    double kA{0};    // Output per meter per second squared of target acceleration
+    double kTurn{0}; // Output per degree of heading error, used only with a gyro
+  };
+
   /**
    * An Async Controller which generates and follows 2D motion profiles. Throws a
    * std::invalid_argument exception if the gear ratio is zero.
@@ -67,6 +86,31 @@ class AsyncMotionProfileController : public AsyncPositionController<std::string,
    */
   void generatePath(std::initializer_list<Point> iwaypoints, const std::string &ipathId);
 
+  /**
+   * Generates a path for a holonomic chassis which intersects the given waypoints and saves it
+   * internally with a key of pathId, like generatePath(). The waypoints give the direction of
+   * travel, which is independent of the direction the chassis faces: the chassis starts facing
+   * 0_deg and strafes along the path while turning to iheading, spread evenly over the length of
+   * the path. For example, the waypoints {0_m, 0_m, 90_deg} and {0_m, 2_ft, 90_deg} strafe two
+   * feet to the left without turning.
+   *
+   * The path is followed by commanding each wheel of an XDriveModel separately, so the chassis
+   * model must be an XDriveModel; otherwise, an instance of std::runtime_error is thrown (and an
+   * error is logged). The chassis must be square, with wheelbaseWidth between the wheels on each
+   * side. The scales are for driving forward; because the wheels roll at 45 degrees, the
+   * effective wheel diameter of an X-drive is about sqrt(2) times the real one. Feedforward is
+   * used if it is enabled, but without position correction; RAMSETE and the encoder follower are
+   * not used for holonomic paths.
+   *
+   * @param iwaypoints The waypoints to hit on the path.
+   * @param ipathId A unique identifier to save the path with.
+   * @param iheading The heading of the chassis at the end of the path, relative to its heading at
+   * the start and counterclockwise.
+   */
+  void generateHolonomicPath(std::initializer_list<Point> iwaypoints,
+                             const std::string &ipathId,
+                             QAngle iheading = 0_deg);
+
   /**
    * Removes a path and frees the memory it used.
    *
@@ -171,6 +215,86 @@ class AsyncMotionProfileController : public AsyncPositionController<std::string,
    */
   bool isDisabled() const override;
 
+  /**
+   * Follows paths in voltage mode using the given feedforward gains instead of sending each
+   * segment's velocity to the motors' velocity controllers. The gains take meters, meters per
+   * second, and meters per second squared and produce millivolts. If kP is nonzero, the position
+   * error of each side (measured with the chassis model's sensors) is corrected for. Takes effect
+   * the next time a path is followed.
+   *
+   * @param igains the feedforward gains for each side of the chassis
+   */
+  void setFeedforward(const Feedforward::Gains &igains);
+
+  /**
+   * Follows paths using the motors' velocity controllers (the default). Takes effect the next time
+   * a path is followed.
+   */
+  void disableFeedforward();
+
+  /**
+   * Follows paths in closed loop using the RAMSETE controller. Each step, the pose the path wants
+   * is compared with the measured pose, and the left and right velocities are corrected so the
+   * chassis converges back onto the path. This corrects wheel slip and motor lag, which otherwise
+   * accumulate over a path. The path is followed relative to the pose at the start of the path.
+   * The corrected velocities are sent to the motors the same way as without RAMSETE (in velocity
+   * mode, or in voltage mode if feedforward is enabled, though kP is not used). Takes effect the
+   * next time a path is followed.
+   *
+   * @param iposeInput the measured pose, like Odometry
+   * @param igains the RAMSETE gains
+   */
+  void setRamsete(const std::shared_ptr<ControllerInput<OdomState>> &iposeInput,
+                  const Ramsete::Gains &igains = Ramsete::Gains{});
+
+  /**
+   * Follows paths in open loop (the default). Takes effect the next time a path is followed.
+   */
+  void disableRamsete();
+
+  /**
+   * Follows paths in voltage mode with pathfinder's encoder follower. Each side is driven by its
+   * own feedforward on the segment's velocity and acceleration, plus PD feedback on the position
+   * error measured with the chassis model's sensors. If a gyro is given, the difference between
+   * the heading the path wants and the gyro's heading (both relative to the start of the path) is
+   * also corrected by turning. This corrects each side without needing a pose estimate. Takes
+   * effect the next time a path is followed. RAMSETE takes priority if it is also enabled.
+   *
+   * @param igains the follower gains
+   * @param igyro the gyro, or nullptr for no heading correction. Its readings are in tenths of a
+   * degree (like ADIGyro's) and should increase counterclockwise.
+   */
+  void setEncoderFollower(const FollowerGains &igains,
+                          const std::shared_ptr<ContinuousRotarySensor> &igyro = nullptr);
+
+  /**
+   * Stops using the encoder follower. Takes effect the next time a path is followed.
+   */
+  void disableEncoderFollower();
+
+  /**
+   * Sets whether generatePath() plans the velocity along each path with a PathVelocityPlanner.
+   * Without planning, one maximum velocity is used for the whole path, so the outer wheel can be
+   * asked to go faster than the motors can on tight curves. With planning, the velocity is limited
+   * at each point so neither side goes faster than the gearset's free speed, which lets straight
+   * sections run at the maximum velocity while curves slow down only where they must. Takes effect
+   * the next time a path is generated.
+   *
+   * @param ienabled whether to plan the velocity
+   */
+  void setVelocityPlanning(bool ienabled);
+
+  /**
+   * Sets a function which is called at every step of a path with how closely each side of the
+   * chassis is following it. Useful for logging data to characterize the chassis with
+   * Feedforward::characterize() and for measuring tracking error. Takes effect the next time a
+   * path is followed.
+   *
+   * @param icallback called with the left and right tracking samples, or nullptr to remove it
+   */
+  void setTrackingCallback(
+    std::function<void(const ProfileTrackingSample &, const ProfileTrackingSample &)> icallback);
+
   /**
    * Starts the internal thread. This should not be called by normal users. This method is called
    * by the AsyncControllerFactory when making a new instance of this class.
@@ -182,6 +306,10 @@ class AsyncMotionProfileController : public AsyncPositionController<std::string,
     Segment *left;
     Segment *right;
     int length;
+    // Holonomic paths only store the trajectory of the center of the chassis, in left (right is
+    // nullptr). Every wheel follows it, so each wheel's velocity is computed from it.
+    bool holonomic{false};
+    double endHeading{0}; // rad
   };
 
   Logger *logger;
@@ -194,6 +322,24 @@ class AsyncMotionProfileController : public AsyncPositionController<std::string,
   AbstractMotor::GearsetRatioPair pair;
   TimeUtil timeUtil;
 
+  // The settings paths are followed with. The setters change them under settingsMutex and each path
+  // copies them once when it starts, so changing them never races the path being followed.
+  struct PathSettings {
+    bool useFeedforward{false};
+    Feedforward feedforward{Feedforward::Gains{}};
+    std::function<void(const ProfileTrackingSample &, const ProfileTrackingSample &)>
+      trackingCallback;
+    std::shared_ptr<ControllerInput<OdomState>> poseInput{nullptr};
+    Ramsete ramsete{Ramsete::Gains{}};
+    bool useEncoderFollower{false};
+    FollowerGains followerGains{};
+    std::shared_ptr<ContinuousRotarySensor> gyro{nullptr};
+  };
+  PathSettings settings;
+  CrossplatformMutex settingsMutex;
+
+  bool useVelocityPlanning{false};
+
   std::string currentPath{""};
   std::atomic_bool isRunning{false};
   std::atomic_int direction{1};
@@ -209,6 +355,95 @@ class AsyncMotionProfileController : public AsyncPositionController<std::string,
    */
   virtual void executeSinglePath(const TrajectoryPair &path, std::unique_ptr<AbstractRate> rate);
 
+  /**
+   * Copies the path settings while holding settingsMutex.
+   *
+   * @return the current path settings
+   */
+  PathSettings getSettings();
+
+  /**
+   * Follow the supplied path in closed loop with RAMSETE. Must follow the disabled lifecycle.
+   */
+  void executeRamsetePath(const TrajectoryPair &path,
+                          AbstractRate &rate,
+                          const PathSettings &isettings);
+
+  /**
+   * The state of the encoder follower for one side of the chassis.
+   */
+  struct FollowerSide {
+    EncoderConfig config;
+    EncoderFollower follower;
+    Segment *trajectory;
+  };
+
+  /**
+   * Follow the supplied path with the encoder follower. Must follow the disabled lifecycle.
+   */
+  void executeEncoderFollowerPath(const TrajectoryPair &path,
+                                  AbstractRate &rate,
+                                  const PathSettings &isettings);
+
+  /**
+   * Follow the supplied holonomic path by commanding each wheel of the XDriveModel. Must follow
+   * the disabled lifecycle.
+   */
+  void executeHolonomicPath(const TrajectoryPair &path,
+                            AbstractRate &rate,
+                            const PathSettings &isettings);
+
+  /**
+   * Generates the trajectory of the center of the chassis through the waypoints. Throws a
+   * std::runtime_error if the path is impossible.
+   *
+   * @param iwaypoints The waypoints to hit on the path.
+   * @param olength Set to the number of segments in the trajectory.
+   * @return The trajectory, allocated with malloc(), or nullptr if there are no waypoints.
+   */
+  Segment *generateTrajectory(std::initializer_list<Point> iwaypoints, int &olength);
+
+  /**
+   * Plans the velocity along a trajectory from generateTrajectory() with a PathVelocityPlanner.
+   * Throws a std::runtime_error if the planned trajectory cannot be allocated.
+   *
+   * @param itrajectory The trajectory, which is freed.
+   * @param iolength The number of segments in the trajectory, set to the number of segments in the
+   * planned trajectory.
+   * @return The planned trajectory, allocated with malloc().
+   */
+  Segment *planVelocity(Segment *itrajectory, int &iolength);
+
+  /**
+   * Frees the trajectories of a path.
+   */
+  static void freePath(const TrajectoryPair &path);
+
+  /**
+   * Sends the velocity of each side to the motors, in voltage mode if feedforward is enabled and
+   * in velocity mode otherwise.
+   *
+   * @param ileftVelocity the left velocity in m/s
+   * @param irightVelocity the right velocity in m/s
+   * @param ileftAcceleration the left acceleration in m/s^2
+   * @param irightAcceleration the right acceleration in m/s^2
+   * @param isettings the settings of the path being followed
+   * @return the {left, right} outputs written to the motors
+   */
+  std::pair<double, double> writeVelocities(double ileftVelocity,
+                                            double irightVelocity,
+                                            double ileftAcceleration,
+                                            double irightAcceleration,
+                                            const PathSettings &isettings);
+
+  /**
+   * Returns the distance each side of the chassis has traveled, measured with the chassis model's
+   * sensors. The sensors are assumed to measure motor degrees.
+   *
+   * @return the {left, right} distances in meters
+   */
+  std::pair<double, double> getMeasuredPositions() const;
+
   /**
    * Converts linear chassis speed to rotational motor speed.
    *
@@ -0,0 +1,303 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/control/closedLoopController.hpp"
+#include "okapi/api/units/QTime.hpp"
+#include <type_traits>
+#include <utility>
+
+namespace okapi {
+/**
+ * Adapts a pointer (raw or smart) to a ControllerInput, Filter, IterativeController, or
+ * ControllerOutput so it can be used as a ControllerPipeline stage. Only the methods the stage is
+ * used for need to exist on the pointee, because the forwarding methods are only instantiated when
+ * they are called. Calls through this adapter are virtual, so prefer storing
+ * concrete stages by value when the type is known.
+ *
+ * @tparam Pointer the pointer type
+ */
+template <typename Pointer> class PointerStage {
+  public:
+  explicit PointerStage(Pointer iptr) : ptr(std::move(iptr)) {
+  }
+
+  double controllerGet() {
+    return ptr->controllerGet();
+  }
+
+  double filter(const double ireading) {
+    return ptr->filter(ireading);
+  }
+
+  double step(const double ireading) {
+    return ptr->step(ireading);
+  }
+
+  double step(const double ireading, const QTime inow) {
+    return ptr->step(ireading, inow);
+  }
+
+  void controllerSet(const double ivalue) {
+    ptr->controllerSet(ivalue);
+  }
+
+  double getOutput() const {
+    return ptr->getOutput();
+  }
+
+  void setTarget(const double itarget) {
+    ptr->setTarget(itarget);
+  }
+
+  double getTarget() {
+    return ptr->getTarget();
+  }
+
+  double getError() const {
+    return ptr->getError();
+  }
+
+  bool isSettled() {
+    return ptr->isSettled();
+  }
+
+  void reset() {
+    ptr->reset();
+  }
+
+  void flipDisable(const bool iisDisabled) {
+    ptr->flipDisable(iisDisabled);
+  }
+
+  bool isDisabled() const {
+    return ptr->isDisabled();
+  }
+
+  Pointer &get() {
+    return ptr;
+  }
+
+  protected:
+  Pointer ptr;
+};
+
+/**
+ * Creates a PointerStage, deducing the pointer type.
+ *
+ * @param iptr the pointer to adapt
+ * @return a pipeline stage which forwards to the pointer
+ */
+template <typename Pointer> PointerStage<Pointer> makePointerStage(Pointer iptr) {
+  return PointerStage<Pointer>(std::move(iptr));
+}
+
+/**
+ * A control loop composed at compile time: input -> filter -> controller -> output. The stages are
+ * stored by value and called through their concrete types, so a pipeline of concrete stages
+ * (e.g. a sensor, an EmaFilter, and an IterativePosPIDController) runs one tick without virtual
+ * dispatch or reference counting between the stages. Existing virtual implementations can be used
+ * as stages through PointerStage.
+ *
+ * The pipeline itself is a ClosedLoopController, so code which works with the virtual interface
+ * (setting targets, checking if settled, etc.) can still use it.
+ *
+ * @tparam InputType has double controllerGet()
+ * @tparam FilterType has double filter(double)
+ * @tparam ControllerType an IterativeController<double, double> (or anything with the same
+ * methods)
+ * @tparam OutputType has void controllerSet(double)
+ */
+template <typename InputType, typename FilterType, typename ControllerType, typename OutputType>
+class ControllerPipeline : public ClosedLoopController<double, double> {
+  public:
+  /**
+   * A control loop composed at compile time. Each stage is moved into the pipeline.
+   *
+   * @param iinput the controller input
+   * @param ifilter the filter applied to the input before it reaches the controller
+   * @param icontroller the controller
+   * @param ioutput the controller output
+   */
+  ControllerPipeline(InputType &&iinput,
+                     FilterType &&ifilter,
+                     ControllerType &&icontroller,
+                     OutputType &&ioutput)
+    : input(std::move(iinput)),
+      filter(std::move(ifilter)),
+      controller(std::move(icontroller)),
+      output(std::move(ioutput)) {
+  }
+
+  /**
+   * Runs one tick of the control loop: reads the input, filters it, steps the controller, and
+   * writes the controller output. Does nothing if the controller is disabled.
+   *
+   * @return the controller output
+   */
+  double step() {
+    if (controller.isDisabled()) {
+      return 0;
+    }
+
+    const double out = controller.step(filter.filter(input.controllerGet()));
+    output.controllerSet(out);
+    return out;
+  }
+
+  /**
+   * Runs one tick of the control loop using the given timestamp. See
+   * IterativeController::step(Input, QTime).
+   *
+   * @param inow the time of this tick
+   * @return the controller output
+   */
+  double step(const QTime inow) {
+    if (controller.isDisabled()) {
+      return 0;
+    }
+
+    const double out = controller.step(filter.filter(input.controllerGet()), inow);
+    output.controllerSet(out);
+    return out;
+  }
+
+  /**
+   * Sets the target for the controller.
+   *
+   * @param itarget the new target
+   */
+  void setTarget(const double itarget) override {
+    controller.setTarget(itarget);
+  }
+
+  /**
+   * Writes the value of the controller output. This sets the controller's target.
+   *
+   * @param ivalue the controller's output
+   */
+  void controllerSet(const double ivalue) override {
+    controller.controllerSet(ivalue);
+  }
+
+  /**
+   * Gets the last set target, or the default target if none was set.
+   *
+   * @return the last target
+   */
+  double getTarget() override {
+    return controller.getTarget();
+  }
+
+  /**
+   * Returns the last error of the controller. Does not update when disabled.
+   *
+   * @return the last error
+   */
+  double getError() const override {
+    return controller.getError();
+  }
+
+  /**
+   * Returns whether the controller has settled at the target.
+   *
+   * @return whether the controller is settled
+   */
+  bool isSettled() override {
+    return controller.isDisabled() || controller.isSettled();
+  }
+
+  /**
+   * Resets the controller's internal state.
+   */
+  void reset() override {
+    controller.reset();
+  }
+
+  /**
+   * Changes whether the controller is off or on. Disabling the controller writes its (zero) output
+   * immediately.
+   */
+  void flipDisable() override {
+    flipDisable(!controller.isDisabled());
+  }
+
+  /**
+   * Sets whether the controller is off or on. Disabling the controller writes its (zero) output
+   * immediately.
+   *
+   * @param iisDisabled whether the controller is disabled
+   */
+  void flipDisable(const bool iisDisabled) override {
+    controller.flipDisable(iisDisabled);
+
+    if (iisDisabled) {
+      output.controllerSet(controller.getOutput());
+    }
+  }
+
+  /**
+   * Returns whether the controller is currently disabled.
+   *
+   * @return whether the controller is currently disabled
+   */
+  bool isDisabled() const override {
+    return controller.isDisabled();
+  }
+
+  InputType &getInput() {
+    return input;
+  }
+
+  FilterType &getFilter() {
+    return filter;
+  }
+
+  ControllerType &getController() {
+    return controller;
+  }
+
+  OutputType &getOutput() {
+    return output;
+  }
+
+  protected:
+  InputType input;
+  FilterType filter;
+  ControllerType controller;
+  OutputType output;
+};
+
+/**
+ * Creates a ControllerPipeline, deducing the stage types. Stages passed as lvalues are copied.
+ *
+ * @param iinput the controller input
+ * @param ifilter the filter applied to the input before it reaches the controller
+ * @param icontroller the controller
+ * @param ioutput the controller output
+ * @return the pipeline
+ */
+template <typename InputType, typename FilterType, typename ControllerType, typename OutputType>
+ControllerPipeline<std::decay_t<InputType>,
+                   std::decay_t<FilterType>,
+                   std::decay_t<ControllerType>,
+                   std::decay_t<OutputType>>
+makeControllerPipeline(InputType &&iinput,
+                       FilterType &&ifilter,
+                       ControllerType &&icontroller,
+                       OutputType &&ioutput) {
+  return ControllerPipeline<std::decay_t<InputType>,
+                            std::decay_t<FilterType>,
+                            std::decay_t<ControllerType>,
+                            std::decay_t<OutputType>>(
+    std::decay_t<InputType>(std::forward<InputType>(iinput)),
+    std::decay_t<FilterType>(std::forward<FilterType>(ifilter)),
+    std::decay_t<ControllerType>(std::forward<ControllerType>(icontroller)),
+    std::decay_t<OutputType>(std::forward<OutputType>(ioutput)));
+}
+} // namespace okapi
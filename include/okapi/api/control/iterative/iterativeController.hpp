@@ -28,6 +28,22 @@ class IterativeController : public ClosedLoopController<Input, Output> {
    */
   virtual Output step(Input ireading) = 0;
 
+  /**
+   * Do one iteration of the controller using a timestamp supplied by the caller instead of reading
+   * the controller's timer. Controllers stepped in the same loop iteration can share one timestamp,
+   * and replaying the same readings and timestamps gives the same outputs.
+   *
+   * The default implementation ignores the timestamp and calls step(ireading), so controllers
+   * which do not override it keep reading their own timer.
+   *
+   * @param ireading new measurement
+   * @param inow the time the measurement was taken
+   * @return controller output
+   */
+  virtual Output step(Input ireading, QTime) {
+    return step(ireading);
+  }
+
   /**
    * Returns the last calculated output of the controller.
    */
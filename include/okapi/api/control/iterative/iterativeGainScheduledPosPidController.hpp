@@ -0,0 +1,137 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/control/controllerInput.hpp"
+#include "okapi/api/control/iterative/iterativePosPidController.hpp"
+#include <memory>
+#include <vector>
+
+namespace okapi {
+/**
+ * A position PID controller whose gains are a function of a schedule variable (for example, the
+ * height of a lift or the angle of an arm). The gains are linearly interpolated between
+ * breakpoints and held constant outside of the first and last breakpoint.
+ */
+class IterativeGainScheduledPosPIDController : public IterativePosPIDController {
+  public:
+  struct Breakpoint {
+    double scheduleValue{0};
+    Gains gains{};
+  };
+
+  /**
+   * Gain-scheduled position PID controller.
+   *
+   * @param ischedule the gain breakpoints, in any order. Must not be empty and must not contain
+   * two breakpoints with the same schedule value.
+   * @param ischeduleInput the input read each step to find the current gains
+   * @param itimeUtil see TimeUtil docs
+   * @param iderivativeFilter a filter for filtering the derivative term
+   */
+  IterativeGainScheduledPosPIDController(
+    const std::vector<Breakpoint> &ischedule,
+    std::shared_ptr<ControllerInput<double>> ischeduleInput,
+    const TimeUtil &itimeUtil,
+    std::unique_ptr<Filter> iderivativeFilter = std::make_unique<PassthroughFilter>());
+
+  /**
+   * Set time between loops in ms. The gain schedule is rescaled for the new sample time.
+   *
+   * @param isampleTime time between loops
+   */
+  void setSampleTime(QTime isampleTime) override;
+
+  /**
+   * Set whether changes in gains are absorbed into the integrator so the output does not jump
+   * when the gains change (bumpless transfer). Enabled by default. The transfer is only done while
+   * the integral gain is not zero, because otherwise nothing would ever wind the absorbed
+   * difference back out of the integrator and it would stay on the output as a constant offset.
+   *
+   * @param ibumpless true to enable bumpless transfer
+   */
+  virtual void setBumplessTransfer(bool ibumpless);
+
+  /**
+   * Updates the gains for the given schedule value. This is called each time the controller runs
+   * an iteration (once per sample time) using the schedule input, but can be called directly to
+   * set the gains ahead of time.
+   *
+   * @param ischeduleValue the schedule value
+   */
+  virtual void updateGains(double ischeduleValue);
+
+  /**
+   * Interpolates the gains in the schedule for the given schedule value. The returned gains are in
+   * the same units the schedule was given in.
+   *
+   * @param ischeduleValue the schedule value
+   * @return the interpolated gains
+   */
+  Gains getGains(double ischeduleValue) const;
+
+  protected:
+  std::shared_ptr<ControllerInput<double>> scheduleInput;
+  bool bumpless{true};
+
+  // Sorted breakpoint keys, kept apart from the gains so the search only touches the keys
+  std::vector<double> keys;
+
+  // The unscaled gains at each breakpoint
+  std::vector<Gains> gains;
+
+  // The gains at each breakpoint and the slope to the next breakpoint, scaled for the sample time
+  struct Segment {
+    double kP, kI, kD, kBias;
+    double dkP, dkI, dkD, dkBias;
+  };
+  std::vector<Segment> segments;
+
+  // The segment used last, checked first because the schedule value usually changes slowly
+  std::size_t lastSegment{0};
+
+  /**
+   * Finds the gains of the breakpoint with the lowest schedule value without sorting the schedule.
+   * Throws if the schedule is empty.
+   *
+   * @param ischedule the schedule
+   * @return the gains of the first breakpoint
+   */
+  static const Gains &firstGains(const std::vector<Breakpoint> &ischedule);
+
+  /**
+   * Sorts the schedule by schedule value. Throws if the schedule has duplicate schedule values.
+   *
+   * @param ischedule the schedule
+   * @return the sorted schedule
+   */
+  static std::vector<Breakpoint> sortSchedule(const std::vector<Breakpoint> &ischedule);
+
+  /**
+   * Recomputes the scaled segments from the unscaled gains.
+   */
+  void computeSegments();
+
+  /**
+   * Finds the segment containing the schedule value.
+   *
+   * @param ischeduleValue the schedule value
+   * @return the index of the segment
+   */
+  std::size_t findSegment(double ischeduleValue);
+
+  /**
+   * Updates the gains from the schedule input, then runs one iteration of the controller. Only
+   * called once the sample time has passed, so the schedule input is not read more often than the
+   * controller runs.
+   *
+   * @param inewReading new measurement
+   */
+  void stepImpl(double inewReading) override;
+};
+} // namespace okapi
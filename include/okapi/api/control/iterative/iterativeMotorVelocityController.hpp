@@ -30,6 +30,15 @@ class IterativeMotorVelocityController : public IterativeVelocityController<doub
    */
   double step(double ireading) override;
 
+  /**
+   * Do one iteration of the controller using the given timestamp instead of reading the timer.
+   *
+   * @param ireading new measurement
+   * @param inow the time the measurement was taken
+   * @return controller output
+   */
+  double step(double ireading, QTime inow) override;
+
   /**
    * Sets the target for the controller.
    */
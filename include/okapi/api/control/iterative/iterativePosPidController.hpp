@@ -67,6 +67,18 @@ class IterativePosPIDController : public IterativePositionController<double, dou
    */
   double step(double inewReading) override;
 
+  /**
+   * Do one iteration of the controller using the given timestamp instead of reading the timer. The
+   * controller only updates when at least the sample time has passed since its last update.
+   * Returns the reading in the range [-1, 1] unless the bounds have been changed with
+   * setOutputLimits().
+   *
+   * @param inewReading new measurement
+   * @param inow the time the measurement was taken
+   * @return controller output
+   */
+  double step(double inewReading, QTime inow) override;
+
   /**
    * Sets the target for the controller.
    *
@@ -239,7 +251,18 @@ class IterativePosPIDController : public IterativePositionController<double, dou
 
   bool controllerIsDisabled{false};
 
+  // The last time the controller was updated by step(double, QTime)
+  QTime lastStepTime{0_ms};
+  bool hasLastStepTime{false};
+
   std::unique_ptr<AbstractTimer> loopDtTimer;
   std::unique_ptr<SettledUtil> settledUtil;
+
+  /**
+   * Updates the error, integral, derivative, and output from a new measurement.
+   *
+   * @param inewReading new measurement
+   */
+  virtual void stepImpl(double inewReading);
 };
 } // namespace okapi
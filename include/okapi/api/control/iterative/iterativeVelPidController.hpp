@@ -45,6 +45,31 @@ class IterativeVelPIDController : public IterativeVelocityController<double, dou
    */
   double step(double inewReading) override;
 
+  /**
+   * Do one iteration of the controller using the given timestamp instead of reading the timer. The
+   * velocity is calculated with the same timestamp. Returns the reading in the range [-1, 1] unless
+   * the bounds have been changed with setOutputLimits().
+   *
+   * @param inewReading new measurement
+   * @param inow the time the measurement was taken
+   * @return controller output
+   */
+  double step(double inewReading, QTime inow) override;
+
+  /**
+   * Do one iteration of the controller using the motor's raw encoder count and the time the motor
+   * sampled it, see VelMath::step(AbstractMotor &). The controller only updates when a new
+   * velocity is calculated from a new sample, so it can be stepped faster than the motor samples
+   * without adding noise. The VelMath's ticks per revolution must be in raw encoder counts. The
+   * motor's timestamps are in a different clock than those given to step(double, QTime), so only
+   * use one of the two with a controller. Returns the reading in the range [-1, 1] unless the
+   * bounds have been changed with setOutputLimits().
+   *
+   * @param imotor the motor to read
+   * @return controller output
+   */
+  virtual double step(AbstractMotor &imotor);
+
   /**
    * Sets the target for the controller.
    *
@@ -158,6 +183,15 @@ class IterativeVelPIDController : public IterativeVelocityController<double, dou
    */
   virtual QAngularSpeed stepVel(double inewReading);
 
+  /**
+   * Do one iteration of velocity calculation using the given timestamp.
+   *
+   * @param inewReading new measurement
+   * @param inow the time the measurement was taken
+   * @return filtered velocity
+   */
+  virtual QAngularSpeed stepVel(double inewReading, QTime inow);
+
   /**
    * Set controller gains.
    *
@@ -193,9 +227,18 @@ class IterativeVelPIDController : public IterativeVelocityController<double, dou
   double outputMin{-1};
   bool controllerIsDisabled{false};
 
+  // The last time the controller was updated by step(double, QTime)
+  QTime lastStepTime{0_ms};
+  bool hasLastStepTime{false};
+
   std::unique_ptr<VelMath> velMath;
   std::unique_ptr<Filter> derivativeFilter;
   std::unique_ptr<AbstractTimer> loopDtTimer;
   std::unique_ptr<SettledUtil> settledUtil;
+
+  /**
+   * Updates the error, derivative, and output sum from the last calculated velocity.
+   */
+  void stepImpl();
 };
 } // namespace okapi
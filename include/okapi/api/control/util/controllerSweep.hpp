@@ -0,0 +1,192 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/control/iterative/iterativePosPidController.hpp"
+#include "okapi/api/control/util/flywheelSimulator.hpp"
+#include "okapi/api/units/QTime.hpp"
+#include "okapi/api/util/logging.hpp"
+#include "okapi/api/util/supplier.hpp"
+#include "okapi/api/util/timeUtil.hpp"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace okapi {
+/**
+ * Runs a controller against many randomized simulations to check how robust it is to variation
+ * in the battery voltage, the friction, and the mass of the system. Each trial gets a new
+ * simulator and a new controller and runs in virtual time (as fast as it can be computed), and the
+ * trials run in parallel. With a seed (see setSeed()), the results do not depend on the number of
+ * threads.
+ *
+ * Like SimulatedPIDTuner, the controller reads the simulator's angle in degrees (relative to where
+ * it started) and its output in [-1, 1] is scaled by the simulator's max torque. The max torque is
+ * also scaled by the battery voltage over the nominal 12 V motor voltage, up to 1. The mass sets
+ * both the gravity torque on the arm and the moment of inertia, which is mass * linkLength^2 like
+ * in the FlywheelSimulator constructor.
+ */
+class ControllerSweep {
+  public:
+  enum class Parameter {
+    batteryVoltage, // V
+    mass,           // kg
+    muStatic,       // N*m
+    muDynamic       // N*m / (rad/s)
+  };
+
+  static constexpr std::size_t numParameters = 4;
+
+  /**
+   * A distribution to sample a parameter from. Samples are never negative.
+   */
+  struct Distribution {
+    enum class Type { constant, uniform, normal };
+
+    Type type;
+    double a; // The value, the minimum, or the mean
+    double b; // Unused, the maximum, or the standard deviation
+
+    static Distribution constant(double ivalue);
+
+    static Distribution uniform(double imin, double imax);
+
+    static Distribution normal(double imean, double istddev);
+  };
+
+  /**
+   * The parameters and results of one closed-loop simulation.
+   */
+  struct Trial {
+    std::array<double, numParameters> parameters;
+    bool settled;
+    QTime settleTime; // The timeout if the trial did not settle
+    double overshoot; // The furthest the system went past the target, in degrees
+    double itae;      // The integral of time times absolute error, in degree*s^2
+  };
+
+  struct Statistics {
+    double mean;
+    double stddev;
+    double min;
+    double median;
+    double p95; // The 95th percentile
+    double max;
+  };
+
+  /**
+   * The statistics of the trials whose parameter fell in [lower, upper]. Settle times are in
+   * seconds and only include trials which settled.
+   */
+  struct Bucket {
+    double lower;
+    double upper;
+    std::size_t count;
+    double settledFraction;
+    Statistics settleTime;
+    Statistics overshoot;
+    Statistics itae;
+  };
+
+  /**
+   * Runs a controller against many randomized simulations. Every parameter is held at the value
+   * the supplied simulators are made with (or 12 V for the battery voltage) until it is given a
+   * distribution with setDistribution().
+   *
+   * @param isimulatorSupplier makes a new simulator for each trial. Called from multiple threads
+   * at once.
+   * @param icontrollerSupplier makes a new controller for each trial. Called from multiple threads
+   * at once.
+   * @param itimeUtil see TimeUtil docs. Used for the trials' settled utils and for waiting on the
+   * worker threads; the trials do not wait on it.
+   * @param itarget the target of each trial, in degrees
+   * @param itimeout the maximum (virtual) length of each trial
+   * @param iloopDelta the (virtual) time between controller updates
+   * @param inumThreads the number of threads to run trials on
+   */
+  ControllerSweep(
+    const Supplier<std::unique_ptr<FlywheelSimulator>> &isimulatorSupplier,
+    const Supplier<std::unique_ptr<IterativePosPIDController>> &icontrollerSupplier,
+    const TimeUtil &itimeUtil,
+    double itarget,
+    QTime itimeout = 5_s,
+    QTime iloopDelta = 10_ms,
+    std::size_t inumThreads = 4);
+
+  virtual ~ControllerSweep();
+
+  /**
+   * Sets the distribution a parameter is sampled from.
+   *
+   * @param iparameter the parameter
+   * @param idistribution the distribution
+   */
+  void setDistribution(Parameter iparameter, const Distribution &idistribution);
+
+  /**
+   * Seeds the random number generator used to sample the parameters so sweeps can be reproduced.
+   * The generator is seeded from std::random_device by default.
+   *
+   * @param iseed the seed
+   */
+  void setSeed(std::uint32_t iseed);
+
+  /**
+   * Samples the parameters of each trial and runs the trials in parallel.
+   *
+   * @param inumTrials the number of trials
+   * @return the trials, in the order their parameters were sampled
+   */
+  std::vector<Trial> run(std::size_t inumTrials);
+
+  /**
+   * Splits the trials into buckets of equal width over the range of one parameter and computes
+   * the statistics of each bucket. Empty buckets are included with a count of zero.
+   *
+   * @param itrials the trials
+   * @param iparameter the parameter to bucket by
+   * @param inumBuckets the number of buckets
+   * @return the buckets, from the lowest parameter value to the highest
+   */
+  static std::vector<Bucket>
+  summarize(const std::vector<Trial> &itrials, Parameter iparameter, std::size_t inumBuckets);
+
+  /**
+   * Computes the statistics of a set of values. The statistics of an empty set are all zero.
+   *
+   * @param ivalues the values
+   * @return the statistics
+   */
+  static Statistics computeStatistics(std::vector<double> ivalues);
+
+  protected:
+  Logger *logger;
+  std::mt19937 gen;
+  Supplier<std::unique_ptr<FlywheelSimulator>> simulatorSupplier;
+  Supplier<std::unique_ptr<IterativePosPIDController>> controllerSupplier;
+  TimeUtil timeUtil;
+  std::unique_ptr<AbstractRate> rate;
+  const double target;
+  const QTime timeout;
+  const QTime loopDelta;
+  const std::size_t numThreads;
+  std::array<Distribution, numParameters> distributions;
+
+  static constexpr double nominalVoltage = 12; // V
+
+  /**
+   * Runs one closed-loop simulation in virtual time with the trial's parameters and writes its
+   * results into the trial.
+   *
+   * @param itrial the trial
+   */
+  virtual void runTrial(Trial &itrial);
+};
+} // namespace okapi
@@ -0,0 +1,86 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/util/logging.hpp"
+#include <vector>
+
+namespace okapi {
+/**
+ * A feedforward model of a motor-driven mechanism: output = kS * sgn(v) + kV * v + kA * a, plus an
+ * optional proportional correction on position error. The units of the gains determine the units
+ * of the output; the motion profile controllers expect gains which produce millivolts from meters,
+ * meters per second, and meters per second squared.
+ */
+class Feedforward {
+  public:
+  struct Gains {
+    double kS{0}; // Output needed to overcome static friction
+    double kV{0}; // Output per unit of velocity
+    double kA{0}; // Output per unit of acceleration
+    double kP{0}; // Output per unit of position error (optional feedback correction)
+  };
+
+  /**
+   * One measurement of the mechanism used to characterize it.
+   */
+  struct Sample {
+    double velocity{0};
+    double acceleration{0};
+    double output{0};
+  };
+
+  /**
+   * A feedforward model.
+   *
+   * @param igains the model gains
+   */
+  explicit Feedforward(const Gains &igains);
+
+  /**
+   * Calculates the output needed to follow the given velocity and acceleration.
+   *
+   * @param ivelocity the target velocity
+   * @param iacceleration the target acceleration
+   * @param ipositionError the target position minus the measured position
+   * @return the output
+   */
+  double calculate(double ivelocity, double iacceleration, double ipositionError = 0) const;
+
+  /**
+   * @return the model gains
+   */
+  const Gains &getGains() const;
+
+  /**
+   * Fits kS, kV, and kA to the given samples with a least-squares fit. kP is left as zero. Samples
+   * should come from a mix of slow (quasistatic) and fast (step) runs so the velocity and
+   * acceleration terms can be told apart. Throws a std::invalid_argument exception if there are
+   * not enough varied samples to fit the model.
+   *
+   * @param isamples the measurements
+   * @return the fitted gains
+   */
+  static Gains characterize(const std::vector<Sample> &isamples);
+
+  protected:
+  Gains gains;
+};
+
+/**
+ * How closely a motion profile is being followed at one step, given to the tracking callbacks of
+ * the motion profile controllers. Positions are measured from the start of the profile.
+ */
+struct ProfileTrackingSample {
+  double targetPosition{0};
+  double targetVelocity{0};
+  double targetAcceleration{0};
+  double measuredPosition{0};
+  double output{0}; // The value written to the motors or controller output
+};
+} // namespace okapi
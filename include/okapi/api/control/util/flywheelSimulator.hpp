@@ -8,11 +8,24 @@
  */
 #pragma once
 
+#include <cstddef>
 #include <functional>
 
 namespace okapi {
 class FlywheelSimulator {
   public:
+  /**
+   * The integrator used to advance the simulation. explicitEuler is the original update, which
+   * scales the acceleration by the timestep a second time; it is the default so existing
+   * simulations do not change. semiImplicitEuler updates omega before the angle and evaluates the
+   * dynamic friction at the new omega, so it stays stable at any timestep.
+   */
+  enum class Integrator {
+    explicitEuler,     // The original update
+    semiImplicitEuler, // Symplectic Euler with implicit dynamic friction
+    rk4                // Classic fourth-order Runge-Kutta
+  };
+
   /**
    * A simulator for an inverted pendulum. The center of mass of the system changes as the link
    * rotates (by default, you can set a new torque function with setExternalTorqueFunction()).
@@ -26,7 +39,8 @@ class FlywheelSimulator {
   virtual ~FlywheelSimulator();
 
   /**
-   * Step the simulation by the timestep.
+   * Step the simulation by the timestep. The timestep is split into substeps if setSubsteps() was
+   * used.
    *
    * @return the current angle
    */
@@ -76,7 +90,8 @@ class FlywheelSimulator {
   void setAngle(double iangle);
 
   /**
-   * Sets the mass (kg).
+   * Sets the mass (kg). This changes the gravity torque but not the moment of inertia, see
+   * setMomentOfInertia().
    *
    * @param imass new mass
    */
@@ -89,6 +104,13 @@ class FlywheelSimulator {
    */
   void setLinkLength(double ilinkLen);
 
+  /**
+   * Sets the moment of inertia (kg*m^2). The constructor sets it to mass * linkLength^2.
+   *
+   * @param imomentOfInertia new moment of inertia
+   */
+  void setMomentOfInertia(double imomentOfInertia);
+
   /**
    * Sets the static friction (N*m).
    *
@@ -110,6 +132,25 @@ class FlywheelSimulator {
    */
   void setTimestep(double itimestep);
 
+  /**
+   * Sets the integrator used to advance the simulation. semiImplicitEuler and rk4 integrate an
+   * angular acceleration of torque / moment of inertia, which does not depend on the timestep, so
+   * they stay accurate at much larger timesteps. explicitEuler scales that acceleration by the
+   * timestep, so switching integrators changes how fast the simulation responds.
+   *
+   * @param iintegrator new integrator
+   */
+  void setIntegrator(Integrator iintegrator);
+
+  /**
+   * Sets the number of substeps each step is split into. Each call to step() still advances the
+   * simulation by the timestep, so sub-stepping improves accuracy and stability at a fixed outer
+   * timestep.
+   *
+   * @param isubsteps new number of substeps, at least 1
+   */
+  void setSubsteps(std::size_t isubsteps);
+
   /**
    * Returns the current angle (angle in rad).
    *
@@ -131,6 +172,41 @@ class FlywheelSimulator {
    */
   double getAcceleration() const;
 
+  /**
+   * Returns the mass (kg).
+   *
+   * @return the mass
+   */
+  double getMass() const;
+
+  /**
+   * Returns the link length (m).
+   *
+   * @return the link length
+   */
+  double getLinkLength() const;
+
+  /**
+   * Returns the moment of inertia (kg*m^2).
+   *
+   * @return the moment of inertia
+   */
+  double getMomentOfInertia() const;
+
+  /**
+   * Returns the static friction (N*m).
+   *
+   * @return the static friction
+   */
+  double getStaticFriction() const;
+
+  /**
+   * Returns the dynamic friction (N*m).
+   *
+   * @return the dynamic friction
+   */
+  double getDynamicFriction() const;
+
   /**
    * Returns the maximum torque input.
    *
@@ -138,6 +214,27 @@ class FlywheelSimulator {
    */
   double getMaxTorque() const;
 
+  /**
+   * Returns the timestep (sec).
+   *
+   * @return the timestep
+   */
+  double getTimestep() const;
+
+  /**
+   * Returns the integrator.
+   *
+   * @return the integrator
+   */
+  Integrator getIntegrator() const;
+
+  /**
+   * Returns the number of substeps per step.
+   *
+   * @return the number of substeps
+   */
+  std::size_t getSubsteps() const;
+
   protected:
   double inputTorque = 0;    // N*m
   double maxTorque = 0.5649; // N*m
@@ -149,11 +246,24 @@ class FlywheelSimulator {
   double muStatic;           // N*m
   double muDynamic;          // N*m
   double timestep;           // sec
-  double I = 0;              // moment of inertia
+  double I = 0;              // kg*m^2
   std::function<double(double, double, double)> torqueFunc;
+  Integrator integrator = Integrator::explicitEuler;
+  std::size_t substeps = 1;
 
   const double minTimestep = 0.000001; // 1 us
 
   virtual double stepImpl();
+
+  /**
+   * Returns the acceleration at the given state, including friction.
+   */
+  double computeAcceleration(double iangle, double iomega) const;
+
+  void explicitEulerStep(double idt);
+
+  void semiImplicitEulerStep(double idt);
+
+  void rk4Step(double idt);
 };
 } // namespace okapi
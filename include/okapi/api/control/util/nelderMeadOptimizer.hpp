@@ -0,0 +1,77 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/control/util/pidTunerOptimizer.hpp"
+#include "okapi/api/util/logging.hpp"
+#include <array>
+#include <functional>
+#include <vector>
+
+namespace okapi {
+/**
+ * Nelder-Mead (downhill simplex) optimization. Most steps test only one or two sets of gains, so
+ * it usually finds good gains with far fewer tests than particle swarm optimization, at the cost
+ * of being harder to run in parallel. The search starts from a random point and runs on gains
+ * scaled to [0, 1] within the bounds; points outside the bounds are clamped to them. Once the
+ * simplex has collapsed onto a minimum, which may only be a local one, the search restarts from a
+ * new random point until the tests run out, and the best gains of every search are kept.
+ */
+class NelderMeadOptimizer : public PIDTunerOptimizer {
+  public:
+  /**
+   * Nelder-Mead optimization.
+   *
+   * @param imaxEvaluations the maximum number of tests
+   * @param iinitialStep the size of the starting simplex as a fraction of the bounds
+   * @param itolerance restart once the simplex is smaller than this fraction of the bounds
+   */
+  NelderMeadOptimizer(std::size_t imaxEvaluations = 80,
+                      double iinitialStep = 0.4,
+                      double itolerance = 0.05);
+
+  PIDTuner::Output
+  optimize(const Bounds &ibounds, const Evaluator &ievaluator, std::mt19937 &igen) override;
+
+  protected:
+  static constexpr double reflection = 1;
+  static constexpr double expansion = 2;
+  static constexpr double contraction = 0.5;
+  static constexpr double shrinkage = 0.5;
+
+  using Point = std::array<double, 3>;
+
+  struct Vertex {
+    Point point;
+    double error;
+  };
+
+  Logger *logger;
+  const std::size_t maxEvaluations;
+  const double initialStep;
+  const double tolerance;
+
+  /**
+   * Runs one Nelder-Mead search until the simplex is smaller than the tolerance or the tests run
+   * out.
+   *
+   * @param istart the first vertex of the starting simplex
+   * @param ievaluate tests a set of points and returns their errors
+   * @param ievaluations the number of tests run so far, counted by ievaluate
+   * @return the best vertex found
+   */
+  Vertex search(const Point &istart,
+                const std::function<std::vector<double>(const std::vector<Point> &)> &ievaluate,
+                const std::size_t &ievaluations);
+
+  /**
+   * Converts a point in [0, 1]^3 to gains within the bounds, clamping it first.
+   */
+  static PIDTuner::Output toGains(const Point &ipoint, const Bounds &ibounds);
+};
+} // namespace okapi
@@ -0,0 +1,100 @@
+/**
+ * @author Jonathan Bayless, Team BLRS
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/control/util/pidTunerOptimizer.hpp"
+#include "okapi/api/util/logging.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace okapi {
+/**
+ * Particle swarm optimization. Each iteration tests every particle, so it is simple to run in
+ * parallel but needs numIterations * numParticles tests. This is PIDTuner's default optimizer.
+ *
+ * With a checkpoint file set, the whole swarm (particles, personal and global bests, iteration
+ * index, number of tests run, and random number generator state) is saved in a small binary file
+ * after every iteration, so a run interrupted by a brownout or disconnect can be continued with
+ * resume(). The file uses the native byte order. A checkpoint which cannot be saved only logs a
+ * warning, so a full or missing SD card does not stop the tuning.
+ */
+class ParticleSwarmOptimizer : public PIDTunerOptimizer {
+  public:
+  /**
+   * Particle swarm optimization.
+   *
+   * @param inumIterations the number of iterations
+   * @param inumParticles the number of particles (tests per iteration)
+   */
+  ParticleSwarmOptimizer(std::size_t inumIterations = 5, std::size_t inumParticles = 16);
+
+  PIDTuner::Output
+  optimize(const Bounds &ibounds, const Evaluator &ievaluator, std::mt19937 &igen) override;
+
+  void setCheckpointFile(const std::string &ipath) override;
+
+  PIDTuner::Output
+  resume(const Bounds &ibounds, const Evaluator &ievaluator, std::mt19937 &igen) override;
+
+  std::size_t getNumResumedEvaluations() const override;
+
+  protected:
+  static constexpr double inertia = 0.5;   // Particle inertia
+  static constexpr double confSelf = 1.1;  // Self confidence
+  static constexpr double confSwarm = 1.2; // Particle swarm confidence
+  static constexpr int increment = 5;
+
+  struct Particle {
+    double pos, vel, best;
+  };
+
+  struct ParticleSet {
+    Particle kP, kI, kD;
+    double bestError;
+  };
+
+  static constexpr std::uint32_t checkpointMagic = 0x4f4b5053; // "OKPS"
+  static constexpr std::uint32_t checkpointVersion = 2;
+
+  Logger *logger;
+  const std::size_t numIterations;
+  const std::size_t numParticles;
+  std::string checkpointFile;
+
+  std::vector<ParticleSet> particles;
+  ParticleSet global{};
+  std::size_t iteration{0};
+  std::size_t numEvaluations{0};
+  std::size_t numResumedEvaluations{0};
+
+  /**
+   * Runs the remaining iterations from the current swarm state.
+   */
+  PIDTuner::Output run(const Bounds &ibounds, const Evaluator &ievaluator, std::mt19937 &igen);
+
+  /**
+   * Writes the swarm state and generator state to the checkpoint file. The state is written to a
+   * temporary file first so an interruption while saving does not corrupt the last checkpoint. Logs
+   * a warning if the checkpoint could not be saved.
+   */
+  void saveCheckpoint(const Bounds &ibounds, const std::mt19937 &igen) const;
+
+  /**
+   * Reads the swarm state and generator state from the checkpoint file.
+   */
+  void loadCheckpoint(const Bounds &ibounds, std::mt19937 &igen);
+
+  /**
+   * Logs and throws a std::runtime_error for a checkpoint which could not be loaded.
+   */
+  [[noreturn]] void checkpointError(const std::string &imessage, std::FILE *ifile) const;
+};
+} // namespace okapi
@@ -0,0 +1,67 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/util/logging.hpp"
+#include <vector>
+
+extern "C" {
+#include "okapi/pathfinder/include/pathfinder.h"
+}
+
+namespace okapi {
+/**
+ * Plans the velocity along a path for a skid steer chassis. Pathfinder profiles the whole path with
+ * one maximum velocity, so on a tight curve the outer wheel can be asked to go faster than the
+ * motors can, and the only fix is to lower the maximum velocity everywhere. This planner keeps the
+ * shape of the path and instead limits the velocity at each point by the curvature there, so the
+ * outer wheel never goes faster than the maximum wheel velocity. A forward pass limits how fast the
+ * chassis can speed up and a backward pass limits how fast it must slow down, so the chassis runs
+ * at full speed on straight sections and only slows down for curves where it must.
+ *
+ * Acceleration is limited, but jerk is not.
+ */
+class PathVelocityPlanner {
+  public:
+  struct Limits {
+    double maxVel{0};         // The maximum velocity of the center of the chassis in m/s
+    double maxAccel{0};       // The maximum acceleration of the center of the chassis in m/s^2
+    double maxWheelVel{0};    // The maximum velocity of either side of the chassis in m/s
+    double wheelbaseWidth{0}; // The distance between the left and right wheels in m
+  };
+
+  /**
+   * A velocity planner. Throws a std::invalid_argument exception if any limit or the sample
+   * distance is not positive.
+   *
+   * @param ilimits the limits of the chassis
+   * @param isampleDistance the distance between the points the velocity is planned at in m
+   */
+  PathVelocityPlanner(const Limits &ilimits, double isampleDistance);
+
+  /**
+   * Plans the velocity along a trajectory from pathfinder and retimes it. The path starts and ends
+   * stopped.
+   *
+   * @param itrajectory the trajectory of the center of the chassis
+   * @param ilength the number of segments in the trajectory
+   * @param idt the time between segments of the planned trajectory in s
+   * @return the planned trajectory of the center of the chassis
+   */
+  std::vector<Segment> plan(const Segment *itrajectory, int ilength, double idt) const;
+
+  /**
+   * @return the limits of the chassis
+   */
+  const Limits &getLimits() const;
+
+  protected:
+  Limits limits;
+  double sampleDistance;
+};
+} // namespace okapi
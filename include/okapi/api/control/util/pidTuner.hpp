@@ -15,9 +15,13 @@
 #include "okapi/api/util/logging.hpp"
 #include "okapi/api/util/timeUtil.hpp"
 #include <memory>
+#include <random>
+#include <string>
 #include <vector>
 
 namespace okapi {
+class PIDTunerOptimizer;
+
 class PIDTuner {
   public:
   struct Output {
@@ -44,24 +48,59 @@ class PIDTuner {
 
   virtual Output autotune();
 
+  /**
+   * Continues an autotune() run which was interrupted, from the optimizer's last checkpoint (see
+   * setCheckpointFile()). The tuner must be constructed with the same bounds, number of
+   * iterations, and number of particles as the interrupted run. Test numbering, and so the
+   * alternating goal, continues from the checkpoint. Throws a std::runtime_error exception if the
+   * checkpoint cannot be loaded.
+   *
+   * @return the best gains found
+   */
+  virtual Output resume();
+
+  /**
+   * Makes the optimizer save its state to a file as autotune() runs, so that a run interrupted by
+   * a brownout, battery swap, or disconnect can be continued with resume() instead of starting
+   * over. Set this after setOptimizer(). A checkpoint which cannot be saved is logged as a warning
+   * and the run continues. Throws a std::invalid_argument exception if the optimizer cannot save
+   * its state.
+   *
+   * @param ipath the path of the file, for example "/usd/pidtuner.bin". An empty path stops
+   * saving.
+   */
+  void setCheckpointFile(const std::string &ipath);
+
+  /**
+   * Seeds the random number generator used by autotune() so runs can be reproduced. The generator
+   * is seeded from std::random_device by default.
+   *
+   * @param iseed the seed
+   */
+  void setSeed(std::uint32_t iseed);
+
+  /**
+   * Sets the optimizer used by autotune() to search for gains. The default is a
+   * ParticleSwarmOptimizer using the number of iterations and particles given to the constructor.
+   *
+   * @param ioptimizer the optimizer
+   */
+  void setOptimizer(const std::shared_ptr<PIDTunerOptimizer> &ioptimizer);
+
+  /**
+   * @return the number of tests run by the last call to autotune(), or by the interrupted run and
+   * the last call to resume()
+   */
+  std::size_t getNumEvaluations() const;
+
   protected:
-  static constexpr double inertia = 0.5;   // Particle inertia
-  static constexpr double confSelf = 1.1;  // Self confidence
-  static constexpr double confSwarm = 1.2; // Particle swarm confidence
-  static constexpr int increment = 5;
   static constexpr int divisor = 5;
   static constexpr QTime loopDelta = 10_ms; // NOLINT
 
-  struct Particle {
-    double pos, vel, best;
-  };
-
-  struct ParticleSet {
-    Particle kP, kI, kD;
-    double bestError;
-  };
-
   Logger *logger;
+  std::shared_ptr<PIDTunerOptimizer> optimizer;
+  std::size_t numEvaluations{0};
+  std::mt19937 gen;
   std::shared_ptr<ControllerInput<double>> input;
   std::shared_ptr<ControllerOutput<double>> output;
   TimeUtil timeUtil;
@@ -79,5 +118,41 @@ class PIDTuner {
   const std::size_t numParticles;
   const double kSettle;
   const double kITAE;
+
+  /**
+   * Runs the optimizer from the start or from its checkpoint.
+   *
+   * @param iresume whether to resume from the checkpoint
+   * @return the best gains found
+   */
+  Output runOptimizer(bool iresume);
+
+  /**
+   * Tests each set of gains and returns their errors in the same order. Tests alternate between
+   * moving towards the goal and towards the negative goal, so testing on hardware stays in the
+   * same general area. This implementation runs each test in turn with runTrial().
+   *
+   * @param icandidates the gains to test
+   * @return the error of each candidate (lower is better)
+   */
+  virtual std::vector<double> evaluateCandidates(const std::vector<Output> &icandidates);
+
+  /**
+   * Runs one closed-loop test on the input and output with the given gains.
+   *
+   * @param igains the gains to test
+   * @param itarget the target to move to, relative to the starting position
+   * @return the error of the test (lower is better)
+   */
+  virtual double runTrial(const Output &igains, std::int32_t itarget);
+
+  /**
+   * Combines the settle time and ITAE of a test into its error.
+   *
+   * @param isettleTime how long the test took to settle
+   * @param iitae the time-weighted sum of the error during the test
+   * @return the error of the test
+   */
+  double computeError(QTime isettleTime, double iitae) const;
 };
 } // namespace okapi
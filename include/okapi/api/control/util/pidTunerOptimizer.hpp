@@ -0,0 +1,82 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/control/util/pidTuner.hpp"
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace okapi {
+/**
+ * The search strategy used by PIDTuner to find gains. The optimizer proposes gains within the
+ * bounds and PIDTuner tests them; each test is a full closed-loop run, so optimizers should try to
+ * find good gains with as few tests as they can.
+ */
+class PIDTunerOptimizer {
+  public:
+  struct Bounds {
+    double kPMin, kPMax;
+    double kIMin, kIMax;
+    double kDMin, kDMax;
+  };
+
+  /**
+   * Tests each set of gains and returns their errors (lower is better) in the same order. Testing
+   * several sets of gains at once lets PIDTuner run them in parallel when it can.
+   */
+  using Evaluator = std::function<std::vector<double>(const std::vector<PIDTuner::Output> &)>;
+
+  virtual ~PIDTunerOptimizer() = default;
+
+  /**
+   * Searches for the gains with the lowest error.
+   *
+   * @param ibounds the bounds on the gains. Every proposed set of gains must be within them.
+   * @param ievaluator tests gains
+   * @param igen the random number generator to use for any randomness, so runs can be reproduced
+   * @return the best gains found
+   */
+  virtual PIDTuner::Output
+  optimize(const Bounds &ibounds, const Evaluator &ievaluator, std::mt19937 &igen) = 0;
+
+  /**
+   * Sets the file the optimizer saves its state to as it runs, so an interrupted run can be
+   * continued with resume(). Pass an empty path to stop saving. A checkpoint which cannot be saved
+   * is logged as a warning and the search continues. Throws a std::invalid_argument exception if
+   * this optimizer cannot save its state.
+   *
+   * @param ipath the path of the file
+   */
+  virtual void setCheckpointFile(const std::string &ipath);
+
+  /**
+   * Loads the state saved in the checkpoint file and continues the search from there. Throws a
+   * std::runtime_error exception if the checkpoint cannot be loaded or does not match this
+   * optimizer and bounds, or a std::invalid_argument exception if this optimizer cannot save its
+   * state.
+   *
+   * @param ibounds the bounds on the gains. Must be the same as the interrupted run.
+   * @param ievaluator tests gains
+   * @param igen the random number generator. Its state is restored from the checkpoint.
+   * @return the best gains found
+   */
+  virtual PIDTuner::Output
+  resume(const Bounds &ibounds, const Evaluator &ievaluator, std::mt19937 &igen);
+
+  /**
+   * Returns the number of tests which had been run when the checkpoint loaded by resume() was
+   * saved. PIDTuner continues counting its tests from there once the checkpoint is loaded, so the
+   * goal keeps alternating where the interrupted run left off.
+   *
+   * @return the number of tests run before the loaded checkpoint, or 0 if none has been loaded
+   */
+  virtual std::size_t getNumResumedEvaluations() const;
+};
+} // namespace okapi
@@ -0,0 +1,62 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/odometry/odomState.hpp"
+#include "okapi/api/util/logging.hpp"
+
+namespace okapi {
+/**
+ * The RAMSETE controller, a nonlinear feedback controller which makes a skid steer chassis follow
+ * a path of poses. Each step takes the pose and velocities the path wants now and the measured
+ * pose, and corrects the velocities so the chassis converges back onto the path. With no error,
+ * the path's velocities are returned unchanged.
+ */
+class Ramsete {
+  public:
+  struct Gains {
+    double b{2};      // How aggressively errors are corrected, in rad^2/m^2
+    double zeta{0.7}; // The damping of the correction, between 0 and 1
+  };
+
+  struct Output {
+    double velocity{0};        // The chassis velocity in m/s
+    double angularVelocity{0}; // The chassis angular velocity in rad/s, counterclockwise
+  };
+
+  /**
+   * A RAMSETE controller. Throws a std::invalid_argument exception if b is not greater than zero
+   * or zeta is not between zero and one.
+   *
+   * @param igains the controller gains. Ramsete::Gains{} gives the usual defaults.
+   */
+  explicit Ramsete(const Gains &igains);
+
+  /**
+   * Calculates the chassis velocities to follow the path.
+   *
+   * @param ipose the measured pose
+   * @param itarget the pose the path wants
+   * @param ivelocity the velocity the path wants in m/s
+   * @param iangularVelocity the angular velocity the path wants in rad/s
+   * @return the corrected chassis velocities
+   */
+  Output calculate(const OdomState &ipose,
+                   const OdomState &itarget,
+                   double ivelocity,
+                   double iangularVelocity) const;
+
+  /**
+   * @return the controller gains
+   */
+  const Gains &getGains() const;
+
+  protected:
+  Gains gains;
+};
+} // namespace okapi
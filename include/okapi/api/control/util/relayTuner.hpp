@@ -0,0 +1,109 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/control/controllerInput.hpp"
+#include "okapi/api/control/controllerOutput.hpp"
+#include "okapi/api/control/util/pidTuner.hpp"
+#include "okapi/api/units/QTime.hpp"
+#include "okapi/api/util/logging.hpp"
+#include "okapi/api/util/timeUtil.hpp"
+#include <memory>
+
+namespace okapi {
+/**
+ * Tunes a PID controller from one relay feedback experiment (Astrom-Hagglund). The output is
+ * switched between +/- the relay amplitude whenever the input crosses the setpoint, which makes
+ * the system oscillate at its ultimate period. The ultimate gain and period are measured from the
+ * oscillation and turned into gains by a tuning rule. This takes a few oscillations instead of the
+ * many full moves PIDTuner needs.
+ *
+ * The gains use the same units as IterativePosPIDController: kI is per second and kD is in
+ * seconds.
+ */
+class RelayTuner {
+  public:
+  enum class TuningRule {
+    zieglerNichols,   // Ziegler-Nichols PID
+    zieglerNicholsPI, // Ziegler-Nichols PI
+    tyreusLuyben,     // Tyreus-Luyben PID, less aggressive than Ziegler-Nichols
+    tyreusLuybenPI,   // Tyreus-Luyben PI
+    pessenIntegral,   // Pessen integral rule PID
+    someOvershoot,    // Ziegler-Nichols variant with some overshoot
+    noOvershoot       // Ziegler-Nichols variant with no overshoot
+  };
+
+  struct Result {
+    double ultimateGain;    // Output per unit of input at which the system oscillates
+    QTime ultimatePeriod;   // The period of the oscillation
+    double amplitude;       // The amplitude of the oscillation in input units
+    QTime duration;         // How long the experiment took
+    PIDTuner::Output gains; // The gains from the tuning rule
+  };
+
+  /**
+   * Tunes a PID controller from one relay feedback experiment.
+   *
+   * @param iinput the system input
+   * @param ioutput the system output
+   * @param itimeUtil see TimeUtil docs. The rate paces the experiment.
+   * @param isetpoint the setpoint to oscillate around, relative to the starting input
+   * @param irelayAmplitude the output magnitude of the relay
+   * @param ihysteresis how far the input must cross the setpoint before the relay switches. Use
+   * a little more than the noise in the input.
+   * @param inumCycles the number of oscillations to measure. The first oscillation is not
+   * measured because the system has not settled into its cycle yet.
+   * @param itimeout the maximum length of the experiment
+   * @param iloopDelta the time between steps of the experiment
+   */
+  RelayTuner(const std::shared_ptr<ControllerInput<double>> &iinput,
+             const std::shared_ptr<ControllerOutput<double>> &ioutput,
+             const TimeUtil &itimeUtil,
+             double isetpoint,
+             double irelayAmplitude,
+             double ihysteresis = 0,
+             std::size_t inumCycles = 3,
+             QTime itimeout = 10_s,
+             QTime iloopDelta = 10_ms);
+
+  virtual ~RelayTuner();
+
+  /**
+   * Runs the relay experiment and computes gains from it. Throws a std::runtime_error if the
+   * system does not oscillate enough before the timeout. The output is set to zero afterwards.
+   *
+   * @param irule the tuning rule to compute the gains with
+   * @return the measured oscillation and the gains
+   */
+  virtual Result autotune(TuningRule irule = TuningRule::zieglerNichols);
+
+  /**
+   * Computes PID gains from the ultimate gain and period of a system.
+   *
+   * @param iultimateGain the ultimate gain
+   * @param iultimatePeriod the ultimate period
+   * @param irule the tuning rule
+   * @return the gains
+   */
+  static PIDTuner::Output
+  computeGains(double iultimateGain, QTime iultimatePeriod, TuningRule irule);
+
+  protected:
+  Logger *logger;
+  std::shared_ptr<ControllerInput<double>> input;
+  std::shared_ptr<ControllerOutput<double>> output;
+  std::unique_ptr<AbstractRate> rate;
+
+  const double setpoint;
+  const double relayAmplitude;
+  const double hysteresis;
+  const std::size_t numCycles;
+  const QTime timeout;
+  const QTime loopDelta;
+};
+} // namespace okapi
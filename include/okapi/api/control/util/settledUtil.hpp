@@ -37,6 +37,16 @@ class SettledUtil {
    */
   virtual bool isSettled(double ierror);
 
+  /**
+   * Returns whether the controller is settled, using the given timestamp instead of reading the
+   * timer.
+   *
+   * @param ierror current error
+   * @param inow the current time
+   * @return whether the controller is settled
+   */
+  virtual bool isSettled(double ierror, QTime inow);
+
   /**
    * Resets the "at target" timer.
    */
@@ -48,5 +58,7 @@ class SettledUtil {
   QTime atTargetTime = 250_ms;
   std::unique_ptr<AbstractTimer> atTargetTimer;
   double lastError = 0;
+  QTime atTargetMark = 0_ms;
+  bool hasAtTargetMark = false;
 };
 } // namespace okapi
@@ -0,0 +1,86 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/control/util/flywheelSimulator.hpp"
+#include "okapi/api/control/util/pidTuner.hpp"
+#include "okapi/api/util/supplier.hpp"
+#include <memory>
+#include <vector>
+
+namespace okapi {
+/**
+ * A PIDTuner which tests gains against a simulation instead of hardware. Each test gets a new
+ * simulator and runs in virtual time (as fast as it can be computed), and the tests in each
+ * iteration of the optimization run in parallel. With a seed (see setSeed()), the result does not
+ * depend on the number of threads.
+ *
+ * The controller reads the simulator's angle in degrees and its output in [-1, 1] is scaled by
+ * the simulator's max torque.
+ */
+class SimulatedPIDTuner : public PIDTuner {
+  public:
+  /**
+   * A PIDTuner which tests gains against a simulation.
+   *
+   * @param isimulatorSupplier makes a new simulator for each test. Called from multiple threads
+   * at once.
+   * @param itimeUtil see TimeUtil docs. Used for the controllers' settled utils and for waiting
+   * on the worker threads; simulated tests do not wait on it.
+   * @param itimeout the maximum (virtual) length of each test
+   * @param igoal the target of each test, in degrees
+   * @param ikPMin the minimum kP
+   * @param ikPMax the maximum kP
+   * @param ikIMin the minimum kI
+   * @param ikIMax the maximum kI
+   * @param ikDMin the minimum kD
+   * @param ikDMax the maximum kD
+   * @param inumIterations the number of optimization iterations
+   * @param inumParticles the number of particles (tests per iteration)
+   * @param ikSettle the weight of the settle time in the error
+   * @param ikITAE the weight of the ITAE in the error
+   * @param inumThreads the number of threads to run tests on
+   */
+  SimulatedPIDTuner(const Supplier<std::unique_ptr<FlywheelSimulator>> &isimulatorSupplier,
+                    const TimeUtil &itimeUtil,
+                    QTime itimeout,
+                    std::int32_t igoal,
+                    double ikPMin,
+                    double ikPMax,
+                    double ikIMin,
+                    double ikIMax,
+                    double ikDMin,
+                    double ikDMax,
+                    std::size_t inumIterations = 5,
+                    std::size_t inumParticles = 16,
+                    double ikSettle = 1,
+                    double ikITAE = 2,
+                    std::size_t inumThreads = 4);
+
+  protected:
+  Supplier<std::unique_ptr<FlywheelSimulator>> simulatorSupplier;
+  const std::size_t numThreads;
+
+  /**
+   * Tests each set of gains in parallel, each against a new simulator.
+   *
+   * @param icandidates the gains to test
+   * @return the error of each candidate (lower is better)
+   */
+  std::vector<double> evaluateCandidates(const std::vector<Output> &icandidates) override;
+
+  /**
+   * Runs one closed-loop test in virtual time against a new simulator.
+   *
+   * @param igains the gains to test
+   * @param itarget the target to move to, in degrees
+   * @return the error of the test (lower is better)
+   */
+  double runTrial(const Output &igains, std::int32_t itarget) override;
+};
+} // namespace okapi
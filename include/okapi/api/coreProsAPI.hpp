@@ -16,11 +16,15 @@
 #include <functional>
 
 #ifdef THREADS_STD
+#include <mutex>
 #include <thread>
 #define CROSSPLATFORM_THREAD_T std::thread
+#define CROSSPLATFORM_MUTEX_T std::mutex
 #else
 #include "api.h"
+#include "pros/apix.h"
 #define CROSSPLATFORM_THREAD_T pros::task_t
+#define CROSSPLATFORM_MUTEX_T pros::mutex_t
 #endif
 
 class CrossplatformThread {
@@ -47,6 +51,59 @@ class CrossplatformThread {
 #endif
   }
 
+  /**
+   * Called at the end of a thread's function which would otherwise return. On PROS, the kernel
+   * deletes a task which returns, and the destructor would then delete it a second time, so this
+   * blocks until the destructor deletes the task. With std::thread, this returns so the thread can
+   * be joined.
+   */
+  static void waitToBeDeleted() {
+#ifndef THREADS_STD
+    while (true) {
+      pros::c::task_notify_take(true, TIMEOUT_MAX);
+    }
+#endif
+  }
+
   protected:
   CROSSPLATFORM_THREAD_T thread;
 };
+
+class CrossplatformMutex {
+  public:
+  CrossplatformMutex()
+#ifndef THREADS_STD
+    : mutex(pros::c::mutex_create())
+#endif
+  {
+  }
+
+  ~CrossplatformMutex() {
+#ifndef THREADS_STD
+    // This kernel has no mutex_delete(). Its mutexes are semaphores, so sem_delete() frees them.
+    pros::c::sem_delete(mutex);
+#endif
+  }
+
+  CrossplatformMutex(const CrossplatformMutex &) = delete;
+  CrossplatformMutex &operator=(const CrossplatformMutex &) = delete;
+
+  void lock() {
+#ifdef THREADS_STD
+    mutex.lock();
+#else
+    pros::c::mutex_take(mutex, TIMEOUT_MAX);
+#endif
+  }
+
+  void unlock() {
+#ifdef THREADS_STD
+    mutex.unlock();
+#else
+    pros::c::mutex_give(mutex);
+#endif
+  }
+
+  protected:
+  CROSSPLATFORM_MUTEX_T mutex;
+};
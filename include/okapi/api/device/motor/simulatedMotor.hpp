@@ -0,0 +1,276 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/device/motor/abstractMotor.hpp"
+#include "okapi/api/units/QTime.hpp"
+#include <memory>
+
+namespace okapi {
+/**
+ * A simulated V5 motor. The motor is modeled as a DC motor with back-EMF, a winding resistance,
+ * a current limit, and friction, behind the selected gearset. The internal velocity and position
+ * controllers of the motor firmware are approximated by a feedforward plus PI velocity loop and a
+ * proportional position loop with a velocity limit.
+ *
+ * The motor does not move on its own; call step() to advance it in virtual time while it spins a
+ * load inertia, or let a ChassisSimulator drive it with computeTorque() and advance(). Positions
+ * and velocities follow the same units as Motor (encoder units and RPM of the output shaft).
+ */
+class SimulatedMotor : public AbstractMotor, public std::enable_shared_from_this<SimulatedMotor> {
+  public:
+  /**
+   * A simulated V5 motor.
+   *
+   * @param igearset the gearset
+   * @param iloadInertia the inertia step() spins, in kg*m^2 at the output shaft
+   */
+  explicit SimulatedMotor(gearset igearset = gearset::green, double iloadInertia = 0.01);
+
+  ~SimulatedMotor() override;
+
+  /**
+   * Advances the motor by the given time while it spins its load inertia. Long steps are split
+   * into steps of at most one millisecond.
+   *
+   * @param idt the time to advance by
+   */
+  void step(QTime idt);
+
+  /**
+   * Runs the internal controller and electrical model for one step at the current velocity and
+   * returns the torque on the output shaft. Use advance() afterwards to move the motor.
+   *
+   * @param idt the length of the step
+   * @return the output shaft torque in N*m, including friction
+   */
+  double computeTorque(QTime idt);
+
+  /**
+   * Moves the motor at the given output shaft velocity for the given time. This is used by
+   * simulators which integrate the motor's load themselves.
+   *
+   * @param idt the length of the step
+   * @param ivelocity the output shaft velocity in rad/s
+   */
+  void advance(QTime idt, double ivelocity);
+
+  /**
+   * @return the virtual time this motor has been simulated for
+   */
+  QTime getTime() const;
+
+  /**
+   * @return the output shaft velocity in rad/s, ignoring reversal
+   */
+  double getShaftVelocity() const;
+
+  /**
+   * @return the stall torque on the output shaft in N*m at the current limit
+   */
+  double getStallTorque() const;
+
+  /**
+   * @return the free speed of the output shaft in rad/s
+   */
+  double getFreeSpeed() const;
+
+  /******************************************************************************/
+  /**                          AbstractMotor functions                         **/
+  /******************************************************************************/
+
+  std::int32_t moveAbsolute(double iposition, std::int32_t ivelocity) override;
+
+  std::int32_t moveRelative(double iposition, std::int32_t ivelocity) override;
+
+  std::int32_t moveVelocity(std::int16_t ivelocity) override;
+
+  std::int32_t moveVoltage(std::int16_t ivoltage) override;
+
+  std::int32_t modifyProfiledVelocity(std::int32_t ivelocity) override;
+
+  double getTargetPosition() override;
+
+  double getPosition() override;
+
+  std::int32_t tarePosition() override;
+
+  std::int32_t getTargetVelocity() override;
+
+  double getActualVelocity() override;
+
+  std::int32_t getCurrentDraw() override;
+
+  std::int32_t getDirection() override;
+
+  double getEfficiency() override;
+
+  std::int32_t isOverCurrent() override;
+
+  std::int32_t isOverTemp() override;
+
+  std::int32_t isStopped() override;
+
+  std::int32_t getZeroPositionFlag() override;
+
+  uint32_t getFaults() override;
+
+  uint32_t getFlags() override;
+
+  /**
+   * @param timestamp set to the virtual time of the reading in milliseconds, if not null
+   * @return the position in encoder counts
+   */
+  std::int32_t getRawPosition(std::uint32_t *timestamp) override;
+
+  double getPower() override;
+
+  double getTemperature() override;
+
+  double getTorque() override;
+
+  std::int32_t getVoltage() override;
+
+  std::int32_t setBrakeMode(brakeMode imode) override;
+
+  brakeMode getBrakeMode() override;
+
+  std::int32_t setCurrentLimit(std::int32_t ilimit) override;
+
+  std::int32_t getCurrentLimit() override;
+
+  std::int32_t setEncoderUnits(encoderUnits iunits) override;
+
+  encoderUnits getEncoderUnits() override;
+
+  std::int32_t setGearing(gearset igearset) override;
+
+  gearset getGearing() override;
+
+  std::int32_t setReversed(bool ireverse) override;
+
+  std::int32_t setVoltageLimit(std::int32_t ilimit) override;
+
+  /**
+   * Sets the gains of the position loop. Only kP is used, in RPM per degree of error.
+   */
+  std::int32_t setPosPID(double ikF, double ikP, double ikI, double ikD) override;
+
+  /**
+   * Sets the gains of the position loop. Only kP is used, in RPM per degree of error.
+   */
+  std::int32_t setPosPIDFull(double ikF,
+                             double ikP,
+                             double ikI,
+                             double ikD,
+                             double ifilter,
+                             double ilimit,
+                             double ithreshold,
+                             double iloopSpeed) override;
+
+  /**
+   * Sets the gains of the velocity loop, in full voltage per fraction of the gearset's max
+   * velocity. kF scales the feedforward (1 is nominal) and kD is unused.
+   */
+  std::int32_t setVelPID(double ikF, double ikP, double ikI, double ikD) override;
+
+  /**
+   * Sets the gains of the velocity loop, in full voltage per fraction of the gearset's max
+   * velocity. kF scales the feedforward (1 is nominal) and kD is unused.
+   */
+  std::int32_t setVelPIDFull(double ikF,
+                             double ikP,
+                             double ikI,
+                             double ikD,
+                             double ifilter,
+                             double ilimit,
+                             double ithreshold,
+                             double iloopSpeed) override;
+
+  /**
+   * Returns the integrated encoder of the motor. The encoder shares ownership of the motor, so the
+   * motor must be owned by a std::shared_ptr. Throws a std::runtime_error exception if it is not.
+   *
+   * @return the integrated encoder
+   */
+  std::shared_ptr<ContinuousRotarySensor> getEncoder() override;
+
+  /**
+   * Writes the value of the controller output. Sets the target velocity to the value times the
+   * gearset's max velocity, like Motor.
+   *
+   * @param ivalue the controller's output in the range [-1, 1]
+   */
+  void controllerSet(double ivalue) override;
+
+  protected:
+  enum class Mode { voltage, velocity, position };
+
+  // V5 motor constants at the motor shaft, before the gearset
+  static constexpr double nominalVoltage = 12;         // V
+  static constexpr double motorFreeSpeed = 376.99;     // rad/s (3600 RPM)
+  static constexpr double ratedCurrent = 2.5;          // A
+  static constexpr double motorStallTorque = 0.058333; // N*m at the rated current
+  static constexpr double resistance = 3.0;            // Ohm
+  static constexpr double frictionFraction = 0.02;     // Friction as a fraction of stall torque
+  static constexpr double maxStep = 0.001;             // s
+
+  double loadInertia;
+  gearset gearing;
+  encoderUnits units{encoderUnits::degrees};
+  brakeMode brake{brakeMode::coast};
+  bool reversed{false};
+  double currentLimit{ratedCurrent};    // A
+  double voltageLimit{nominalVoltage};  // V
+
+  Mode mode{Mode::voltage};
+  double targetVoltage{0};    // V
+  double targetVelocity{0};   // rad/s at the output
+  double targetPosition{0};   // rad at the output
+  double profiledVelocity{0}; // rad/s at the output
+
+  double velKF{1};
+  double velKP{4};
+  double velKI{10};
+  double posKP{5};
+  double velIntegral{0};
+
+  double position{0};     // rad at the output
+  double zeroPosition{0}; // rad at the output
+  double velocity{0};     // rad/s at the output
+  double current{0};      // A
+  double voltage{0};      // V
+  double torque{0};       // N*m at the output
+  double time{0};         // s
+
+  /**
+   * @return the gear ratio of the gearset (motor turns per output turn)
+   */
+  double getRatio() const;
+
+  /**
+   * @return the max velocity of the gearset in RPM
+   */
+  double getMaxRPM() const;
+
+  /**
+   * Converts a position in the current encoder units to radians at the output.
+   */
+  double unitsToRadians(double iposition) const;
+
+  /**
+   * Converts a position in radians at the output to the current encoder units.
+   */
+  double radiansToUnits(double iposition) const;
+
+  /**
+   * @return the voltage the firmware applies this step
+   */
+  double computeVoltage(double idt);
+};
+} // namespace okapi
@@ -0,0 +1,48 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/device/motor/simulatedMotor.hpp"
+#include "okapi/api/device/rotarysensor/continuousRotarySensor.hpp"
+#include <memory>
+
+namespace okapi {
+/**
+ * The integrated encoder of a SimulatedMotor. The encoder shares ownership of the motor, so it
+ * stays valid after every other reference to the motor is dropped.
+ */
+class SimulatedIntegratedEncoder : public ContinuousRotarySensor {
+  public:
+  explicit SimulatedIntegratedEncoder(const std::shared_ptr<SimulatedMotor> &imotor);
+
+  /**
+   * Get the current sensor value.
+   *
+   * @return the motor's position in its encoder units
+   */
+  double get() const override;
+
+  /**
+   * Reset the sensor to zero.
+   *
+   * @return 1 on success, PROS_ERR on fail
+   */
+  std::int32_t reset() override;
+
+  /**
+   * Get the sensor value for use in a control loop. This method might be automatically called in
+   * another thread by the controller.
+   *
+   * @return the current sensor value. This is the same as the output of the pid controller.
+   */
+  double controllerGet() override;
+
+  protected:
+  std::shared_ptr<SimulatedMotor> motor;
+};
+} // namespace okapi
@@ -53,6 +53,20 @@ template <std::size_t n> class AverageFilter : public Filter {
     return output;
   }
 
+  /**
+   * Filters a sequence of values. The results are exactly the same as calling filter() on each
+   * value in order.
+   *
+   * @param iinput the values to filter
+   * @param ioutput the filtered results, with room for icount values
+   * @param icount the number of values
+   */
+  void filterBatch(const double *iinput, double *ioutput, const std::size_t icount) override {
+    for (std::size_t i = 0; i < icount; i++) {
+      ioutput[i] = AverageFilter::filter(iinput[i]);
+    }
+  }
+
   protected:
   std::array<double, n> data{0};
   std::size_t index = 0;
@@ -0,0 +1,154 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/filter/filter.hpp"
+#include "okapi/api/units/QFrequency.hpp"
+#include "okapi/api/units/QTime.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace okapi {
+/**
+ * An IIR filter made of cascaded second-order sections (biquads), each computed in transposed
+ * direct form II. A cascade of low order sections stays numerically stable where a single high
+ * order filter would not. Use the design functions to get a Butterworth low-pass or high-pass
+ * filter or a notch filter, which give sharp responses with much less lag than long averaging
+ * windows.
+ *
+ * The sample time passed to the design functions must match how often the filter is given new
+ * readings (for example, the sample time of the VelMath the filter is used in).
+ */
+class BiquadFilter : public Filter {
+  public:
+  /**
+   * The coefficients of one section, normalized so a0 is 1:
+   * H(z) = (b0 + b1 z^-1 + b2 z^-2) / (1 + a1 z^-1 + a2 z^-2).
+   * A first-order section has b2 and a2 equal to zero.
+   */
+  struct Coefficients {
+    double b0;
+    double b1;
+    double b2;
+    double a1;
+    double a2;
+  };
+
+  /**
+   * Cascaded biquad filter. Throws a std::invalid_argument exception if there are no sections.
+   *
+   * @param isections the coefficients of each section, applied in order
+   */
+  explicit BiquadFilter(const std::vector<Coefficients> &isections);
+
+  /**
+   * Designs a Butterworth low-pass filter using the bilinear transform with a prewarped cutoff.
+   * Throws a std::invalid_argument exception if the order is zero, the sample time is not
+   * positive, or the cutoff is not between zero and the Nyquist frequency.
+   *
+   * @param iorder the order of the filter. Each pair of orders adds one section.
+   * @param icutoff the -3 dB frequency
+   * @param isampleTime the time between readings
+   * @return the filter
+   */
+  static BiquadFilter butterworthLowPass(std::size_t iorder, QFrequency icutoff, QTime isampleTime);
+
+  /**
+   * Designs a Butterworth high-pass filter using the bilinear transform with a prewarped cutoff.
+   * Throws a std::invalid_argument exception if the order is zero, the sample time is not
+   * positive, or the cutoff is not between zero and the Nyquist frequency.
+   *
+   * @param iorder the order of the filter. Each pair of orders adds one section.
+   * @param icutoff the -3 dB frequency
+   * @param isampleTime the time between readings
+   * @return the filter
+   */
+  static BiquadFilter
+  butterworthHighPass(std::size_t iorder, QFrequency icutoff, QTime isampleTime);
+
+  /**
+   * Designs a notch filter which removes one frequency, like a known vibration. Throws a
+   * std::invalid_argument exception if the quality factor or sample time is not positive, or the
+   * center frequency is not between zero and the Nyquist frequency.
+   *
+   * @param icenter the frequency to remove
+   * @param iq the quality factor, which is the center frequency over the width of the notch.
+   * Higher values give a narrower notch which takes longer to settle.
+   * @param isampleTime the time between readings
+   * @return the filter
+   */
+  static BiquadFilter notch(QFrequency icenter, double iq, QTime isampleTime);
+
+  /**
+   * Filters a value, like a sensor reading.
+   *
+   * @param ireading new measurement
+   * @return filtered result
+   */
+  double filter(double ireading) override;
+
+  /**
+   * Returns the previous output from filter.
+   *
+   * @return the previous output from filter
+   */
+  double getOutput() const override;
+
+  /**
+   * Filters a sequence of values. The results are exactly the same as calling filter() on each
+   * value in order.
+   *
+   * @param iinput the values to filter
+   * @param ioutput the filtered results, with room for icount values
+   * @param icount the number of values
+   */
+  void filterBatch(const double *iinput, double *ioutput, std::size_t icount) override;
+
+  /**
+   * Clears the state of every section and the output, as if no readings had been filtered.
+   */
+  virtual void reset();
+
+  /**
+   * @return the coefficients of each section
+   */
+  std::vector<Coefficients> getSections() const;
+
+  /**
+   * Computes the gain of the filter at a frequency.
+   *
+   * @param ifrequency the frequency
+   * @param isampleTime the time between readings
+   * @return the magnitude of the frequency response (1 passes the frequency unchanged)
+   */
+  double getMagnitude(QFrequency ifrequency, QTime isampleTime) const;
+
+  protected:
+  struct Section {
+    Coefficients coefficients;
+    double s1;
+    double s2;
+  };
+
+  std::vector<Section> sections;
+  double output = 0;
+
+  /**
+   * Throws a std::invalid_argument exception if the sample time is not positive or the frequency
+   * is not between zero and the Nyquist frequency.
+   *
+   * @return tan(pi * frequency * sample time), the prewarped frequency of the bilinear transform
+   */
+  static double prewarp(QFrequency ifrequency, QTime isampleTime);
+
+  /**
+   * @return the sections of a Butterworth filter with a prewarped cutoff of ik
+   */
+  static std::vector<Coefficients> butterworth(std::size_t iorder, double ik, bool ihighPass);
+};
+} // namespace okapi
@@ -34,6 +34,16 @@ class EmaFilter : public Filter {
    */
   double getOutput() const override;
 
+  /**
+   * Filters a sequence of values. The results are exactly the same as calling filter() on each
+   * value in order.
+   *
+   * @param iinput the values to filter
+   * @param ioutput the filtered results, with room for icount values
+   * @param icount the number of values
+   */
+  void filterBatch(const double *iinput, double *ioutput, std::size_t icount) override;
+
   /**
    * Set filter gains.
    *
@@ -7,6 +7,8 @@
  */
 #pragma once
 
+#include <cstddef>
+
 namespace okapi {
 class Filter {
   public:
@@ -26,5 +28,18 @@ class Filter {
    * @return the previous output from filter
    */
   virtual double getOutput() const = 0;
+
+  /**
+   * Filters a sequence of values, like a log of sensor readings. The results are exactly the same
+   * as calling filter() on each value in order, and the filter is left in the same state
+   * afterwards. The input and output may be the same array.
+   *
+   * The built-in filters process the whole sequence without a virtual call per value.
+   *
+   * @param iinput the values to filter
+   * @param ioutput the filtered results, with room for icount values
+   * @param icount the number of values
+   */
+  virtual void filterBatch(const double *iinput, double *ioutput, std::size_t icount);
 };
 } // namespace okapi
@@ -0,0 +1,118 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/filter/filter.hpp"
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace okapi {
+/**
+ * A filter which passes the input signal through each of its stages in sequence, like
+ * ComposableFilter, but with the stages chosen at compile time. The stages are stored by value
+ * and called without virtual dispatch, so the whole pipeline can be inlined. The output of this
+ * filter is the output of the last stage.
+ *
+ * For example, FilterChain<MedianFilter<5>, EmaFilter> chain(MedianFilter<5>(), EmaFilter(0.2));
+ *
+ * @tparam Stages the types of the filters to use in sequence
+ */
+template <typename... Stages> class FilterChain : public Filter {
+  public:
+  static_assert(sizeof...(Stages) > 0, "A FilterChain needs at least one stage.");
+  static_assert((std::is_base_of_v<Filter, Stages> && ...),
+                "Every stage of a FilterChain must be a Filter.");
+
+  /**
+   * A filter chain with default constructed stages.
+   */
+  FilterChain() = default;
+
+  /**
+   * A filter chain with the given stages.
+   *
+   * @param istages the filters to use in sequence
+   */
+  explicit FilterChain(Stages... istages) : stages(std::move(istages)...) {
+  }
+
+  /**
+   * Filters a value, like a sensor reading.
+   *
+   * @param ireading new measurement
+   * @return filtered result
+   */
+  double filter(const double ireading) override {
+    output = filterFrom<0>(ireading);
+    return output;
+  }
+
+  /**
+   * Returns the previous output from filter.
+   *
+   * @return the previous output from filter
+   */
+  double getOutput() const override {
+    return output;
+  }
+
+  /**
+   * Filters a sequence of values. The results are exactly the same as calling filter() on each
+   * value in order.
+   *
+   * @param iinput the values to filter
+   * @param ioutput the filtered results, with room for icount values
+   * @param icount the number of values
+   */
+  void filterBatch(const double *iinput, double *ioutput, const std::size_t icount) override {
+    for (std::size_t i = 0; i < icount; i++) {
+      ioutput[i] = filterFrom<0>(iinput[i]);
+    }
+
+    if (icount > 0) {
+      output = ioutput[icount - 1];
+    }
+  }
+
+  /**
+   * Returns one of the stages, for example to change its gains.
+   *
+   * @tparam i the index of the stage
+   * @return the stage
+   */
+  template <std::size_t i> auto &getStage() {
+    return std::get<i>(stages);
+  }
+
+  protected:
+  std::tuple<Stages...> stages;
+  double output = 0;
+
+  /**
+   * Passes a value through the stages starting at stage i.
+   *
+   * @tparam i the index of the first stage
+   * @param ireading the input to stage i
+   * @return the output of the last stage
+   */
+  template <std::size_t i> double filterFrom(const double ireading) {
+    using Stage = std::tuple_element_t<i, std::tuple<Stages...>>;
+
+    // Qualify the call so it is not dispatched virtually
+    const double stageOutput = std::get<i>(stages).Stage::filter(ireading);
+
+    if constexpr (i + 1 < sizeof...(Stages)) {
+      return filterFrom<i + 1>(stageOutput);
+    } else {
+      return stageOutput;
+    }
+  }
+};
+} // namespace okapi
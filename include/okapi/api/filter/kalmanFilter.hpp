@@ -0,0 +1,191 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/util/logging.hpp"
+#include "okapi/api/util/matrix.hpp"
+#include <cstddef>
+#include <utility>
+
+namespace okapi {
+/**
+ * A linear or extended Kalman filter with N states and U control inputs. Unlike EKFFilter, which
+ * has one state, this can fuse several sensors into one estimate, like an encoder and a gyro
+ * measuring different parts of a chassis's state.
+ *
+ * Every matrix has its size fixed at compile time and lives on the stack, so predict and update
+ * never allocate. Each update can use a measurement of a different size, so sensors which update
+ * at different rates can each be fused as they arrive.
+ *
+ * @tparam N the number of states
+ * @tparam U the number of control inputs
+ */
+template <std::size_t N, std::size_t U = 0> class KalmanFilter {
+  public:
+  using StateVector = Matrix<N, 1>;
+  using StateMatrix = Matrix<N, N>;
+  using ControlVector = Matrix<U, 1>;
+  using ControlMatrix = Matrix<N, U>;
+
+  enum class CovarianceUpdate {
+    simple, // P = (I - KH)P, which is cheaper but can lose symmetry and positive definiteness
+    joseph  // P = (I - KH)P(I - KH)^T + KRK^T, which stays symmetric and positive definite
+  };
+
+  /**
+   * A Kalman filter.
+   *
+   * @param ix the initial state estimate
+   * @param iP the covariance of the initial state estimate
+   * @param icovarianceUpdate how the covariance is updated after a measurement
+   */
+  KalmanFilter(const StateVector &ix,
+               const StateMatrix &iP,
+               const CovarianceUpdate icovarianceUpdate = CovarianceUpdate::joseph)
+    : x(ix), P(iP), covarianceUpdate(icovarianceUpdate) {
+  }
+
+  /**
+   * Predicts the state with a linear model, x = Fx.
+   *
+   * @param iF the state transition matrix
+   * @param iQ the covariance of the process noise
+   */
+  void predict(const StateMatrix &iF, const StateMatrix &iQ) {
+    x = iF * x;
+    P = iF * P * iF.transpose() + iQ;
+  }
+
+  /**
+   * Predicts the state with a linear model and a control input, x = Fx + Bu.
+   *
+   * @param iF the state transition matrix
+   * @param iB the control matrix
+   * @param iu the control input
+   * @param iQ the covariance of the process noise
+   */
+  void predict(const StateMatrix &iF,
+               const ControlMatrix &iB,
+               const ControlVector &iu,
+               const StateMatrix &iQ) {
+    x = iF * x + iB * iu;
+    P = iF * P * iF.transpose() + iQ;
+  }
+
+  /**
+   * Predicts the state with a nonlinear model (the extended Kalman filter), x = f(x).
+   *
+   * @param ifunction the state transition function, taking and returning a StateVector
+   * @param iF the Jacobian of the state transition function at the current state
+   * @param iQ the covariance of the process noise
+   */
+  template <typename F>
+  void predict(F &&ifunction, const StateMatrix &iF, const StateMatrix &iQ) {
+    x = std::forward<F>(ifunction)(static_cast<const StateVector &>(x));
+    P = iF * P * iF.transpose() + iQ;
+  }
+
+  /**
+   * Corrects the state with a measurement from a linear model, z = Hx. The update is skipped (and
+   * false returned) if the innovation covariance cannot be inverted.
+   *
+   * @tparam M the size of the measurement
+   * @param iz the measurement
+   * @param iH the measurement matrix
+   * @param iR the covariance of the measurement noise
+   * @return whether the update was applied
+   */
+  template <std::size_t M>
+  bool update(const Matrix<M, 1> &iz, const Matrix<M, N> &iH, const Matrix<M, M> &iR) {
+    return correct(iz - iH * x, iH, iR);
+  }
+
+  /**
+   * Corrects the state with a measurement from a nonlinear model (the extended Kalman filter),
+   * z = h(x). The update is skipped (and false returned) if the innovation covariance cannot be
+   * inverted.
+   *
+   * @tparam M the size of the measurement
+   * @param iz the measurement
+   * @param ifunction the measurement function, taking a StateVector and returning a Matrix<M, 1>
+   * @param iH the Jacobian of the measurement function at the current state
+   * @param iR the covariance of the measurement noise
+   * @return whether the update was applied
+   */
+  template <std::size_t M, typename F>
+  bool update(const Matrix<M, 1> &iz,
+              F &&ifunction,
+              const Matrix<M, N> &iH,
+              const Matrix<M, M> &iR) {
+    const Matrix<M, 1> predicted = std::forward<F>(ifunction)(static_cast<const StateVector &>(x));
+    return correct(iz - predicted, iH, iR);
+  }
+
+  /**
+   * @return the state estimate
+   */
+  const StateVector &getState() const {
+    return x;
+  }
+
+  /**
+   * @return the covariance of the state estimate
+   */
+  const StateMatrix &getCovariance() const {
+    return P;
+  }
+
+  /**
+   * Sets the state estimate, for example to reset the filter.
+   *
+   * @param ix the state estimate
+   */
+  void setState(const StateVector &ix) {
+    x = ix;
+  }
+
+  /**
+   * Sets the covariance of the state estimate.
+   *
+   * @param iP the covariance
+   */
+  void setCovariance(const StateMatrix &iP) {
+    P = iP;
+  }
+
+  protected:
+  StateVector x;
+  StateMatrix P;
+  CovarianceUpdate covarianceUpdate;
+
+  template <std::size_t M>
+  bool correct(const Matrix<M, 1> &iinnovation, const Matrix<M, N> &iH, const Matrix<M, M> &iR) {
+    const Matrix<N, M> PHt = P * iH.transpose();
+    const Matrix<M, M> S = iH * PHt + iR;
+
+    Matrix<M, M> SInverse;
+    if (!S.invert(SInverse)) {
+      Logger::instance()->warn(
+        "KalmanFilter: The innovation covariance is singular. Skipping the update.");
+      return false;
+    }
+
+    const Matrix<N, M> K = PHt * SInverse;
+    x += K * iinnovation;
+
+    const StateMatrix IKH = StateMatrix::identity() - K * iH;
+    if (covarianceUpdate == CovarianceUpdate::joseph) {
+      P = IKH * P * IKH.transpose() + K * iR * K.transpose();
+    } else {
+      P = IKH * P;
+    }
+
+    return true;
+  }
+};
+} // namespace okapi
@@ -50,6 +50,20 @@ template <std::size_t n> class MedianFilter : public Filter {
     return output;
   }
 
+  /**
+   * Filters a sequence of values. The results are exactly the same as calling filter() on each
+   * value in order.
+   *
+   * @param iinput the values to filter
+   * @param ioutput the filtered results, with room for icount values
+   * @param icount the number of values
+   */
+  void filterBatch(const double *iinput, double *ioutput, const std::size_t icount) override {
+    for (std::size_t i = 0; i < icount; i++) {
+      ioutput[i] = MedianFilter::filter(iinput[i]);
+    }
+  }
+
   protected:
   std::array<double, n> data{0};
   std::size_t index = 0;
@@ -61,13 +75,15 @@ template <std::size_t n> class MedianFilter : public Filter {
    */
   double kth_smallset() {
     std::array<double, n> dataCopy = data;
-    size_t j, l, m;
+    // Signed so j can step below l without wrapping around
+    const auto k = static_cast<std::ptrdiff_t>(middleIndex);
+    std::ptrdiff_t j, l, m;
     l = 0;
     m = n - 1;
 
     while (l < m) {
       double x = dataCopy[middleIndex];
-      size_t i = l;
+      std::ptrdiff_t i = l;
       j = m;
       do {
         while (dataCopy[i] < x) {
@@ -84,9 +100,9 @@ template <std::size_t n> class MedianFilter : public Filter {
           j--;
         }
       } while (i <= j);
-      if (j < middleIndex)
+      if (j < k)
         l = i;
-      if (middleIndex < i)
+      if (k < i)
         m = j;
     }
 
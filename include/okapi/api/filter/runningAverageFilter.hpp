@@ -0,0 +1,84 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/filter/filter.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace okapi {
+/**
+ * An averaging filter with the same output as AverageFilter which keeps a running sum of the
+ * window instead of summing it for every reading, so each reading costs O(1) regardless of the
+ * window size. The sum is recomputed from the window once per pass over it so rounding errors do
+ * not accumulate. The window size is chosen at runtime; see RunningAverageFilter for a fixed size.
+ */
+class DynamicRunningAverageFilter : public Filter {
+  public:
+  /**
+   * Averaging filter with a running sum. Throws a std::invalid_argument exception if the window
+   * size is zero.
+   *
+   * @param iwindowSize the number of readings to average
+   */
+  explicit DynamicRunningAverageFilter(std::size_t iwindowSize);
+
+  /**
+   * Filters a value, like a sensor reading.
+   *
+   * @param ireading new measurement
+   * @return filtered result
+   */
+  double filter(double ireading) override;
+
+  /**
+   * Returns the previous output from filter.
+   *
+   * @return the previous output from filter
+   */
+  double getOutput() const override;
+
+  /**
+   * Filters a sequence of values. The results are exactly the same as calling filter() on each
+   * value in order.
+   *
+   * @param iinput the values to filter
+   * @param ioutput the filtered results, with room for icount values
+   * @param icount the number of values
+   */
+  void filterBatch(const double *iinput, double *ioutput, std::size_t icount) override;
+
+  /**
+   * @return the number of readings averaged
+   */
+  std::size_t getWindowSize() const;
+
+  protected:
+  std::vector<double> data;
+  std::size_t index = 0;
+  double sum = 0;
+  double output = 0;
+};
+
+/**
+ * A DynamicRunningAverageFilter with a window size chosen at compile time, which can replace an
+ * AverageFilter of the same size.
+ *
+ * @tparam n the number of readings to average
+ */
+template <std::size_t n> class RunningAverageFilter : public DynamicRunningAverageFilter {
+  public:
+  static_assert(n > 0, "The window size must be greater than zero.");
+
+  /**
+   * Averaging filter with a running sum.
+   */
+  RunningAverageFilter() : DynamicRunningAverageFilter(n) {
+  }
+};
+} // namespace okapi
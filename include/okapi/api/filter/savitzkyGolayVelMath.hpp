@@ -0,0 +1,100 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/filter/passthroughFilter.hpp"
+#include "okapi/api/filter/velMath.hpp"
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace okapi {
+/**
+ * Velocity math helper which fits a polynomial to a sliding window of (time, position) samples by
+ * least squares (a Savitzky-Golay filter) and takes the velocity and acceleration from the same
+ * fit. This is much less noisy than differencing filtered velocities to get the acceleration.
+ *
+ * The fit is evaluated at the newest sample, so there is no delay for motion which is a polynomial
+ * of at most the fit's order over the window; faster changes are smoothed over the window. When
+ * the samples are evenly spaced (as they are with motor timestamps or a steady loop), the
+ * estimates are convolutions with coefficients computed once in the constructor. Otherwise, the fit
+ * is solved for the actual sample times.
+ *
+ * This can be used anywhere a VelMath is, with every step function. The velocity is also passed
+ * through the filter, which is a PassthroughFilter by default.
+ */
+class SavitzkyGolayVelMath : public VelMath {
+  public:
+  /**
+   * Polynomial fit velocity math helper. Throws a std::invalid_argument exception if iticksPerRev
+   * is zero, the order is not 1, 2, or 3, or the window is not larger than the order.
+   *
+   * @param iticksPerRev number of ticks per revolution (or whatever units you are using)
+   * @param iwindowSize the number of samples to fit
+   * @param iorder the order of the polynomial. An order of 1 gives no acceleration.
+   * @param isampleTime the minimum time between velocity measurements
+   * @param iloopDtTimer the timer used by step(double)
+   * @param ifilter filter used for filtering the calculated velocity
+   */
+  SavitzkyGolayVelMath(
+    double iticksPerRev,
+    std::size_t iwindowSize,
+    std::size_t iorder,
+    QTime isampleTime,
+    std::unique_ptr<AbstractTimer> iloopDtTimer,
+    const std::shared_ptr<Filter> &ifilter = std::make_shared<PassthroughFilter>());
+
+  /**
+   * @return the number of samples fit
+   */
+  std::size_t getWindowSize() const;
+
+  /**
+   * @return the order of the polynomial
+   */
+  std::size_t getOrder() const;
+
+  protected:
+  static constexpr std::size_t maxOrder = 3;
+
+  const std::size_t windowSize;
+  const std::size_t order;
+
+  // The samples in the window, oldest first once the window is full
+  std::vector<double> times;     // s
+  std::vector<double> positions; // ticks
+  std::size_t head{0};           // The index of the oldest sample
+  std::size_t count{0};
+  double time{0}; // The time of the newest sample in s
+
+  // The window oldest first and relative to the newest sample, for calculate()
+  std::vector<double> windowTimes;
+  std::vector<double> windowPositions;
+
+  // The derivatives at the newest of evenly spaced samples are the dot products of these with
+  // the positions (oldest first), divided by the spacing (squared for the acceleration)
+  std::vector<double> velCoefficients;
+  std::vector<double> accelCoefficients;
+
+  void calculate(double inewPos, QTime idt) override;
+
+  /**
+   * Fits a polynomial to the samples by least squares. The times should be centered near zero for
+   * conditioning.
+   *
+   * @param ix the sample times
+   * @param iy the sample positions
+   * @param in the number of samples
+   * @param idegree the degree of the polynomial, less than in
+   * @return the coefficients of the polynomial, lowest power first
+   */
+  static std::array<double, maxOrder + 1>
+  fit(const double *ix, const double *iy, std::size_t in, std::size_t idegree);
+};
+} // namespace okapi
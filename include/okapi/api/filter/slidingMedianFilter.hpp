@@ -0,0 +1,92 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/filter/filter.hpp"
+#include <cstddef>
+#include <set>
+#include <vector>
+
+namespace okapi {
+/**
+ * A median filter with the same output as MedianFilter (the lower median for even window sizes)
+ * which keeps the window in sorted order instead of selecting the median from a copy of it for
+ * every reading, so each reading costs O(log n). The oldest reading's node is reused for the new
+ * reading, so filtering does not allocate. The window size is chosen at runtime; see
+ * SlidingMedianFilter for a fixed size.
+ */
+class DynamicSlidingMedianFilter : public Filter {
+  public:
+  /**
+   * Median filter over a sliding window. Throws a std::invalid_argument exception if the window
+   * size is zero.
+   *
+   * @param iwindowSize the number of readings to take the median of
+   */
+  explicit DynamicSlidingMedianFilter(std::size_t iwindowSize);
+
+  DynamicSlidingMedianFilter(const DynamicSlidingMedianFilter &iother);
+
+  DynamicSlidingMedianFilter &operator=(const DynamicSlidingMedianFilter &iother);
+
+  /**
+   * Filters a value, like a sensor reading.
+   *
+   * @param ireading new measurement
+   * @return filtered result
+   */
+  double filter(double ireading) override;
+
+  /**
+   * Returns the previous output from filter.
+   *
+   * @return the previous output from filter
+   */
+  double getOutput() const override;
+
+  /**
+   * Filters a sequence of values. The results are exactly the same as calling filter() on each
+   * value in order.
+   *
+   * @param iinput the values to filter
+   * @param ioutput the filtered results, with room for icount values
+   * @param icount the number of values
+   */
+  void filterBatch(const double *iinput, double *ioutput, std::size_t icount) override;
+
+  /**
+   * @return the number of readings the median is taken of
+   */
+  std::size_t getWindowSize() const;
+
+  protected:
+  std::vector<double> data;
+  std::multiset<double> sorted;
+  std::multiset<double>::iterator median;
+  std::size_t middleIndex;
+  std::size_t index = 0;
+  double output = 0;
+};
+
+/**
+ * A DynamicSlidingMedianFilter with a window size chosen at compile time, which can replace a
+ * MedianFilter of the same size.
+ *
+ * @tparam n the number of readings to take the median of
+ */
+template <std::size_t n> class SlidingMedianFilter : public DynamicSlidingMedianFilter {
+  public:
+  static_assert(n > 0, "The window size must be greater than zero.");
+
+  /**
+   * Median filter over a sliding window.
+   */
+  SlidingMedianFilter() : DynamicSlidingMedianFilter(n) {
+  }
+};
+} // namespace okapi
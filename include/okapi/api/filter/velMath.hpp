@@ -7,12 +7,14 @@
  */
 #pragma once
 
+#include "okapi/api/device/motor/abstractMotor.hpp"
 #include "okapi/api/filter/composableFilter.hpp"
 #include "okapi/api/units/QAngularAcceleration.hpp"
 #include "okapi/api/units/QAngularSpeed.hpp"
 #include "okapi/api/units/QTime.hpp"
 #include "okapi/api/util/abstractTimer.hpp"
 #include "okapi/api/util/logging.hpp"
+#include <cstdint>
 #include <memory>
 
 namespace okapi {
@@ -57,6 +59,36 @@ class VelMath {
    */
   virtual QAngularSpeed step(double inewPos);
 
+  /**
+   * Calculates the current velocity and acceleration using the time the position was measured
+   * instead of reading the timer. The first call only records the sample. Returns the (filtered)
+   * velocity.
+   *
+   * @param inewPos new position
+   * @param inow the time the position was measured
+   * @return current (filtered) velocity
+   */
+  virtual QAngularSpeed step(double inewPos, QTime inow);
+
+  /**
+   * Calculates the current velocity and acceleration from the motor's raw encoder count and the
+   * time the motor sampled it (see AbstractMotor::getRawPosition()). Unlike step(double), the time
+   * between samples comes from the motor, so loop jitter does not show up as velocity noise. The
+   * ticks per revolution must be in raw encoder counts (for example, imev5GreenTPR).
+   *
+   * The motor only samples its encoder every few milliseconds, so a reading with the same
+   * timestamp as the last one is skipped, as are failed reads. The first call only records the
+   * sample. Returns the (filtered) velocity.
+   *
+   * The last sample is shared with step(double, QTime), whose timestamps come from a different
+   * clock, so use only one of the two with a VelMath.
+   *
+   * @param imotor the motor to read
+   * @param onewVelocity set to whether a new velocity was calculated, if not null
+   * @return current (filtered) velocity
+   */
+  virtual QAngularSpeed step(AbstractMotor &imotor, bool *onewVelocity = nullptr);
+
   /**
    * Sets ticks per revolution (or whatever units you are using).
    *
@@ -74,6 +106,12 @@ class VelMath {
    */
   virtual QAngularAcceleration getAccel() const;
 
+  /**
+   * Returns the time of the last sample used by step(double, QTime) or step(AbstractMotor &). For
+   * step(AbstractMotor &), this is in the motor's clock.
+   */
+  virtual QTime getLastSampleTime() const;
+
   protected:
   Logger *logger;
   QAngularSpeed vel{0_rpm};
@@ -81,9 +119,20 @@ class VelMath {
   QAngularAcceleration accel{0.0};
   double lastPos{0};
   double ticksPerRev;
+  QTime lastStepTime{0_ms};
+  bool hasLastStepTime{false};
+  std::uint32_t lastTimestamp{0}; // The motor's timestamp of lastStepTime, in ms
 
   QTime sampleTime;
   std::unique_ptr<AbstractTimer> loopDtTimer;
   std::shared_ptr<Filter> filter;
+
+  /**
+   * Updates the velocity and acceleration from a new position measured idt after the last one.
+   *
+   * @param inewPos new position
+   * @param idt time since the last position
+   */
+  virtual void calculate(double inewPos, QTime idt);
 };
 } // namespace okapi
@@ -0,0 +1,25 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/units/QAngle.hpp"
+#include "okapi/api/units/QLength.hpp"
+#include "okapi/api/units/QTime.hpp"
+
+namespace okapi {
+/**
+ * The pose of a chassis on the field. The chassis starts at the origin facing along the x axis; y
+ * is to its left and theta is counterclockwise. time is when the sensors were read.
+ */
+struct OdomState {
+  QLength x{0_m};
+  QLength y{0_m};
+  QAngle theta{0_deg};
+  QTime time{0_ms};
+};
+} // namespace okapi
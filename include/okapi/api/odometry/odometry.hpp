@@ -0,0 +1,148 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/chassis/controller/chassisScales.hpp"
+#include "okapi/api/chassis/model/readOnlyChassisModel.hpp"
+#include "okapi/api/coreProsAPI.hpp"
+#include "okapi/api/control/controllerInput.hpp"
+#include "okapi/api/device/rotarysensor/continuousRotarySensor.hpp"
+#include "okapi/api/odometry/odomState.hpp"
+#include "okapi/api/units/QLength.hpp"
+#include "okapi/api/units/QTime.hpp"
+#include "okapi/api/util/leftRightBuffer.hpp"
+#include "okapi/api/util/logging.hpp"
+#include "okapi/api/util/timeUtil.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace okapi {
+/**
+ * Tracks the pose of a skid steer chassis from its encoders. Each step reads the left and right
+ * encoders, the middle encoder if the model has one (like ThreeEncoderSkidSteerModel), and the
+ * gyro if there is one. The motion since the last step is integrated as an arc of constant
+ * curvature, which is exact for any motion with constant curvature between steps instead of only
+ * for straight lines.
+ *
+ * The encoders are converted to distance using the straight scale, so they must be tracking wheels
+ * with the wheel diameter of the scales. The heading is taken from the gyro if there is one,
+ * otherwise from the difference between the left and right encoders and the wheelbase width.
+ *
+ * Call step() yourself, or call startThread() to step in a task at a fixed rate. The pose can be
+ * read from any task with getState(), which never waits, so any number of tasks can read the pose
+ * without slowing down or being slowed down by the odometry task. Odometry is also a
+ * ControllerInput of the pose, so it can be given to controllers which follow a path using the
+ * pose, like AsyncMotionProfileController.
+ */
+class Odometry : public ControllerInput<OdomState> {
+  public:
+  /**
+   * Odometry for a skid steer chassis. Throws a std::invalid_argument exception if the scales'
+   * straight scale or wheelbase width are not positive or the period is not positive.
+   *
+   * @param imodel the chassis model to read the encoders from. Its sensor readings must be in the
+   * format {left, right} or {left, right, middle}.
+   * @param iscales the scales of the tracking wheels
+   * @param itimeUtil the time util used to timestamp readings and to run the task
+   * @param iperiod the time between steps when running in a task
+   * @param imiddleWheelDistance the distance the middle wheel is mounted behind the center of
+   * rotation (in front is negative). The middle encoder should count up as the chassis moves left.
+   * @param igyro the gyro to read the heading from, or nullptr to use the encoders. Its readings
+   * are in tenths of a degree (like ADIGyro's) and should increase counterclockwise; give an
+   * ADIGyro a multiplier of -1 if it does not.
+   */
+  Odometry(const std::shared_ptr<ReadOnlyChassisModel> &imodel,
+           const ChassisScales &iscales,
+           const TimeUtil &itimeUtil,
+           QTime iperiod = 5_ms,
+           QLength imiddleWheelDistance = 0_m,
+           const std::shared_ptr<ContinuousRotarySensor> &igyro = nullptr);
+
+  Odometry(const Odometry &) = delete;
+  Odometry &operator=(const Odometry &) = delete;
+
+  virtual ~Odometry();
+
+  /**
+   * Reads the sensors and integrates the motion since the last step. The first step only records
+   * the readings. A step where any sensor returns PROS_ERR is skipped.
+   */
+  virtual void step();
+
+  /**
+   * Returns the newest pose. This can be called from any task and never waits.
+   *
+   * @return the newest pose
+   */
+  OdomState getState() const;
+
+  /**
+   * Returns the newest pose. This can be called from any task and never waits.
+   *
+   * @return the newest pose
+   */
+  OdomState controllerGet() override;
+
+  /**
+   * Sets the pose, for example to the starting position on the field. Because only one task may
+   * change the pose, this must be called from the task which calls step(), or before
+   * startThread().
+   *
+   * @param istate the new pose. Its time is ignored.
+   */
+  void setState(const OdomState &istate);
+
+  /**
+   * @return the time between steps when running in a task
+   */
+  QTime getPeriod() const;
+
+  /**
+   * Starts the internal thread, which calls step() every period. This should not be called by
+   * normal users; Odometry is non-copyable, so the thread must be started after it is moved to its
+   * final location.
+   */
+  void startThread();
+
+  protected:
+  Logger *logger;
+  std::shared_ptr<ReadOnlyChassisModel> model;
+  ChassisScales scales;
+  TimeUtil timeUtil;
+  std::unique_ptr<AbstractTimer> timer;
+  const QTime period;
+  const double middleWheelDistance; // m
+  std::shared_ptr<ContinuousRotarySensor> gyro;
+
+  // Only used by the stepping task
+  bool hasLastReadings{false};
+  std::int32_t lastLeft{0};
+  std::int32_t lastRight{0};
+  std::int32_t lastMiddle{0};
+  double lastGyro{0};
+  double x{0};     // m
+  double y{0};     // m
+  double theta{0}; // rad
+
+  LeftRightBuffer<OdomState> state;
+
+  std::atomic_bool dtorCalled{false};
+  CrossplatformThread *task{nullptr};
+
+  static void trampoline(void *context);
+  void loop();
+
+  /**
+   * Publishes the current pose for getState().
+   *
+   * @param itime the time the sensors were read
+   */
+  void publish(QTime itime);
+};
+} // namespace okapi
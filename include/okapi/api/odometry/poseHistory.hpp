@@ -0,0 +1,69 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/odometry/odometry.hpp"
+#include "okapi/api/util/timestampedHistory.hpp"
+#include <cstddef>
+
+namespace okapi {
+/**
+ * Interpolates each part of a pose. The heading is interpolated without wrapping, which is correct
+ * for poses from Odometry because its heading is continuous.
+ */
+template <> struct HistoryInterpolator<OdomState> {
+  OdomState
+  operator()(const OdomState &ibefore, const OdomState &iafter, const double ifraction) const {
+    return OdomState{ibefore.x + (iafter.x - ibefore.x) * ifraction,
+                     ibefore.y + (iafter.y - ibefore.y) * ifraction,
+                     ibefore.theta + (iafter.theta - ibefore.theta) * ifraction,
+                     ibefore.time + (iafter.time - ibefore.time) * ifraction};
+  }
+};
+
+/**
+ * A history of the poses of a chassis, used to look up where the chassis was when a delayed
+ * measurement was taken. Call add(odometry) from the task which uses the history (reading the pose
+ * from Odometry never waits), then look up poses with get().
+ */
+class PoseHistory : public TimestampedHistory<OdomState> {
+  public:
+  /**
+   * A history which holds up to icapacity poses. For example, 100 poses from Odometry running
+   * every 5 ms cover half a second. Throws a std::invalid_argument exception if the capacity is
+   * zero.
+   *
+   * @param icapacity the number of poses to keep
+   */
+  explicit PoseHistory(const std::size_t icapacity) : TimestampedHistory<OdomState>(icapacity) {
+  }
+
+  using TimestampedHistory<OdomState>::add;
+
+  /**
+   * Adds a pose at its own time. The pose is not added if it is not newer than the newest pose.
+   *
+   * @param istate the pose
+   * @return whether the pose was added
+   */
+  bool add(const OdomState &istate) {
+    return add(istate.time, istate);
+  }
+
+  /**
+   * Adds the newest pose from odometry. The pose is not added if odometry has not stepped since
+   * the last time it was added.
+   *
+   * @param iodometry the odometry to read the pose from
+   * @return whether a pose was added
+   */
+  bool add(const Odometry &iodometry) {
+    return add(iodometry.getState());
+  }
+};
+} // namespace okapi
@@ -0,0 +1,124 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+
+namespace okapi {
+/**
+ * Shares a value written by one task with any number of reading tasks without a mutex, using the
+ * left-right technique. The value is kept in two copies. Readers always read the copy the writer
+ * is not writing, so a read is a fixed number of steps and never waits (it is wait-free), no matter
+ * what the writer is doing or how the tasks are scheduled.
+ *
+ * The writer never waits either. After publishing a copy, the writer may only reuse the other copy
+ * once every reader which could still be reading it has left. If a reader is still there, the
+ * newest value is held back and published by a later call to write() or flush() instead of
+ * spinning, so a low priority reader can never stall a high priority writer. A value which is held
+ * back is replaced by any newer value, so readers always get the newest value which has been
+ * published.
+ *
+ * Only one task may call write() and flush(). Any task may call read().
+ *
+ * @tparam T the type of the value, which must be copyable
+ */
+template <typename T> class LeftRightBuffer {
+  public:
+  /**
+   * A buffer holding the given value.
+   *
+   * @param ivalue the initial value
+   */
+  explicit LeftRightBuffer(const T &ivalue = T()) : instances{{ivalue, ivalue}} {
+  }
+
+  /**
+   * Reads the newest published value. This never waits.
+   *
+   * @return the newest published value
+   */
+  T read() const {
+    const int version = versionIndex.load();
+    readIndicators[version].fetch_add(1);
+    const T out = instances[leftRight.load()];
+    readIndicators[version].fetch_sub(1);
+    return out;
+  }
+
+  /**
+   * Publishes a new value. This never waits. Only one task may write.
+   *
+   * @param ivalue the new value
+   */
+  void write(const T &ivalue) {
+    pending = ivalue;
+    hasPending = true;
+    flush();
+  }
+
+  /**
+   * Tries again to publish a value which was held back because a reader was still reading. This
+   * never waits. Only the writing task may call this.
+   *
+   * @return whether every written value has been published
+   */
+  bool flush() {
+    while (true) {
+      switch (phase) {
+      case Phase::idle:
+        if (!hasPending) {
+          return true;
+        }
+
+        // Readers are never on the copy leftRight doesn't point to while idle
+        {
+          const int next = 1 - leftRight.load();
+          instances[next] = pending;
+          hasPending = false;
+          leftRight.store(next);
+        }
+        phase = Phase::toggleVersion;
+        break;
+
+      case Phase::toggleVersion: {
+        // Some readers may have read the old leftRight. Move new readers to the other indicator
+        // once it is empty, then wait for the old indicator to empty.
+        const int next = 1 - versionIndex.load();
+        if (readIndicators[next].load() != 0) {
+          return false;
+        }
+        versionIndex.store(next);
+        phase = Phase::drain;
+        break;
+      }
+
+      case Phase::drain:
+        if (readIndicators[1 - versionIndex.load()].load() != 0) {
+          return false;
+        }
+        phase = Phase::idle;
+        break;
+      }
+    }
+  }
+
+  protected:
+  enum class Phase { idle, toggleVersion, drain };
+
+  std::array<T, 2> instances;
+  std::atomic_int leftRight{0};
+  std::atomic_int versionIndex{0};
+  mutable std::array<std::atomic_int, 2> readIndicators{{{0}, {0}}};
+
+  // Only used by the writer
+  T pending{};
+  bool hasPending{false};
+  Phase phase{Phase::idle};
+};
+} // namespace okapi
@@ -7,6 +7,7 @@
  */
 #pragma once
 
+#include "okapi/api/units/QTime.hpp"
 #include <algorithm>
 #include <cstdint>
 #include <type_traits>
@@ -30,6 +31,12 @@ static constexpr double gravity = 9.80665;
 static constexpr std::int8_t motorUpdateRate = 10;
 static constexpr std::int8_t adiUpdateRate = 10;
 
+/**
+ * Timestamps closer together than this are treated as equal when comparing a time difference
+ * against a sample time, so floating point error in QTime arithmetic does not skip a sample.
+ */
+static constexpr QTime timestampEpsilon = 0.001_ms;
+
 /**
  * Integer power function. Computes base^expo.
  *
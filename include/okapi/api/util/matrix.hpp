@@ -0,0 +1,228 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <initializer_list>
+#include <utility>
+
+namespace okapi {
+/**
+ * A small dense matrix with its size fixed at compile time. The elements are stored inline (row
+ * major), so matrices live on the stack and never allocate. Every loop has a compile-time trip
+ * count, so the compiler can unroll the math for small sizes.
+ *
+ * @tparam R the number of rows
+ * @tparam C the number of columns
+ */
+template <std::size_t R, std::size_t C> class Matrix {
+  public:
+  /**
+   * A matrix of zeros.
+   */
+  constexpr Matrix() : data{} {
+  }
+
+  /**
+   * A matrix with the given elements in row major order. Missing elements are zero.
+   *
+   * @param ielements the elements
+   */
+  constexpr Matrix(std::initializer_list<double> ielements) : data{} {
+    std::size_t i = 0;
+    for (const double element : ielements) {
+      if (i < R * C) {
+        data[i++] = element;
+      }
+    }
+  }
+
+  /**
+   * @return an identity matrix
+   */
+  static constexpr Matrix identity() {
+    static_assert(R == C, "Only a square matrix can be an identity matrix.");
+    Matrix out;
+    for (std::size_t i = 0; i < R; i++) {
+      out(i, i) = 1;
+    }
+    return out;
+  }
+
+  constexpr double &operator()(const std::size_t irow, const std::size_t icol) {
+    return data[irow * C + icol];
+  }
+
+  constexpr double operator()(const std::size_t irow, const std::size_t icol) const {
+    return data[irow * C + icol];
+  }
+
+  /**
+   * Element access for vectors (matrices with one column).
+   */
+  constexpr double &operator[](const std::size_t irow) {
+    static_assert(C == 1, "Only a vector can be indexed with one index.");
+    return data[irow];
+  }
+
+  constexpr double operator[](const std::size_t irow) const {
+    static_assert(C == 1, "Only a vector can be indexed with one index.");
+    return data[irow];
+  }
+
+  static constexpr std::size_t rows() {
+    return R;
+  }
+
+  static constexpr std::size_t cols() {
+    return C;
+  }
+
+  constexpr Matrix<C, R> transpose() const {
+    Matrix<C, R> out;
+    for (std::size_t r = 0; r < R; r++) {
+      for (std::size_t c = 0; c < C; c++) {
+        out(c, r) = (*this)(r, c);
+      }
+    }
+    return out;
+  }
+
+  constexpr Matrix &operator+=(const Matrix &rhs) {
+    for (std::size_t i = 0; i < R * C; i++) {
+      data[i] += rhs.data[i];
+    }
+    return *this;
+  }
+
+  constexpr Matrix &operator-=(const Matrix &rhs) {
+    for (std::size_t i = 0; i < R * C; i++) {
+      data[i] -= rhs.data[i];
+    }
+    return *this;
+  }
+
+  constexpr Matrix &operator*=(const double rhs) {
+    for (std::size_t i = 0; i < R * C; i++) {
+      data[i] *= rhs;
+    }
+    return *this;
+  }
+
+  constexpr Matrix operator+(const Matrix &rhs) const {
+    Matrix out(*this);
+    out += rhs;
+    return out;
+  }
+
+  constexpr Matrix operator-(const Matrix &rhs) const {
+    Matrix out(*this);
+    out -= rhs;
+    return out;
+  }
+
+  constexpr Matrix operator-() const {
+    Matrix out(*this);
+    out *= -1;
+    return out;
+  }
+
+  constexpr Matrix operator*(const double rhs) const {
+    Matrix out(*this);
+    out *= rhs;
+    return out;
+  }
+
+  template <std::size_t K> constexpr Matrix<R, K> operator*(const Matrix<C, K> &rhs) const {
+    Matrix<R, K> out;
+    for (std::size_t r = 0; r < R; r++) {
+      for (std::size_t k = 0; k < C; k++) {
+        const double lhs = (*this)(r, k);
+        for (std::size_t c = 0; c < K; c++) {
+          out(r, c) += lhs * rhs(k, c);
+        }
+      }
+    }
+    return out;
+  }
+
+  constexpr bool operator==(const Matrix &rhs) const {
+    for (std::size_t i = 0; i < R * C; i++) {
+      if (data[i] != rhs.data[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  constexpr bool operator!=(const Matrix &rhs) const {
+    return !(*this == rhs);
+  }
+
+  /**
+   * Inverts a square matrix by Gauss-Jordan elimination with partial pivoting.
+   *
+   * @param oinverse set to the inverse if the matrix is invertible, otherwise left unchanged
+   * @return whether the matrix is invertible
+   */
+  bool invert(Matrix &oinverse) const {
+    static_assert(R == C, "Only a square matrix can be inverted.");
+    Matrix a(*this);
+    Matrix out = identity();
+
+    for (std::size_t col = 0; col < R; col++) {
+      std::size_t pivot = col;
+      for (std::size_t r = col + 1; r < R; r++) {
+        if (std::abs(a(r, col)) > std::abs(a(pivot, col))) {
+          pivot = r;
+        }
+      }
+
+      if (a(pivot, col) == 0 || !std::isfinite(a(pivot, col))) {
+        return false;
+      }
+
+      if (pivot != col) {
+        for (std::size_t c = 0; c < C; c++) {
+          std::swap(a(col, c), a(pivot, c));
+          std::swap(out(col, c), out(pivot, c));
+        }
+      }
+
+      const double scale = 1 / a(col, col);
+      for (std::size_t c = 0; c < C; c++) {
+        a(col, c) *= scale;
+        out(col, c) *= scale;
+      }
+
+      for (std::size_t r = 0; r < R; r++) {
+        if (r != col) {
+          const double factor = a(r, col);
+          for (std::size_t c = 0; c < C; c++) {
+            a(r, c) -= factor * a(col, c);
+            out(r, c) -= factor * out(col, c);
+          }
+        }
+      }
+    }
+
+    oinverse = out;
+    return true;
+  }
+
+  protected:
+  std::array<double, R * C> data;
+};
+
+template <std::size_t R, std::size_t C>
+constexpr Matrix<R, C> operator*(const double lhs, const Matrix<R, C> &rhs) {
+  return rhs * lhs;
+}
+} // namespace okapi
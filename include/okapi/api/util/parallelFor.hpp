@@ -0,0 +1,30 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/util/abstractRate.hpp"
+#include <cstddef>
+#include <functional>
+
+namespace okapi {
+/**
+ * Calls a function once for every index from 0 to icount - 1 on up to inumThreads threads, and
+ * returns once every call has finished. Threads take the next index as they finish their last one,
+ * so uneven work is spread out. With one thread (or one index) the calls run on the calling thread.
+ * The function must be safe to call from several threads at once for different indices.
+ *
+ * @param icount the number of indices
+ * @param inumThreads the largest number of threads to use
+ * @param ibody the function to call with each index
+ * @param irate the rate used to wait for the threads to finish
+ */
+void parallelFor(std::size_t icount,
+                 std::size_t inumThreads,
+                 const std::function<void(std::size_t)> &ibody,
+                 AbstractRate &irate);
+} // namespace okapi
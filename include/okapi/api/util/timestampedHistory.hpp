@@ -0,0 +1,199 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/units/QTime.hpp"
+#include "okapi/api/util/logging.hpp"
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace okapi {
+/**
+ * Interpolates between two values of a TimestampedHistory. The default works for any type with
+ * addition, subtraction, and multiplication by a double (numbers, Matrix, and many units).
+ * Specialize this for other types.
+ */
+template <typename T> struct HistoryInterpolator {
+  /**
+   * @param ibefore the value before
+   * @param iafter the value after
+   * @param ifraction how far to go from ibefore to iafter, in [0, 1]
+   * @return the interpolated value
+   */
+  T operator()(const T &ibefore, const T &iafter, const double ifraction) const {
+    return ibefore + (iafter - ibefore) * ifraction;
+  }
+};
+
+/**
+ * Interpolates each element of an array, for snapshots of several sensors.
+ */
+template <typename E, std::size_t N> struct HistoryInterpolator<std::array<E, N>> {
+  std::array<E, N>
+  operator()(const std::array<E, N> &ibefore, const std::array<E, N> &iafter, double ifraction)
+    const {
+    std::array<E, N> out;
+    for (std::size_t i = 0; i < N; i++) {
+      out[i] = HistoryInterpolator<E>()(ibefore[i], iafter[i], ifraction);
+    }
+    return out;
+  }
+};
+
+/**
+ * A fixed capacity history of timestamped values, like poses or sensor snapshots, which can be
+ * looked up at any time in the history. Values between two samples are interpolated. This is used
+ * to compensate for sensing latency: a measurement which took time to arrive (like a vision target)
+ * is compared with the pose at the time it was measured instead of the current pose.
+ *
+ * The history is a ring buffer allocated in the constructor, so adding never allocates; once full,
+ * each new value replaces the oldest. Values must be added in order of increasing time, which keeps
+ * the history sorted so a lookup is a binary search. This class is not thread safe, so add and
+ * look up values from the same task.
+ *
+ * @tparam T the type of the values, which must be default constructible
+ * @tparam Interpolator interpolates between two values, see HistoryInterpolator
+ */
+template <typename T, typename Interpolator = HistoryInterpolator<T>> class TimestampedHistory {
+  public:
+  /**
+   * A history which holds up to icapacity values. Throws a std::invalid_argument exception if the
+   * capacity is zero.
+   *
+   * @param icapacity the number of values to keep
+   * @param iinterpolator interpolates between two values
+   */
+  explicit TimestampedHistory(const std::size_t icapacity,
+                              const Interpolator &iinterpolator = Interpolator())
+    : entries(icapacity), interpolator(iinterpolator) {
+    if (icapacity == 0) {
+      const std::string msg = "TimestampedHistory: The capacity must be greater than zero.";
+      Logger::instance()->error(msg);
+      throw std::invalid_argument(msg);
+    }
+  }
+
+  /**
+   * Adds a value, replacing the oldest value if the history is full. The value is not added if its
+   * time is not after the time of the newest value.
+   *
+   * @param itime the time of the value
+   * @param ivalue the value
+   * @return whether the value was added
+   */
+  bool add(const QTime itime, const T &ivalue) {
+    if (count > 0 && itime <= newestTime()) {
+      return false;
+    }
+
+    if (count < entries.size()) {
+      entries[(head + count) % entries.size()] = Entry{itime, ivalue};
+      count++;
+    } else {
+      entries[head] = Entry{itime, ivalue};
+      head = (head + 1) % entries.size();
+    }
+
+    return true;
+  }
+
+  /**
+   * Looks up the value at a time, interpolating between the values on either side of it. This is a
+   * binary search, so it takes O(log n) time.
+   *
+   * @param itime the time to look up
+   * @param ovalue set to the value at itime if it is in the history, otherwise left unchanged
+   * @return whether itime is between the oldest and newest times in the history
+   */
+  bool get(const QTime itime, T &ovalue) const {
+    if (count == 0 || itime < oldestTime() || itime > newestTime()) {
+      return false;
+    }
+
+    // Find the first value after itime. The value before it is at or before itime.
+    std::size_t low = 0;
+    std::size_t high = count;
+    while (low < high) {
+      const std::size_t mid = low + (high - low) / 2;
+      if (at(mid).time <= itime) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+
+    const Entry &before = at(low - 1);
+    if (low == count || before.time == itime) {
+      ovalue = before.value;
+      return true;
+    }
+
+    const Entry &after = at(low);
+    const double fraction = ((itime - before.time) / (after.time - before.time)).getValue();
+    ovalue = interpolator(before.value, after.value, fraction);
+    return true;
+  }
+
+  /**
+   * @return the time of the oldest value, or zero if the history is empty
+   */
+  QTime oldestTime() const {
+    return count == 0 ? 0_ms : at(0).time;
+  }
+
+  /**
+   * @return the time of the newest value, or zero if the history is empty
+   */
+  QTime newestTime() const {
+    return count == 0 ? 0_ms : at(count - 1).time;
+  }
+
+  /**
+   * @return the number of values in the history
+   */
+  std::size_t size() const {
+    return count;
+  }
+
+  /**
+   * @return the maximum number of values in the history
+   */
+  std::size_t capacity() const {
+    return entries.size();
+  }
+
+  /**
+   * Removes every value.
+   */
+  void clear() {
+    head = 0;
+    count = 0;
+  }
+
+  protected:
+  struct Entry {
+    QTime time{0_ms};
+    T value{};
+  };
+
+  std::vector<Entry> entries;
+  std::size_t head{0}; // The index of the oldest value
+  std::size_t count{0};
+  Interpolator interpolator;
+
+  /**
+   * @param iindex the index of a value, with the oldest value at zero
+   * @return the value
+   */
+  const Entry &at(const std::size_t iindex) const {
+    return entries[(head + iindex) % entries.size()];
+  }
+};
+} // namespace okapi
@@ -7,6 +7,7 @@
  */
 #pragma once
 
+#include "okapi/api/control/iterative/iterativeGainScheduledPosPidController.hpp"
 #include "okapi/api/control/iterative/iterativeMotorVelocityController.hpp"
 #include "okapi/api/control/iterative/iterativePosPidController.hpp"
 #include "okapi/api/control/iterative/iterativeVelPidController.hpp"
@@ -32,6 +33,18 @@ class IterativeControllerFactory {
          double ikBias = 0,
          std::unique_ptr<Filter> iderivativeFilter = std::make_unique<PassthroughFilter>());
 
+  /**
+   * Gain-scheduled position PID controller.
+   *
+   * @param ischedule the gain breakpoints
+   * @param ischeduleInput the input used to look up the gains
+   * @param iderivativeFilter a filter for filtering the derivative term
+   */
+  static IterativeGainScheduledPosPIDController gainScheduledPosPID(
+    const std::vector<IterativeGainScheduledPosPIDController::Breakpoint> &ischedule,
+    std::shared_ptr<ControllerInput<double>> ischeduleInput,
+    std::unique_ptr<Filter> iderivativeFilter = std::make_unique<PassthroughFilter>());
+
   /**
    * Velocity PD controller.
    *
@@ -0,0 +1,32 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "okapi/api/control/util/controllerSweep.hpp"
+#include <memory>
+
+namespace okapi {
+class ControllerSweepFactory {
+  public:
+  static ControllerSweep
+  create(const Supplier<std::unique_ptr<FlywheelSimulator>> &isimulatorSupplier,
+         const Supplier<std::unique_ptr<IterativePosPIDController>> &icontrollerSupplier,
+         double itarget,
+         QTime itimeout = 5_s,
+         QTime iloopDelta = 10_ms,
+         std::int32_t inumThreads = 4);
+
+  static std::unique_ptr<ControllerSweep>
+  createPtr(const Supplier<std::unique_ptr<FlywheelSimulator>> &isimulatorSupplier,
+            const Supplier<std::unique_ptr<IterativePosPIDController>> &icontrollerSupplier,
+            double itarget,
+            QTime itimeout = 5_s,
+            QTime iloopDelta = 10_ms,
+            std::int32_t inumThreads = 4);
+};
+} // namespace okapi
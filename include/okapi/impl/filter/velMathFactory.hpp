@@ -7,6 +7,7 @@
  */
 #pragma once
 
+#include "okapi/api/filter/savitzkyGolayVelMath.hpp"
 #include "okapi/api/filter/velMath.hpp"
 #include <memory>
 
@@ -37,5 +38,19 @@ class VelMathFactory {
   createPtr(double iticksPerRev, std::shared_ptr<Filter> ifilter, QTime isampleTime = 0_ms);
 
   static std::unique_ptr<VelMath> createPtr(const VelMathArgs &ivelMathArgs);
+
+  /**
+   * Velocity math helper which fits a polynomial to the last few positions, see
+   * SavitzkyGolayVelMath. Throws a std::invalid_argument exception if iticksPerRev is zero, the
+   * order is not 1, 2, or 3, or the window is not larger than the order.
+   *
+   * @param iticksPerRev number of ticks per revolution (or whatever units you are using)
+   * @param iwindowSize the number of samples to fit
+   * @param iorder the order of the polynomial
+   */
+  static std::unique_ptr<VelMath> createSavitzkyGolayPtr(double iticksPerRev,
+                                                         std::size_t iwindowSize = 8,
+                                                         std::size_t iorder = 2,
+                                                         QTime isampleTime = 0_ms);
 };
 } // namespace okapi
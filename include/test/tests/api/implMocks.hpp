@@ -148,6 +148,18 @@ class MockMotor : public AbstractMotor {
   AbstractMotor::brakeMode brakeMode{AbstractMotor::brakeMode::coast};
 };
 
+/**
+ * A motor mock whose raw position is a sample and timestamp set by the test, like a motor which
+ * samples its encoder on its own clock.
+ */
+class SampledMockMotor : public MockMotor {
+  public:
+  int32_t getRawPosition(std::uint32_t *timestamp) override;
+
+  std::int32_t rawPosition{0};
+  std::uint32_t sampleTimestamp{0};
+};
+
 class ThreadedMockMotor : public AbstractMotor {
   public:
   ThreadedMockMotor();
@@ -345,6 +357,20 @@ class MockRate : public AbstractRate {
   void delayUntil(uint32_t ims) override;
 };
 
+/**
+ * A rate which returns immediately, for running loops in virtual time.
+ */
+class NoDelayRate : public AbstractRate {
+  public:
+  void delay(QFrequency ihz) override;
+
+  void delay(int ihz) override;
+
+  void delayUntil(QTime itime) override;
+
+  void delayUntil(uint32_t ims) override;
+};
+
 std::unique_ptr<SettledUtil> createSettledUtilPtr(double iatTargetError = 50,
                                                   double iatTargetDerivative = 5,
                                                   QTime iatTargetTime = 250_ms);
@@ -357,6 +383,25 @@ TimeUtil createTimeUtil(const Supplier<std::unique_ptr<AbstractTimer>> &itimerSu
 
 TimeUtil createTimeUtil(const Supplier<std::unique_ptr<SettledUtil>> &isettledUtilSupplier);
 
+TimeUtil createTimeUtil(const Supplier<std::unique_ptr<AbstractRate>> &irateSupplier);
+
+/**
+ * Calls a function repeatedly and returns the average wall time per call. Used by the benchmarks,
+ * which are disabled tests run by the optimized benchmark build (see CMakeLists.txt).
+ *
+ * @param ifunc the function to call
+ * @param iiterations the number of calls to time
+ * @return the average number of nanoseconds per call
+ */
+template <typename F> double benchmarkNsPerCall(F &&ifunc, const std::size_t iiterations) {
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < iiterations; i++) {
+    ifunc();
+  }
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / iiterations;
+}
+
 class SimulatedSystem : public ControllerInput<double>, public ControllerOutput<double> {
   public:
   explicit SimulatedSystem(FlywheelSimulator &simulator);
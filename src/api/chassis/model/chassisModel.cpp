@@ -19,4 +19,8 @@ void ChassisModel::setMaxVelocity(const double imaxVelocity) {
 void ChassisModel::setMaxVoltage(const double imaxVoltage) {
   maxVoltage = imaxVoltage;
 }
+
+double ChassisModel::getMaxVoltage() const {
+  return maxVoltage;
+}
 } // namespace okapi
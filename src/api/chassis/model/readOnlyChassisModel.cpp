@@ -6,7 +6,18 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/.
  */
 #include "okapi/api/chassis/model/readOnlyChassisModel.hpp"
+#include <algorithm>
 
 namespace okapi {
 ReadOnlyChassisModel::~ReadOnlyChassisModel() = default;
+
+std::size_t ReadOnlyChassisModel::fillSensorVals(std::int32_t *ovalues,
+                                                 const std::size_t icount) const {
+  const auto values = getSensorVals();
+  const std::size_t count = std::min(icount, values.size());
+  for (std::size_t i = 0; i < count; i++) {
+    ovalues[i] = values[i];
+  }
+  return count;
 }
+} // namespace okapi
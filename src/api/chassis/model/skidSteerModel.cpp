@@ -143,6 +143,17 @@ std::valarray<std::int32_t> SkidSteerModel::getSensorVals() const {
                                      static_cast<std::int32_t>(rightSensor->get())};
 }
 
+std::size_t SkidSteerModel::fillSensorVals(std::int32_t *ovalues, const std::size_t icount) const {
+  std::size_t count = 0;
+  if (count < icount) {
+    ovalues[count++] = static_cast<std::int32_t>(leftSensor->get());
+  }
+  if (count < icount) {
+    ovalues[count++] = static_cast<std::int32_t>(rightSensor->get());
+  }
+  return count;
+}
+
 void SkidSteerModel::resetSensors() const {
   leftSensor->reset();
   rightSensor->reset();
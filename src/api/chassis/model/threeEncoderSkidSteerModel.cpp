@@ -27,6 +27,15 @@ std::valarray<std::int32_t> ThreeEncoderSkidSteerModel::getSensorVals() const {
                                      static_cast<std::int32_t>(middleSensor->get())};
 }
 
+std::size_t ThreeEncoderSkidSteerModel::fillSensorVals(std::int32_t *ovalues,
+                                                       const std::size_t icount) const {
+  std::size_t count = SkidSteerModel::fillSensorVals(ovalues, icount);
+  if (count < icount) {
+    ovalues[count++] = static_cast<std::int32_t>(middleSensor->get());
+  }
+  return count;
+}
+
 void ThreeEncoderSkidSteerModel::resetSensors() const {
   SkidSteerModel::resetSensors();
   middleSensor->reset();
@@ -43,10 +43,7 @@ XDriveModel::XDriveModel(const std::shared_ptr<AbstractMotor> &itopLeftMotor,
 
 void XDriveModel::forward(const double ispeed) const {
   const double speed = std::clamp(ispeed, -1.0, 1.0);
-  topLeftMotor->moveVelocity(static_cast<int16_t>(speed * maxVelocity));
-  topRightMotor->moveVelocity(static_cast<int16_t>(speed * maxVelocity));
-  bottomRightMotor->moveVelocity(static_cast<int16_t>(speed * maxVelocity));
-  bottomLeftMotor->moveVelocity(static_cast<int16_t>(speed * maxVelocity));
+  setWheelCommands({speed, speed, speed, speed}, commandMode::velocity);
 }
 
 void XDriveModel::driveVector(const double iforwardSpeed, const double iyaw) const {
@@ -63,25 +60,16 @@ void XDriveModel::driveVector(const double iforwardSpeed, const double iyaw) con
     rightOutput /= maxInputMag;
   }
 
-  topLeftMotor->moveVelocity(static_cast<int16_t>(leftOutput * maxVelocity));
-  topRightMotor->moveVelocity(static_cast<int16_t>(rightOutput * maxVelocity));
-  bottomRightMotor->moveVelocity(static_cast<int16_t>(rightOutput * maxVelocity));
-  bottomLeftMotor->moveVelocity(static_cast<int16_t>(leftOutput * maxVelocity));
+  setWheelCommands({leftOutput, rightOutput, rightOutput, leftOutput}, commandMode::velocity);
 }
 
 void XDriveModel::rotate(const double ispeed) const {
   const double speed = std::clamp(ispeed, -1.0, 1.0);
-  topLeftMotor->moveVelocity(static_cast<int16_t>(speed * maxVelocity));
-  topRightMotor->moveVelocity(static_cast<int16_t>(-1 * speed * maxVelocity));
-  bottomRightMotor->moveVelocity(static_cast<int16_t>(-1 * speed * maxVelocity));
-  bottomLeftMotor->moveVelocity(static_cast<int16_t>(speed * maxVelocity));
+  setWheelCommands({speed, -1 * speed, -1 * speed, speed}, commandMode::velocity);
 }
 
 void XDriveModel::stop() {
-  topLeftMotor->moveVelocity(0);
-  topRightMotor->moveVelocity(0);
-  bottomRightMotor->moveVelocity(0);
-  bottomLeftMotor->moveVelocity(0);
+  setWheelCommands({0, 0, 0, 0}, commandMode::velocity);
 }
 
 void XDriveModel::tank(const double ileftSpeed,
@@ -99,10 +87,7 @@ void XDriveModel::tank(const double ileftSpeed,
     rightSpeed = 0;
   }
 
-  topLeftMotor->moveVoltage(static_cast<int16_t>(leftSpeed * maxVoltage));
-  topRightMotor->moveVoltage(static_cast<int16_t>(rightSpeed * maxVoltage));
-  bottomRightMotor->moveVoltage(static_cast<int16_t>(rightSpeed * maxVoltage));
-  bottomLeftMotor->moveVoltage(static_cast<int16_t>(leftSpeed * maxVoltage));
+  setWheelCommands({leftSpeed, rightSpeed, rightSpeed, leftSpeed}, commandMode::voltage);
 }
 
 void XDriveModel::arcade(const double iforwardSpeed,
@@ -145,10 +130,7 @@ void XDriveModel::arcade(const double iforwardSpeed,
   leftOutput = std::clamp(leftOutput, -1.0, 1.0);
   rightOutput = std::clamp(rightOutput, -1.0, 1.0);
 
-  topLeftMotor->moveVoltage(static_cast<int16_t>(leftOutput * maxVoltage));
-  topRightMotor->moveVoltage(static_cast<int16_t>(rightOutput * maxVoltage));
-  bottomRightMotor->moveVoltage(static_cast<int16_t>(rightOutput * maxVoltage));
-  bottomLeftMotor->moveVoltage(static_cast<int16_t>(leftOutput * maxVoltage));
+  setWheelCommands({leftOutput, rightOutput, rightOutput, leftOutput}, commandMode::voltage);
 }
 
 void XDriveModel::xArcade(const double ixSpeed,
@@ -170,14 +152,47 @@ void XDriveModel::xArcade(const double ixSpeed,
     yaw = 0;
   }
 
-  topLeftMotor->moveVoltage(
-    static_cast<int16_t>(std::clamp(forwardSpeed + xSpeed + yaw, -1.0, 1.0) * maxVoltage));
-  topRightMotor->moveVoltage(
-    static_cast<int16_t>(std::clamp(forwardSpeed - xSpeed - yaw, -1.0, 1.0) * maxVoltage));
-  bottomRightMotor->moveVoltage(
-    static_cast<int16_t>(std::clamp(forwardSpeed + xSpeed - yaw, -1.0, 1.0) * maxVoltage));
-  bottomLeftMotor->moveVoltage(
-    static_cast<int16_t>(std::clamp(forwardSpeed - xSpeed + yaw, -1.0, 1.0) * maxVoltage));
+  setWheelCommands({std::clamp(forwardSpeed + xSpeed + yaw, -1.0, 1.0),
+                    std::clamp(forwardSpeed - xSpeed - yaw, -1.0, 1.0),
+                    std::clamp(forwardSpeed + xSpeed - yaw, -1.0, 1.0),
+                    std::clamp(forwardSpeed - xSpeed + yaw, -1.0, 1.0)},
+                   commandMode::voltage);
+}
+
+void XDriveModel::driveHolonomic(const double iforwardSpeed,
+                                 const double irightSpeed,
+                                 const double iyaw,
+                                 const commandMode imode) const {
+  setWheelCommands({iforwardSpeed + irightSpeed + iyaw,
+                    iforwardSpeed - irightSpeed - iyaw,
+                    iforwardSpeed + irightSpeed - iyaw,
+                    iforwardSpeed - irightSpeed + iyaw},
+                   imode);
+}
+
+void XDriveModel::setWheelCommands(const std::array<double, 4> &ispeeds,
+                                   const commandMode imode) const {
+  // Scale every wheel by the same amount so the ratios between them, and so the direction the
+  // robot moves in, stay the same
+  double maxMagnitude = 1;
+  for (const double speed : ispeeds) {
+    maxMagnitude = std::max(maxMagnitude, std::abs(speed));
+  }
+
+  const std::array<AbstractMotor *, 4> motors{
+    topLeftMotor.get(), topRightMotor.get(), bottomRightMotor.get(), bottomLeftMotor.get()};
+
+  if (imode == commandMode::velocity) {
+    const double scale = maxVelocity / maxMagnitude;
+    for (std::size_t i = 0; i < motors.size(); i++) {
+      motors[i]->moveVelocity(static_cast<int16_t>(ispeeds[i] * scale));
+    }
+  } else {
+    const double scale = maxVoltage / maxMagnitude;
+    for (std::size_t i = 0; i < motors.size(); i++) {
+      motors[i]->moveVoltage(static_cast<int16_t>(ispeeds[i] * scale));
+    }
+  }
 }
 
 void XDriveModel::left(const double ispeed) const {
@@ -197,6 +212,17 @@ std::valarray<std::int32_t> XDriveModel::getSensorVals() const {
                                      static_cast<std::int32_t>(rightSensor->get())};
 }
 
+std::size_t XDriveModel::fillSensorVals(std::int32_t *ovalues, const std::size_t icount) const {
+  std::size_t count = 0;
+  if (count < icount) {
+    ovalues[count++] = static_cast<std::int32_t>(leftSensor->get());
+  }
+  if (count < icount) {
+    ovalues[count++] = static_cast<std::int32_t>(rightSensor->get());
+  }
+  return count;
+}
+
 void XDriveModel::resetSensors() const {
   leftSensor->reset();
   rightSensor->reset();
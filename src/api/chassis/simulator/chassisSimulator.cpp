@@ -0,0 +1,89 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/chassis/simulator/chassisSimulator.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace okapi {
+ChassisSimulator::ChassisSimulator(std::vector<Wheel> iwheels,
+                                   const QLength iwheelDiameter,
+                                   const QMass imass,
+                                   const double imomentOfInertia,
+                                   const bool inonHolonomic)
+  : wheels(std::move(iwheels)),
+    wheelRadius(iwheelDiameter.convert(meter) / 2),
+    mass(imass.convert(kg)),
+    momentOfInertia(imomentOfInertia),
+    nonHolonomic(inonHolonomic) {
+}
+
+ChassisSimulator::~ChassisSimulator() = default;
+
+void ChassisSimulator::step(const QTime idt) {
+  double remaining = idt.convert(second);
+  while (remaining > 1e-9) {
+    const double dt = std::min(remaining, maxStep);
+
+    double forceX = 0, forceY = 0, torque = 0;
+    for (auto &wheel : wheels) {
+      const double force = wheel.motor->computeTorque(dt * second) * wheel.motorCount / wheelRadius;
+      forceX += wheel.dirX * force;
+      forceY += wheel.dirY * force;
+      torque += wheel.x * wheel.dirY * force - wheel.y * wheel.dirX * force;
+    }
+
+    // Integrate in the chassis frame, which rotates with the chassis
+    const double lastVx = vx;
+    vx += (forceX / mass + omega * vy) * dt;
+    vy = nonHolonomic ? 0 : vy + (forceY / mass - omega * lastVx) * dt;
+    omega += torque / momentOfInertia * dt;
+
+    x += (vx * std::cos(theta) - vy * std::sin(theta)) * dt;
+    y += (vx * std::sin(theta) + vy * std::cos(theta)) * dt;
+    theta += omega * dt;
+
+    for (auto &wheel : wheels) {
+      wheel.motor->advance(dt * second, wheelVelocity(wheel));
+    }
+
+    time += dt;
+    remaining -= dt;
+  }
+}
+
+double ChassisSimulator::wheelVelocity(const Wheel &iwheel) const {
+  return (iwheel.dirX * (vx - omega * iwheel.y) + iwheel.dirY * (vy + omega * iwheel.x)) /
+         wheelRadius;
+}
+
+ChassisSimulator::Pose ChassisSimulator::getPose() const {
+  return Pose{x * meter, y * meter, theta * radian};
+}
+
+void ChassisSimulator::setPose(const Pose &ipose) {
+  x = ipose.x.convert(meter);
+  y = ipose.y.convert(meter);
+  theta = ipose.theta.convert(radian);
+}
+
+QSpeed ChassisSimulator::getForwardVelocity() const {
+  return vx * mps;
+}
+
+QSpeed ChassisSimulator::getStrafeVelocity() const {
+  return vy * mps;
+}
+
+QAngularSpeed ChassisSimulator::getAngularVelocity() const {
+  return omega * radps;
+}
+
+QTime ChassisSimulator::getTime() const {
+  return time * second;
+}
+} // namespace okapi
@@ -0,0 +1,36 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/chassis/simulator/skidSteerSimulator.hpp"
+
+namespace okapi {
+SkidSteerSimulator::SkidSteerSimulator(const std::shared_ptr<SimulatedMotor> &ileftMotor,
+                                       const std::shared_ptr<SimulatedMotor> &irightMotor,
+                                       const QLength iwheelDiameter,
+                                       const QLength iwheelbaseWidth,
+                                       const QMass imass,
+                                       const double imomentOfInertia,
+                                       const std::size_t imotorsPerSide)
+  : ChassisSimulator(
+      {Wheel{ileftMotor,
+             static_cast<double>(imotorsPerSide),
+             0,
+             iwheelbaseWidth.convert(meter) / 2,
+             1,
+             0},
+       Wheel{irightMotor,
+             static_cast<double>(imotorsPerSide),
+             0,
+             -iwheelbaseWidth.convert(meter) / 2,
+             1,
+             0}},
+      iwheelDiameter,
+      imass,
+      imomentOfInertia,
+      true) {
+}
+} // namespace okapi
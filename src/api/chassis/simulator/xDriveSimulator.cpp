@@ -0,0 +1,55 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/chassis/simulator/xDriveSimulator.hpp"
+
+namespace okapi {
+namespace {
+constexpr double diagonal = 0.70710678118654752; // sqrt(1/2)
+} // namespace
+
+XDriveSimulator::XDriveSimulator(const std::shared_ptr<SimulatedMotor> &itopLeftMotor,
+                                 const std::shared_ptr<SimulatedMotor> &itopRightMotor,
+                                 const std::shared_ptr<SimulatedMotor> &ibottomRightMotor,
+                                 const std::shared_ptr<SimulatedMotor> &ibottomLeftMotor,
+                                 const QLength iwheelDiameter,
+                                 const QLength iwheelbaseWidth,
+                                 const QLength iwheelbaseLength,
+                                 const QMass imass,
+                                 const double imomentOfInertia)
+  : ChassisSimulator(
+      // Forward on each motor pushes forward and diagonally, like XDriveModel::xArcade
+      {Wheel{itopLeftMotor,
+             1,
+             iwheelbaseLength.convert(meter) / 2,
+             iwheelbaseWidth.convert(meter) / 2,
+             diagonal,
+             -diagonal},
+       Wheel{itopRightMotor,
+             1,
+             iwheelbaseLength.convert(meter) / 2,
+             -iwheelbaseWidth.convert(meter) / 2,
+             diagonal,
+             diagonal},
+       Wheel{ibottomRightMotor,
+             1,
+             -iwheelbaseLength.convert(meter) / 2,
+             -iwheelbaseWidth.convert(meter) / 2,
+             diagonal,
+             -diagonal},
+       Wheel{ibottomLeftMotor,
+             1,
+             -iwheelbaseLength.convert(meter) / 2,
+             iwheelbaseWidth.convert(meter) / 2,
+             diagonal,
+             diagonal}},
+      iwheelDiameter,
+      imass,
+      imomentOfInertia,
+      false) {
+}
+} // namespace okapi
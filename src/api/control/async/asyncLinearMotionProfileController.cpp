@@ -6,6 +6,7 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/.
  */
 #include "okapi/api/control/async/asyncLinearMotionProfileController.hpp"
+#include <mutex>
 #include <numeric>
 
 namespace okapi {
@@ -32,6 +33,7 @@ AsyncLinearMotionProfileController::AsyncLinearMotionProfileController(
     maxJerk(other.maxJerk),
     output(std::move(other.output)),
     timeUtil(std::move(other.timeUtil)),
+    settings(other.getSettings()),
     currentPath(std::move(other.currentPath)),
     isRunning(other.isRunning.load(std::memory_order_acquire)),
     disabled(other.disabled.load(std::memory_order_acquire)),
@@ -199,13 +201,65 @@ void AsyncLinearMotionProfileController::loop() {
 
 void AsyncLinearMotionProfileController::executeSinglePath(const TrajectoryPair &path,
                                                            std::unique_ptr<AbstractRate> rate) {
+  const PathSettings pathSettings = getSettings();
+  const auto &positionInput = pathSettings.positionInput;
+  const auto &trackingCallback = pathSettings.trackingCallback;
+  const double startPosition = positionInput ? positionInput->controllerGet() : 0;
+
   for (int i = 0; i < path.length && !isDisabled(); ++i) {
-    currentProfilePosition = path.segment[i].position;
-    output->controllerSet(path.segment[i].velocity / maxVel);
+    const Segment &segment = path.segment[i];
+    currentProfilePosition = segment.position;
+
+    const double measuredPosition =
+      positionInput ? positionInput->controllerGet() - startPosition : 0;
+
+    double out;
+    if (pathSettings.useFeedforward) {
+      out = pathSettings.feedforward.calculate(segment.velocity,
+                                               segment.acceleration,
+                                               positionInput ? segment.position - measuredPosition
+                                                             : 0);
+    } else {
+      out = segment.velocity / maxVel;
+    }
+
+    output->controllerSet(out);
+
+    if (trackingCallback) {
+      trackingCallback(ProfileTrackingSample{
+        segment.position, segment.velocity, segment.acceleration, measuredPosition, out});
+    }
+
     rate->delayUntil(1_ms);
   }
 }
 
+void AsyncLinearMotionProfileController::setFeedforward(
+  const Feedforward::Gains &igains,
+  const std::shared_ptr<ControllerInput<double>> &iposition) {
+  std::lock_guard<CrossplatformMutex> lock(settingsMutex);
+  settings.feedforward = Feedforward(igains);
+  settings.positionInput = iposition;
+  settings.useFeedforward = true;
+}
+
+void AsyncLinearMotionProfileController::disableFeedforward() {
+  std::lock_guard<CrossplatformMutex> lock(settingsMutex);
+  settings.useFeedforward = false;
+}
+
+void AsyncLinearMotionProfileController::setTrackingCallback(
+  std::function<void(const ProfileTrackingSample &)> icallback) {
+  std::lock_guard<CrossplatformMutex> lock(settingsMutex);
+  settings.trackingCallback = std::move(icallback);
+}
+
+AsyncLinearMotionProfileController::PathSettings
+AsyncLinearMotionProfileController::getSettings() {
+  std::lock_guard<CrossplatformMutex> lock(settingsMutex);
+  return settings;
+}
+
 void AsyncLinearMotionProfileController::trampoline(void *context) {
   if (context) {
     static_cast<AsyncLinearMotionProfileController *>(context)->loop();
@@ -6,7 +6,12 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/.
  */
 #include "okapi/api/control/async/asyncMotionProfileController.hpp"
+#include "okapi/api/chassis/model/xDriveModel.hpp"
 #include "okapi/api/util/mathUtil.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <mutex>
 #include <numeric>
 
 namespace okapi {
@@ -46,6 +51,8 @@ AsyncMotionProfileController::AsyncMotionProfileController(
     scales(other.scales),
     pair(other.pair),
     timeUtil(std::move(other.timeUtil)),
+    settings(other.getSettings()),
+    useVelocityPlanning(other.useVelocityPlanning),
     currentPath(std::move(other.currentPath)),
     isRunning(other.isRunning.load(std::memory_order_acquire)),
     disabled(other.disabled.load(std::memory_order_acquire)),
@@ -57,8 +64,7 @@ AsyncMotionProfileController::~AsyncMotionProfileController() {
   dtorCalled.store(true, std::memory_order_release);
 
   for (auto &path : paths) {
-    free(path.second.left);
-    free(path.second.right);
+    freePath(path.second);
   }
 
   delete task;
@@ -66,11 +72,84 @@ AsyncMotionProfileController::~AsyncMotionProfileController() {
 
 void AsyncMotionProfileController::generatePath(std::initializer_list<Point> iwaypoints,
                                                 const std::string &ipathId) {
+  int length = 0;
+  Segment *trajectory = generateTrajectory(iwaypoints, length);
+  if (trajectory == nullptr) {
+    return;
+  }
+
+  if (useVelocityPlanning) {
+    trajectory = planVelocity(trajectory, length);
+  }
+
+  auto *leftTrajectory = (Segment *)malloc(sizeof(Segment) * length);
+  auto *rightTrajectory = (Segment *)malloc(sizeof(Segment) * length);
+
+  if (leftTrajectory == nullptr || rightTrajectory == nullptr) {
+    std::string message = "AsyncMotionProfileController: Could not allocate left and/or right "
+                          "trajectories. The path is probably impossible.";
+    logger->error(message);
+
+    if (leftTrajectory) {
+      free(leftTrajectory);
+    }
+
+    if (rightTrajectory) {
+      free(rightTrajectory);
+    }
+
+    if (trajectory) {
+      free(trajectory);
+    }
+
+    throw std::runtime_error(message);
+  }
+
+  logger->info("AsyncMotionProfileController: Modifying for tank drive");
+  pathfinder_modify_tank(
+    trajectory, length, leftTrajectory, rightTrajectory, scales.wheelbaseWidth.convert(meter));
+
+  free(trajectory);
+
+  // Free the old path before overwriting it
+  removePath(ipathId);
+
+  paths.emplace(ipathId, TrajectoryPair{leftTrajectory, rightTrajectory, length});
+  logger->info("AsyncMotionProfileController: Completely done generating path");
+  logger->info("AsyncMotionProfileController: " + std::to_string(length));
+}
+
+void AsyncMotionProfileController::generateHolonomicPath(std::initializer_list<Point> iwaypoints,
+                                                         const std::string &ipathId,
+                                                         const QAngle iheading) {
+  if (!std::dynamic_pointer_cast<XDriveModel>(model)) {
+    std::string message = "AsyncMotionProfileController: Holonomic paths need an XDriveModel.";
+    logger->error(message);
+    throw std::runtime_error(message);
+  }
+
+  int length = 0;
+  Segment *trajectory = generateTrajectory(iwaypoints, length);
+  if (trajectory == nullptr) {
+    return;
+  }
+
+  // Free the old path before overwriting it
+  removePath(ipathId);
+
+  paths.emplace(ipathId,
+                TrajectoryPair{trajectory, nullptr, length, true, iheading.convert(radian)});
+  logger->info("AsyncMotionProfileController: Completely done generating path");
+  logger->info("AsyncMotionProfileController: " + std::to_string(length));
+}
+
+Segment *AsyncMotionProfileController::generateTrajectory(std::initializer_list<Point> iwaypoints,
+                                                          int &olength) {
   if (iwaypoints.size() == 0) {
     // No point in generating a path
     logger->warn(
       "AsyncMotionProfileController: Not generating a path because no waypoints were given.");
-    return;
+    return nullptr;
   }
 
   std::vector<Waypoint> points;
@@ -141,48 +220,44 @@ void AsyncMotionProfileController::generatePath(std::initializer_list<Point> iwa
   logger->info("AsyncMotionProfileController: Generating path");
   pathfinder_generate(&candidate, trajectory);
 
-  auto *leftTrajectory = (Segment *)malloc(sizeof(Segment) * length);
-  auto *rightTrajectory = (Segment *)malloc(sizeof(Segment) * length);
-
-  if (leftTrajectory == nullptr || rightTrajectory == nullptr) {
-    std::string message = "AsyncMotionProfileController: Could not allocate left and/or right "
-                          "trajectories. The path is probably impossible.";
-    logger->error(message);
+  olength = length;
+  return trajectory;
+}
 
-    if (leftTrajectory) {
-      free(leftTrajectory);
-    }
+Segment *AsyncMotionProfileController::planVelocity(Segment *itrajectory, int &iolength) {
+  // The free speed of the wheels, from the free speed of the gearset
+  const double maxWheelVel = toUnderlyingType(pair.internalGearset) / pair.ratio / 60 * pi *
+                             scales.wheelDiameter.convert(meter);
+  const PathVelocityPlanner planner(
+    {maxVel, maxAccel, maxWheelVel, scales.wheelbaseWidth.convert(meter)}, 0.005);
 
-    if (rightTrajectory) {
-      free(rightTrajectory);
-    }
-
-    if (trajectory) {
-      free(trajectory);
-    }
+  logger->info("AsyncMotionProfileController: Planning velocity");
+  const auto planned = planner.plan(itrajectory, iolength, itrajectory[0].dt);
+  free(itrajectory);
 
+  auto *trajectory = static_cast<Segment *>(malloc(planned.size() * sizeof(Segment)));
+  if (trajectory == nullptr) {
+    std::string message = "AsyncMotionProfileController: Could not allocate planned trajectory. "
+                          "The path is probably impossible.";
+    logger->error(message);
     throw std::runtime_error(message);
   }
 
-  logger->info("AsyncMotionProfileController: Modifying for tank drive");
-  pathfinder_modify_tank(
-    trajectory, length, leftTrajectory, rightTrajectory, scales.wheelbaseWidth.convert(meter));
-
-  free(trajectory);
-
-  // Free the old path before overwriting it
-  removePath(ipathId);
+  std::copy(planned.begin(), planned.end(), trajectory);
+  iolength = static_cast<int>(planned.size());
+  return trajectory;
+}
 
-  paths.emplace(ipathId, TrajectoryPair{leftTrajectory, rightTrajectory, length});
-  logger->info("AsyncMotionProfileController: Completely done generating path");
-  logger->info("AsyncMotionProfileController: " + std::to_string(length));
+void AsyncMotionProfileController::freePath(const TrajectoryPair &path) {
+  // free() does nothing with nullptr
+  free(path.left);
+  free(path.right);
 }
 
 void AsyncMotionProfileController::removePath(const std::string &ipathId) {
   auto oldPath = paths.find(ipathId);
   if (oldPath != paths.end()) {
-    free(oldPath->second.left);
-    free(oldPath->second.right);
+    freePath(oldPath->second);
     paths.erase(ipathId);
   }
 }
@@ -246,19 +321,410 @@ void AsyncMotionProfileController::loop() {
 
 void AsyncMotionProfileController::executeSinglePath(const TrajectoryPair &path,
                                                      std::unique_ptr<AbstractRate> rate) {
+  const PathSettings pathSettings = getSettings();
+  const bool useFeedforward = pathSettings.useFeedforward;
+  const Feedforward &feedforward = pathSettings.feedforward;
+  const auto &trackingCallback = pathSettings.trackingCallback;
+
+  if (path.holonomic) {
+    executeHolonomicPath(path, *rate, pathSettings);
+    return;
+  }
+
+  if (pathSettings.poseInput) {
+    executeRamsetePath(path, *rate, pathSettings);
+    return;
+  }
+
+  if (pathSettings.useEncoderFollower) {
+    executeEncoderFollowerPath(path, *rate, pathSettings);
+    return;
+  }
+
   const auto reversed = direction.load(std::memory_order_acquire);
+  const bool needsMeasurement =
+    trackingCallback || (useFeedforward && feedforward.getGains().kP != 0);
+  const auto startPositions = needsMeasurement ? getMeasuredPositions() : std::make_pair(0.0, 0.0);
 
   for (int i = 0; i < path.length && !isDisabled(); ++i) {
-    const auto leftRPM = convertLinearToRotational(path.left[i].velocity * mps).convert(rpm);
-    const auto rightRPM = convertLinearToRotational(path.right[i].velocity * mps).convert(rpm);
+    const Segment &left = path.left[i];
+    const Segment &right = path.right[i];
+
+    double leftPosition = 0;
+    double rightPosition = 0;
+    if (needsMeasurement) {
+      const auto positions = getMeasuredPositions();
+      leftPosition = (positions.first - startPositions.first) * reversed;
+      rightPosition = (positions.second - startPositions.second) * reversed;
+    }
 
-    model->left(leftRPM / toUnderlyingType(pair.internalGearset) * reversed);
-    model->right(rightRPM / toUnderlyingType(pair.internalGearset) * reversed);
+    double leftOutput;
+    double rightOutput;
+    if (useFeedforward) {
+      // Work in the forward direction and flip the voltage at the end, so kS opposes the direction
+      // of travel
+      const double maxVoltage = model->getMaxVoltage();
+      leftOutput = std::clamp(
+        feedforward.calculate(left.velocity, left.acceleration, left.position - leftPosition) /
+          maxVoltage * reversed,
+        -1.0,
+        1.0);
+      rightOutput = std::clamp(
+        feedforward.calculate(right.velocity, right.acceleration, right.position - rightPosition) /
+          maxVoltage * reversed,
+        -1.0,
+        1.0);
+
+      model->tank(leftOutput, rightOutput);
+    } else {
+      const auto leftRPM = convertLinearToRotational(left.velocity * mps).convert(rpm);
+      const auto rightRPM = convertLinearToRotational(right.velocity * mps).convert(rpm);
+
+      leftOutput = leftRPM / toUnderlyingType(pair.internalGearset) * reversed;
+      rightOutput = rightRPM / toUnderlyingType(pair.internalGearset) * reversed;
+
+      model->left(leftOutput);
+      model->right(rightOutput);
+    }
+
+    if (trackingCallback) {
+      trackingCallback(
+        ProfileTrackingSample{
+          left.position, left.velocity, left.acceleration, leftPosition, leftOutput},
+        ProfileTrackingSample{
+          right.position, right.velocity, right.acceleration, rightPosition, rightOutput});
+    }
 
     rate->delayUntil(1_ms);
   }
 }
 
+void AsyncMotionProfileController::executeRamsetePath(const TrajectoryPair &path,
+                                                      AbstractRate &rate,
+                                                      const PathSettings &isettings) {
+  if (path.length <= 0) {
+    return;
+  }
+
+  const auto &trackingCallback = isettings.trackingCallback;
+  const auto &poseInput = isettings.poseInput;
+  const Ramsete &ramsete = isettings.ramsete;
+  const auto reversed = direction.load(std::memory_order_acquire);
+  const double halfWidth = scales.wheelbaseWidth.convert(meter) / 2;
+  const auto startPositions = trackingCallback ? getMeasuredPositions() : std::make_pair(0.0, 0.0);
+
+  // The path is followed relative to the pose at its start
+  const OdomState start = poseInput->controllerGet();
+  const double startX = start.x.convert(meter);
+  const double startY = start.y.convert(meter);
+  const double startTheta = start.theta.convert(radian);
+
+  const Segment &first = path.left[0];
+  const double firstX = (first.x + path.right[0].x) / 2;
+  const double firstY = (first.y + path.right[0].y) / 2;
+
+  for (int i = 0; i < path.length && !isDisabled(); ++i) {
+    const Segment &left = path.left[i];
+    const Segment &right = path.right[i];
+
+    // The center of the chassis relative to the start of the path. Driving backwards mirrors the
+    // path front to back.
+    const double dx = (left.x + right.x) / 2 - firstX;
+    const double dy = (left.y + right.y) / 2 - firstY;
+    const double pathX = (std::cos(first.heading) * dx + std::sin(first.heading) * dy) * reversed;
+    const double pathY = -std::sin(first.heading) * dx + std::cos(first.heading) * dy;
+    const double pathTheta = std::remainder(left.heading - first.heading, 2 * pi) * reversed;
+
+    const OdomState target{
+      (startX + std::cos(startTheta) * pathX - std::sin(startTheta) * pathY) * meter,
+      (startY + std::sin(startTheta) * pathX + std::cos(startTheta) * pathY) * meter,
+      (startTheta + pathTheta) * radian};
+
+    const double velocity = (left.velocity + right.velocity) / 2 * reversed;
+    const double angularVelocity =
+      i + 1 < path.length
+        ? std::remainder(path.left[i + 1].heading - left.heading, 2 * pi) / left.dt * reversed
+        : 0;
+
+    const auto command =
+      ramsete.calculate(poseInput->controllerGet(), target, velocity, angularVelocity);
+
+    const auto outputs =
+      writeVelocities(command.velocity - command.angularVelocity * halfWidth,
+                      command.velocity + command.angularVelocity * halfWidth,
+                      left.acceleration * reversed,
+                      right.acceleration * reversed,
+                      isettings);
+
+    if (trackingCallback) {
+      const auto positions = getMeasuredPositions();
+      trackingCallback(ProfileTrackingSample{left.position,
+                                             left.velocity,
+                                             left.acceleration,
+                                             (positions.first - startPositions.first) * reversed,
+                                             outputs.first},
+                       ProfileTrackingSample{right.position,
+                                             right.velocity,
+                                             right.acceleration,
+                                             (positions.second - startPositions.second) * reversed,
+                                             outputs.second});
+    }
+
+    rate.delayUntil(1_ms);
+  }
+}
+
+void AsyncMotionProfileController::executeEncoderFollowerPath(const TrajectoryPair &path,
+                                                              AbstractRate &rate,
+                                                              const PathSettings &isettings) {
+  if (path.length <= 0) {
+    return;
+  }
+
+  const auto &trackingCallback = isettings.trackingCallback;
+  const FollowerGains &followerGains = isettings.followerGains;
+  const auto &gyro = isettings.gyro;
+  const auto reversed = direction.load(std::memory_order_acquire);
+  const double gyroStart = gyro ? gyro->get() : 0;
+
+  std::int32_t sensors[2]{0, 0};
+  model->fillSensorVals(sensors, 2);
+
+  // The follower measures distance as ticks / ticks_per_revolution * wheel_circumference. The
+  // sensors measure motor degrees, so fold the gear ratio into the circumference. Work in the
+  // forward direction by flipping the sensors, then flip the outputs at the end.
+  const double circumference = scales.wheelDiameter.convert(meter) * pi / pair.ratio;
+  auto makeSide = [&](Segment *itrajectory, const std::int32_t isensor) {
+    return FollowerSide{EncoderConfig{isensor * reversed,
+                                      360,
+                                      circumference,
+                                      followerGains.kP,
+                                      0,
+                                      followerGains.kD,
+                                      followerGains.kV,
+                                      followerGains.kA},
+                        EncoderFollower{0, 0, 0, 0, 0},
+                        itrajectory};
+  };
+
+  FollowerSide leftSide = makeSide(path.left, sensors[0]);
+  FollowerSide rightSide = makeSide(path.right, sensors[1]);
+  const double startHeading = path.left[0].heading;
+
+  for (int i = 0; i < path.length && !isDisabled(); ++i) {
+    model->fillSensorVals(sensors, 2);
+    const double leftPower = pathfinder_follow_encoder(
+      leftSide.config, &leftSide.follower, leftSide.trajectory, path.length, sensors[0] * reversed);
+    const double rightPower = pathfinder_follow_encoder(rightSide.config,
+                                                        &rightSide.follower,
+                                                        rightSide.trajectory,
+                                                        path.length,
+                                                        sensors[1] * reversed);
+
+    // Turn towards the heading the path wants, relative to the start of the path. Driving
+    // backwards mirrors the path, which flips the heading.
+    double turn = 0;
+    if (gyro) {
+      const double targetHeading =
+        std::remainder(leftSide.follower.heading - startHeading, 2 * pi) * reversed * 180 / pi;
+      const double heading = (gyro->get() - gyroStart) / 10;
+      turn = followerGains.kTurn * std::remainder(targetHeading - heading, 360);
+    }
+
+    const double leftOutput = std::clamp(leftPower * reversed - turn, -1.0, 1.0);
+    const double rightOutput = std::clamp(rightPower * reversed + turn, -1.0, 1.0);
+    model->tank(leftOutput, rightOutput);
+
+    if (trackingCallback) {
+      const double metersPerTick = circumference / 360;
+      const Segment &left = path.left[i];
+      const Segment &right = path.right[i];
+      trackingCallback(
+        ProfileTrackingSample{left.position,
+                              left.velocity,
+                              left.acceleration,
+                              (sensors[0] * reversed - leftSide.config.initial_position) *
+                                metersPerTick,
+                              leftOutput},
+        ProfileTrackingSample{right.position,
+                              right.velocity,
+                              right.acceleration,
+                              (sensors[1] * reversed - rightSide.config.initial_position) *
+                                metersPerTick,
+                              rightOutput});
+    }
+
+    rate.delayUntil(1_ms);
+  }
+}
+
+void AsyncMotionProfileController::executeHolonomicPath(const TrajectoryPair &path,
+                                                        AbstractRate &rate,
+                                                        const PathSettings &isettings) {
+  const auto xModel = std::dynamic_pointer_cast<XDriveModel>(model);
+  if (path.length <= 0 || !xModel) {
+    return;
+  }
+
+  const bool useFeedforward = isettings.useFeedforward;
+  const auto &trackingCallback = isettings.trackingCallback;
+  const auto reversed = direction.load(std::memory_order_acquire);
+  const double maxVoltage = model->getMaxVoltage();
+  const double width = scales.wheelbaseWidth.convert(meter);
+  const double length = path.left[path.length - 1].position;
+  const double headingPerMeter = length > 0 ? path.endHeading / length : 0;
+
+  // The wheels in the order XDriveModel lists its motors. Each wheel drives the chassis forward
+  // and diagonally, so its speed is the forward speed plus or minus the speed to the right, plus
+  // or minus the speed from turning clockwise (the speed of a corner of the square chassis,
+  // projected onto the wheel).
+  constexpr std::array<double, 4> strafeSigns{1, -1, 1, -1};
+  constexpr std::array<double, 4> turnSigns{1, -1, -1, 1};
+
+  std::array<double, 4> lastVelocities{0, 0, 0, 0};
+  std::array<double, 4> accelerations{0, 0, 0, 0};
+  std::array<double, 4> targetPositions{0, 0, 0, 0};
+  std::array<double, 4> outputs{0, 0, 0, 0};
+  const auto startPositions = trackingCallback ? getMeasuredPositions() : std::make_pair(0.0, 0.0);
+
+  for (int i = 0; i < path.length && !isDisabled(); ++i) {
+    const Segment &segment = path.left[i];
+
+    // The direction of travel relative to the chassis. Driving backwards mirrors the path, which
+    // flips the forward speed and the turning.
+    const double travelAngle = segment.heading - segment.position * headingPerMeter;
+    const double forwardSpeed = segment.velocity * std::cos(travelAngle) * reversed;
+    const double rightSpeed = -segment.velocity * std::sin(travelAngle);
+    const double clockwiseSpeed = -segment.velocity * headingPerMeter * width * reversed;
+
+    for (std::size_t wheel = 0; wheel < 4; ++wheel) {
+      const double velocity = forwardSpeed + strafeSigns[wheel] * rightSpeed +
+                              turnSigns[wheel] * clockwiseSpeed;
+
+      const double acceleration = (velocity - lastVelocities[wheel]) / segment.dt;
+      if (useFeedforward) {
+        outputs[wheel] = isettings.feedforward.calculate(velocity, acceleration) / maxVoltage;
+      } else {
+        outputs[wheel] = convertLinearToRotational(velocity * mps).convert(rpm) /
+                         toUnderlyingType(pair.internalGearset);
+      }
+
+      lastVelocities[wheel] = velocity;
+      accelerations[wheel] = acceleration;
+      targetPositions[wheel] += velocity * segment.dt;
+    }
+
+    // Outputs out of [-1, 1] are scaled down together, which keeps the chassis on the path
+    xModel->setWheelCommands(outputs,
+                             useFeedforward ? XDriveModel::commandMode::voltage
+                                            : XDriveModel::commandMode::velocity);
+
+    if (trackingCallback) {
+      const auto positions = getMeasuredPositions();
+      trackingCallback(ProfileTrackingSample{targetPositions[0],
+                                             lastVelocities[0],
+                                             accelerations[0],
+                                             positions.first - startPositions.first,
+                                             outputs[0]},
+                       ProfileTrackingSample{targetPositions[1],
+                                             lastVelocities[1],
+                                             accelerations[1],
+                                             positions.second - startPositions.second,
+                                             outputs[1]});
+    }
+
+    rate.delayUntil(1_ms);
+  }
+}
+
+std::pair<double, double>
+AsyncMotionProfileController::writeVelocities(const double ileftVelocity,
+                                              const double irightVelocity,
+                                              const double ileftAcceleration,
+                                              const double irightAcceleration,
+                                              const PathSettings &isettings) {
+  if (isettings.useFeedforward) {
+    const Feedforward &feedforward = isettings.feedforward;
+    const double maxVoltage = model->getMaxVoltage();
+    const double leftOutput =
+      std::clamp(feedforward.calculate(ileftVelocity, ileftAcceleration) / maxVoltage, -1.0, 1.0);
+    const double rightOutput = std::clamp(
+      feedforward.calculate(irightVelocity, irightAcceleration) / maxVoltage, -1.0, 1.0);
+
+    model->tank(leftOutput, rightOutput);
+    return {leftOutput, rightOutput};
+  }
+
+  const double gearsetRPM = toUnderlyingType(pair.internalGearset);
+  const double leftOutput =
+    convertLinearToRotational(ileftVelocity * mps).convert(rpm) / gearsetRPM;
+  const double rightOutput =
+    convertLinearToRotational(irightVelocity * mps).convert(rpm) / gearsetRPM;
+
+  model->left(leftOutput);
+  model->right(rightOutput);
+  return {leftOutput, rightOutput};
+}
+
+std::pair<double, double> AsyncMotionProfileController::getMeasuredPositions() const {
+  std::int32_t sensorVals[2]{0, 0};
+  model->fillSensorVals(sensorVals, 2);
+  const double degreesPerMeter = scales.straight * pair.ratio;
+  return {sensorVals[0] / degreesPerMeter, sensorVals[1] / degreesPerMeter};
+}
+
+void AsyncMotionProfileController::setFeedforward(const Feedforward::Gains &igains) {
+  std::lock_guard<CrossplatformMutex> lock(settingsMutex);
+  settings.feedforward = Feedforward(igains);
+  settings.useFeedforward = true;
+}
+
+void AsyncMotionProfileController::disableFeedforward() {
+  std::lock_guard<CrossplatformMutex> lock(settingsMutex);
+  settings.useFeedforward = false;
+}
+
+void AsyncMotionProfileController::setRamsete(
+  const std::shared_ptr<ControllerInput<OdomState>> &iposeInput, const Ramsete::Gains &igains) {
+  std::lock_guard<CrossplatformMutex> lock(settingsMutex);
+  settings.ramsete = Ramsete(igains);
+  settings.poseInput = iposeInput;
+}
+
+void AsyncMotionProfileController::disableRamsete() {
+  std::lock_guard<CrossplatformMutex> lock(settingsMutex);
+  settings.poseInput = nullptr;
+}
+
+void AsyncMotionProfileController::setEncoderFollower(
+  const FollowerGains &igains, const std::shared_ptr<ContinuousRotarySensor> &igyro) {
+  std::lock_guard<CrossplatformMutex> lock(settingsMutex);
+  settings.followerGains = igains;
+  settings.gyro = igyro;
+  settings.useEncoderFollower = true;
+}
+
+void AsyncMotionProfileController::disableEncoderFollower() {
+  std::lock_guard<CrossplatformMutex> lock(settingsMutex);
+  settings.useEncoderFollower = false;
+  settings.gyro = nullptr;
+}
+
+void AsyncMotionProfileController::setVelocityPlanning(const bool ienabled) {
+  useVelocityPlanning = ienabled;
+}
+
+void AsyncMotionProfileController::setTrackingCallback(
+  std::function<void(const ProfileTrackingSample &, const ProfileTrackingSample &)> icallback) {
+  std::lock_guard<CrossplatformMutex> lock(settingsMutex);
+  settings.trackingCallback = std::move(icallback);
+}
+
+AsyncMotionProfileController::PathSettings AsyncMotionProfileController::getSettings() {
+  std::lock_guard<CrossplatformMutex> lock(settingsMutex);
+  return settings;
+}
+
 QAngularSpeed AsyncMotionProfileController::convertLinearToRotational(QSpeed linear) const {
   return (linear * (360_deg / (scales.wheelDiameter * 1_pi))) * pair.ratio;
 }
@@ -0,0 +1,160 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/iterative/iterativeGainScheduledPosPidController.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace okapi {
+IterativeGainScheduledPosPIDController::IterativeGainScheduledPosPIDController(
+  const std::vector<Breakpoint> &ischedule,
+  std::shared_ptr<ControllerInput<double>> ischeduleInput,
+  const TimeUtil &itimeUtil,
+  std::unique_ptr<Filter> iderivativeFilter)
+  : IterativePosPIDController(firstGains(ischedule), itimeUtil, std::move(iderivativeFilter)),
+    scheduleInput(std::move(ischeduleInput)) {
+  for (const auto &breakpoint : sortSchedule(ischedule)) {
+    keys.push_back(breakpoint.scheduleValue);
+    gains.push_back(breakpoint.gains);
+  }
+
+  computeSegments();
+}
+
+const IterativePosPIDController::Gains &
+IterativeGainScheduledPosPIDController::firstGains(const std::vector<Breakpoint> &ischedule) {
+  if (ischedule.empty()) {
+    Logger::instance()->error(
+      "IterativeGainScheduledPosPIDController: The gain schedule must not be empty.");
+    throw std::invalid_argument(
+      "IterativeGainScheduledPosPIDController: The gain schedule must not be empty.");
+  }
+
+  return std::min_element(ischedule.begin(),
+                          ischedule.end(),
+                          [](const Breakpoint &a, const Breakpoint &b) {
+                            return a.scheduleValue < b.scheduleValue;
+                          })
+    ->gains;
+}
+
+std::vector<IterativeGainScheduledPosPIDController::Breakpoint>
+IterativeGainScheduledPosPIDController::sortSchedule(const std::vector<Breakpoint> &ischedule) {
+  std::vector<Breakpoint> sorted(ischedule);
+  std::sort(sorted.begin(), sorted.end(), [](const Breakpoint &a, const Breakpoint &b) {
+    return a.scheduleValue < b.scheduleValue;
+  });
+
+  for (std::size_t i = 1; i < sorted.size(); i++) {
+    if (sorted[i].scheduleValue == sorted[i - 1].scheduleValue) {
+      Logger::instance()->error(
+        "IterativeGainScheduledPosPIDController: Duplicate schedule value " +
+        std::to_string(sorted[i].scheduleValue) + ".");
+      throw std::invalid_argument(
+        "IterativeGainScheduledPosPIDController: Duplicate schedule value " +
+        std::to_string(sorted[i].scheduleValue) + ".");
+    }
+  }
+
+  return sorted;
+}
+
+void IterativeGainScheduledPosPIDController::computeSegments() {
+  // Scale the integral and derivative gains the same way setGains() does
+  const double sampleTimeSec = sampleTime.convert(second);
+
+  segments.clear();
+  segments.reserve(gains.size());
+
+  for (std::size_t i = 0; i < gains.size(); i++) {
+    const Gains &g = gains[i];
+    Segment segment{g.kP, g.kI * sampleTimeSec, g.kD / sampleTimeSec, g.kBias, 0, 0, 0, 0};
+
+    if (i + 1 < gains.size()) {
+      const Gains &next = gains[i + 1];
+      const double width = keys[i + 1] - keys[i];
+      segment.dkP = (next.kP - g.kP) / width;
+      segment.dkI = (next.kI - g.kI) * sampleTimeSec / width;
+      segment.dkD = (next.kD - g.kD) / sampleTimeSec / width;
+      segment.dkBias = (next.kBias - g.kBias) / width;
+    }
+
+    segments.push_back(segment);
+  }
+}
+
+std::size_t IterativeGainScheduledPosPIDController::findSegment(const double ischeduleValue) {
+  const std::size_t last = keys.size() - 1;
+  if (lastSegment < last && keys[lastSegment] <= ischeduleValue &&
+      ischeduleValue < keys[lastSegment + 1]) {
+    return lastSegment;
+  }
+
+  const auto upper = std::upper_bound(keys.begin(), keys.end(), ischeduleValue);
+  lastSegment = upper == keys.begin() ? 0 : std::min<std::size_t>(upper - keys.begin() - 1, last);
+  return lastSegment;
+}
+
+void IterativeGainScheduledPosPIDController::updateGains(const double ischeduleValue) {
+  const double value = std::clamp(ischeduleValue, keys.front(), keys.back());
+  const Segment &segment = segments[findSegment(value)];
+  const double offset = value - keys[lastSegment];
+
+  const double newKP = segment.kP + segment.dkP * offset;
+  const double newKI = segment.kI + segment.dkI * offset;
+  const double newKD = segment.kD + segment.dkD * offset;
+  const double newKBias = segment.kBias + segment.dkBias * offset;
+
+  if (bumpless && newKI != 0) {
+    // The integral is accumulated with the gain already applied, so changing kI does not bump the
+    // output. Move the change in the other terms into the integral so the output computed from the
+    // last error is the same with the old and new gains. The integral term then winds the
+    // difference back out, which it cannot do without an integral gain.
+    integral += (kP - newKP) * error - (kD - newKD) * derivative + (kBias - newKBias);
+    integral = std::clamp(integral, integralMin, integralMax);
+  }
+
+  kP = newKP;
+  kI = newKI;
+  kD = newKD;
+  kBias = newKBias;
+}
+
+IterativePosPIDController::Gains
+IterativeGainScheduledPosPIDController::getGains(const double ischeduleValue) const {
+  const double value = std::clamp(ischeduleValue, keys.front(), keys.back());
+  const auto upper = std::upper_bound(keys.begin(), keys.end(), value);
+  const std::size_t i =
+    upper == keys.begin() ? 0 : std::min<std::size_t>(upper - keys.begin() - 1, keys.size() - 1);
+
+  if (i + 1 == keys.size()) {
+    return gains[i];
+  }
+
+  const double t = (value - keys[i]) / (keys[i + 1] - keys[i]);
+  const Gains &a = gains[i];
+  const Gains &b = gains[i + 1];
+  return {a.kP + (b.kP - a.kP) * t,
+          a.kI + (b.kI - a.kI) * t,
+          a.kD + (b.kD - a.kD) * t,
+          a.kBias + (b.kBias - a.kBias) * t};
+}
+
+void IterativeGainScheduledPosPIDController::stepImpl(const double inewReading) {
+  updateGains(scheduleInput->controllerGet());
+  IterativePosPIDController::stepImpl(inewReading);
+}
+
+void IterativeGainScheduledPosPIDController::setSampleTime(const QTime isampleTime) {
+  IterativePosPIDController::setSampleTime(isampleTime);
+  computeSegments();
+}
+
+void IterativeGainScheduledPosPIDController::setBumplessTransfer(const bool ibumpless) {
+  bumpless = ibumpless;
+}
+} // namespace okapi
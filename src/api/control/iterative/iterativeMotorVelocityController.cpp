@@ -19,6 +19,11 @@ double IterativeMotorVelocityController::step(const double ireading) {
   return controller->getOutput();
 }
 
+double IterativeMotorVelocityController::step(const double ireading, const QTime inow) {
+  motor->controllerSet(controller->step(ireading, inow));
+  return controller->getOutput();
+}
+
 void IterativeMotorVelocityController::setTarget(const double itarget) {
   controller->setTarget(itarget);
 }
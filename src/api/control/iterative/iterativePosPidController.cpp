@@ -123,35 +123,53 @@ double IterativePosPIDController::step(const double inewReading) {
     loopDtTimer->placeHardMark();
 
     if (loopDtTimer->getDtFromHardMark() >= sampleTime) {
-      const double readingDiff = inewReading - lastReading;
-      lastReading = inewReading;
+      stepImpl(inewReading);
+      loopDtTimer->clearHardMark(); // Important that we only clear if dt >= sampleTime
 
-      error = getError();
+      settledUtil->isSettled(error);
+    }
+  }
 
-      if ((std::abs(error) < target - errorSumMin && std::abs(error) > target - errorSumMax) ||
-          (std::abs(error) > target + errorSumMin && std::abs(error) < target + errorSumMax)) {
-        integral += kI * error; // Eliminate integral kick while realtime tuning
-      }
+  return output;
+}
 
-      if (shouldResetOnCross && std::copysign(1.0, error) != std::copysign(1.0, lastError)) {
-        integral = 0;
-      }
+double IterativePosPIDController::step(const double inewReading, const QTime inow) {
+  if (controllerIsDisabled) {
+    return 0;
+  } else if (!hasLastStepTime || inow - lastStepTime >= sampleTime - timestampEpsilon) {
+    stepImpl(inewReading);
+    lastStepTime = inow;
+    hasLastStepTime = true;
 
-      integral = std::clamp(integral, integralMin, integralMax);
+    settledUtil->isSettled(error, inow);
+  }
 
-      // Derivative over measurement to eliminate derivative kick on setpoint change
-      derivative = derivativeFilter->filter(readingDiff);
+  return output;
+}
 
-      output = std::clamp(kP * error + integral - kD * derivative + kBias, outputMin, outputMax);
+void IterativePosPIDController::stepImpl(const double inewReading) {
+  const double readingDiff = inewReading - lastReading;
+  lastReading = inewReading;
 
-      lastError = error;
-      loopDtTimer->clearHardMark(); // Important that we only clear if dt >= sampleTime
+  error = getError();
 
-      settledUtil->isSettled(error);
-    }
+  if ((std::abs(error) < target - errorSumMin && std::abs(error) > target - errorSumMax) ||
+      (std::abs(error) > target + errorSumMin && std::abs(error) < target + errorSumMax)) {
+    integral += kI * error; // Eliminate integral kick while realtime tuning
   }
 
-  return output;
+  if (shouldResetOnCross && std::copysign(1.0, error) != std::copysign(1.0, lastError)) {
+    integral = 0;
+  }
+
+  integral = std::clamp(integral, integralMin, integralMax);
+
+  // Derivative over measurement to eliminate derivative kick on setpoint change
+  derivative = derivativeFilter->filter(readingDiff);
+
+  output = std::clamp(kP * error + integral - kD * derivative + kBias, outputMin, outputMax);
+
+  lastError = error;
 }
 
 void IterativePosPIDController::setGains(const double ikP,
@@ -172,6 +190,7 @@ void IterativePosPIDController::reset() {
   lastReading = 0;
   integral = 0;
   output = 0;
+  hasLastStepTime = false;
   settledUtil->reset();
 }
 
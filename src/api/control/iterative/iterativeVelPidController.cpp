@@ -62,26 +62,41 @@ QAngularSpeed IterativeVelPIDController::stepVel(const double inewReading) {
   return velMath->step(inewReading);
 }
 
+QAngularSpeed IterativeVelPIDController::stepVel(const double inewReading, const QTime inow) {
+  return velMath->step(inewReading, inow);
+}
+
 double IterativeVelPIDController::step(const double inewReading) {
   if (!controllerIsDisabled) {
     loopDtTimer->placeHardMark();
 
     if (loopDtTimer->getDtFromHardMark() >= sampleTime) {
-      if (loopDtTimer->getDtFromHardMark() >= sampleTime) {
-        stepVel(inewReading);
-      }
+      stepVel(inewReading);
+      stepImpl();
 
-      error = getError();
+      loopDtTimer->clearHardMark(); // Important that we only clear if dt >= sampleTime
 
-      // Derivative over measurement to eliminate derivative kick on setpoint change
-      derivative = derivativeFilter->filter(velMath->getAccel().getValue());
+      settledUtil->isSettled(error);
+    }
 
-      outputSum += kP * error - kD * derivative;
-      outputSum = std::clamp(outputSum, outputMin, outputMax);
+    output =
+      std::clamp(outputSum + kF * target + kSF * std::copysign(1.0, target), outputMin, outputMax);
+    return output;
+  }
 
-      loopDtTimer->clearHardMark(); // Important that we only clear if dt >= sampleTime
+  return 0; // Can't set output to zero because the entire loop in an integral
+}
 
-      settledUtil->isSettled(error);
+double IterativeVelPIDController::step(const double inewReading, const QTime inow) {
+  if (!controllerIsDisabled) {
+    if (!hasLastStepTime || inow - lastStepTime >= sampleTime - timestampEpsilon) {
+      stepVel(inewReading, inow);
+      stepImpl();
+
+      lastStepTime = inow;
+      hasLastStepTime = true;
+
+      settledUtil->isSettled(error, inow);
     }
 
     output =
@@ -92,6 +107,34 @@ double IterativeVelPIDController::step(const double inewReading) {
   return 0; // Can't set output to zero because the entire loop in an integral
 }
 
+double IterativeVelPIDController::step(AbstractMotor &imotor) {
+  if (!controllerIsDisabled) {
+    bool newVelocity = false;
+    velMath->step(imotor, &newVelocity);
+
+    if (newVelocity) {
+      stepImpl();
+      settledUtil->isSettled(error, velMath->getLastSampleTime());
+    }
+
+    output =
+      std::clamp(outputSum + kF * target + kSF * std::copysign(1.0, target), outputMin, outputMax);
+    return output;
+  }
+
+  return 0; // Can't set output to zero because the entire loop in an integral
+}
+
+void IterativeVelPIDController::stepImpl() {
+  error = getError();
+
+  // Derivative over measurement to eliminate derivative kick on setpoint change
+  derivative = derivativeFilter->filter(velMath->getAccel().getValue());
+
+  outputSum += kP * error - kD * derivative;
+  outputSum = std::clamp(outputSum, outputMin, outputMax);
+}
+
 void IterativeVelPIDController::setTarget(const double itarget) {
   logger->info("IterativeVelPIDController: Set target to " + std::to_string(itarget));
   target = itarget;
@@ -130,6 +173,7 @@ void IterativeVelPIDController::reset() {
   error = 0;
   outputSum = 0;
   output = 0;
+  hasLastStepTime = false;
   settledUtil->reset();
 }
 
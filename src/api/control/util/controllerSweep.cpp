@@ -0,0 +1,244 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/controllerSweep.hpp"
+#include "okapi/api/util/mathUtil.hpp"
+#include "okapi/api/util/parallelFor.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+namespace okapi {
+ControllerSweep::Distribution ControllerSweep::Distribution::constant(const double ivalue) {
+  return Distribution{Type::constant, ivalue, 0};
+}
+
+ControllerSweep::Distribution ControllerSweep::Distribution::uniform(const double imin,
+                                                                     const double imax) {
+  return Distribution{Type::uniform, imin, imax};
+}
+
+ControllerSweep::Distribution ControllerSweep::Distribution::normal(const double imean,
+                                                                    const double istddev) {
+  return Distribution{Type::normal, imean, istddev};
+}
+
+ControllerSweep::ControllerSweep(
+  const Supplier<std::unique_ptr<FlywheelSimulator>> &isimulatorSupplier,
+  const Supplier<std::unique_ptr<IterativePosPIDController>> &icontrollerSupplier,
+  const TimeUtil &itimeUtil,
+  const double itarget,
+  const QTime itimeout,
+  const QTime iloopDelta,
+  const std::size_t inumThreads)
+  : logger(Logger::instance()),
+    gen(std::random_device()()),
+    simulatorSupplier(isimulatorSupplier),
+    controllerSupplier(icontrollerSupplier),
+    timeUtil(itimeUtil),
+    rate(itimeUtil.getRate()),
+    target(itarget),
+    timeout(itimeout),
+    loopDelta(iloopDelta),
+    numThreads(std::max<std::size_t>(inumThreads, 1)) {
+  // Hold every parameter at the value the simulators are made with until it is swept
+  const auto simulator = simulatorSupplier.get();
+  distributions[static_cast<std::size_t>(Parameter::batteryVoltage)] =
+    Distribution::constant(nominalVoltage);
+  distributions[static_cast<std::size_t>(Parameter::mass)] =
+    Distribution::constant(simulator->getMass());
+  distributions[static_cast<std::size_t>(Parameter::muStatic)] =
+    Distribution::constant(simulator->getStaticFriction());
+  distributions[static_cast<std::size_t>(Parameter::muDynamic)] =
+    Distribution::constant(simulator->getDynamicFriction());
+}
+
+ControllerSweep::~ControllerSweep() = default;
+
+void ControllerSweep::setDistribution(const Parameter iparameter,
+                                      const Distribution &idistribution) {
+  if (idistribution.type == Distribution::Type::uniform && idistribution.a > idistribution.b) {
+    const std::string msg = "ControllerSweep: The minimum of a uniform distribution must not be "
+                            "greater than its maximum.";
+    logger->error(msg);
+    throw std::invalid_argument(msg);
+  }
+
+  if (idistribution.type == Distribution::Type::normal && idistribution.b < 0) {
+    const std::string msg =
+      "ControllerSweep: The standard deviation of a normal distribution must not be negative.";
+    logger->error(msg);
+    throw std::invalid_argument(msg);
+  }
+
+  distributions[static_cast<std::size_t>(iparameter)] = idistribution;
+}
+
+void ControllerSweep::setSeed(const std::uint32_t iseed) {
+  gen.seed(iseed);
+}
+
+std::vector<ControllerSweep::Trial> ControllerSweep::run(const std::size_t inumTrials) {
+  // Sample every trial up front so the results do not depend on which thread runs which trial
+  std::vector<Trial> trials(inumTrials);
+  for (auto &trial : trials) {
+    for (std::size_t i = 0; i < numParameters; i++) {
+      const auto &distribution = distributions[i];
+      double value = distribution.a;
+
+      if (distribution.type == Distribution::Type::uniform) {
+        value = std::uniform_real_distribution<double>(distribution.a, distribution.b)(gen);
+      } else if (distribution.type == Distribution::Type::normal && distribution.b > 0) {
+        value = std::normal_distribution<double>(distribution.a, distribution.b)(gen);
+      }
+
+      trial.parameters[i] = std::max(value, 0.0);
+    }
+  }
+
+  parallelFor(
+    trials.size(), numThreads, [&](const std::size_t i) { runTrial(trials.at(i)); }, *rate);
+
+  return trials;
+}
+
+void ControllerSweep::runTrial(Trial &itrial) {
+  const auto parameter = [&](const Parameter iparameter) {
+    return itrial.parameters[static_cast<std::size_t>(iparameter)];
+  };
+
+  auto simulator = simulatorSupplier.get();
+  simulator->setMass(parameter(Parameter::mass));
+  simulator->setMomentOfInertia(parameter(Parameter::mass) * ipow(simulator->getLinkLength(), 2));
+  simulator->setStaticFriction(parameter(Parameter::muStatic));
+  simulator->setDynamicFriction(parameter(Parameter::muDynamic));
+  const double torqueScale =
+    std::min(parameter(Parameter::batteryVoltage) / nominalVoltage, 1.0) *
+    simulator->getMaxTorque();
+
+  auto controller = controllerSupplier.get();
+  controller->setTarget(target);
+  auto settledUtil = timeUtil.getSettledUtil();
+
+  const double startAngle = simulator->getAngle() * radianToDegree;
+  const long substeps =
+    std::max(1L, std::lround(loopDelta.convert(second) / simulator->getTimestep()));
+  const double direction = target < 0 ? -1 : 1;
+
+  QTime time = 0_ms;
+  double overshoot = 0;
+  double itae = 0;
+  bool isSettled = false;
+  while (!isSettled) {
+    time += loopDelta;
+    if (time > timeout) {
+      time = timeout;
+      break;
+    }
+
+    const double position = simulator->getAngle() * radianToDegree - startAngle;
+    overshoot = std::max(overshoot, (position - target) * direction);
+
+    const double output = controller->step(position, time);
+    const double error = controller->getError();
+    itae += time.convert(second) * std::abs(error) * loopDelta.convert(second);
+
+    for (long i = 0; i < substeps; i++) {
+      simulator->step(output * torqueScale);
+    }
+
+    isSettled = settledUtil->isSettled(error, time);
+  }
+
+  itrial.settled = isSettled;
+  itrial.settleTime = time;
+  itrial.overshoot = overshoot;
+  itrial.itae = itae;
+}
+
+std::vector<ControllerSweep::Bucket> ControllerSweep::summarize(const std::vector<Trial> &itrials,
+                                                                const Parameter iparameter,
+                                                                const std::size_t inumBuckets) {
+  if (inumBuckets == 0) {
+    const std::string msg = "ControllerSweep: The number of buckets must be greater than zero.";
+    Logger::instance()->error(msg);
+    throw std::invalid_argument(msg);
+  }
+
+  const auto index = static_cast<std::size_t>(iparameter);
+  double lower = 0;
+  double upper = 0;
+  if (!itrials.empty()) {
+    const auto [min, max] = std::minmax_element(
+      itrials.begin(), itrials.end(), [&](const Trial &ia, const Trial &ib) {
+        return ia.parameters[index] < ib.parameters[index];
+      });
+    lower = min->parameters[index];
+    upper = max->parameters[index];
+  }
+
+  const double width = (upper - lower) / inumBuckets;
+  std::vector<std::vector<const Trial *>> members(inumBuckets);
+  for (const auto &trial : itrials) {
+    const double offset = width > 0 ? (trial.parameters[index] - lower) / width : 0;
+    members[std::min(static_cast<std::size_t>(offset), inumBuckets - 1)].push_back(&trial);
+  }
+
+  std::vector<Bucket> buckets;
+  buckets.reserve(inumBuckets);
+  for (std::size_t i = 0; i < inumBuckets; i++) {
+    std::vector<double> settleTimes, overshoots, itaes;
+    for (const auto *trial : members[i]) {
+      if (trial->settled) {
+        settleTimes.push_back(trial->settleTime.convert(second));
+      }
+      overshoots.push_back(trial->overshoot);
+      itaes.push_back(trial->itae);
+    }
+
+    const std::size_t count = members[i].size();
+    buckets.push_back(Bucket{lower + width * i,
+                             lower + width * (i + 1),
+                             count,
+                             count > 0 ? static_cast<double>(settleTimes.size()) / count : 0,
+                             computeStatistics(std::move(settleTimes)),
+                             computeStatistics(std::move(overshoots)),
+                             computeStatistics(std::move(itaes))});
+  }
+
+  return buckets;
+}
+
+ControllerSweep::Statistics ControllerSweep::computeStatistics(std::vector<double> ivalues) {
+  if (ivalues.empty()) {
+    return Statistics{0, 0, 0, 0, 0, 0};
+  }
+
+  std::sort(ivalues.begin(), ivalues.end());
+  const std::size_t n = ivalues.size();
+
+  const double mean = std::accumulate(ivalues.begin(), ivalues.end(), 0.0) / n;
+  double variance = 0;
+  for (const double value : ivalues) {
+    variance += ipow(value - mean, 2);
+  }
+
+  const double median =
+    n % 2 == 1 ? ivalues[n / 2] : (ivalues[n / 2 - 1] + ivalues[n / 2]) / 2;
+
+  // Nearest-rank percentile
+  const auto p95Rank = static_cast<std::size_t>(std::ceil(0.95 * n));
+
+  return Statistics{mean,
+                    std::sqrt(variance / n),
+                    ivalues.front(),
+                    median,
+                    ivalues[std::max<std::size_t>(p95Rank, 1) - 1],
+                    ivalues.back()};
+}
+} // namespace okapi
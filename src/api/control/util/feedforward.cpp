@@ -0,0 +1,78 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/feedforward.hpp"
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace okapi {
+Feedforward::Feedforward(const Gains &igains) : gains(igains) {
+}
+
+double Feedforward::calculate(const double ivelocity,
+                              const double iacceleration,
+                              const double ipositionError) const {
+  const double sign = ivelocity > 0 ? 1 : (ivelocity < 0 ? -1 : 0);
+  return gains.kS * sign + gains.kV * ivelocity + gains.kA * iacceleration +
+         gains.kP * ipositionError;
+}
+
+const Feedforward::Gains &Feedforward::getGains() const {
+  return gains;
+}
+
+Feedforward::Gains Feedforward::characterize(const std::vector<Sample> &isamples) {
+  // Build the normal equations (X^T X) b = X^T y with X = [sgn(v), v, a]
+  std::array<std::array<double, 4>, 3> system{};
+  for (const auto &sample : isamples) {
+    const double sign = sample.velocity > 0 ? 1 : (sample.velocity < 0 ? -1 : 0);
+    const std::array<double, 3> row{sign, sample.velocity, sample.acceleration};
+
+    for (std::size_t i = 0; i < 3; i++) {
+      for (std::size_t j = 0; j < 3; j++) {
+        system[i][j] += row[i] * row[j];
+      }
+      system[i][3] += row[i] * sample.output;
+    }
+  }
+
+  // Gaussian elimination with partial pivoting
+  for (std::size_t col = 0; col < 3; col++) {
+    std::size_t pivot = col;
+    for (std::size_t row = col + 1; row < 3; row++) {
+      if (std::abs(system[row][col]) > std::abs(system[pivot][col])) {
+        pivot = row;
+      }
+    }
+
+    if (std::abs(system[pivot][col]) < 1e-12) {
+      Logger::instance()->error("Feedforward: Not enough varied samples to characterize the "
+                                "mechanism. Include samples at different velocities and "
+                                "accelerations.");
+      throw std::invalid_argument("Feedforward: Not enough varied samples to characterize the "
+                                  "mechanism. Include samples at different velocities and "
+                                  "accelerations.");
+    }
+
+    std::swap(system[col], system[pivot]);
+
+    for (std::size_t row = 0; row < 3; row++) {
+      if (row != col) {
+        const double factor = system[row][col] / system[col][col];
+        for (std::size_t k = col; k < 4; k++) {
+          system[row][k] -= factor * system[col][k];
+        }
+      }
+    }
+  }
+
+  return Gains{
+    system[0][3] / system[0][0], system[1][3] / system[1][1], system[2][3] / system[2][2]};
+}
+} // namespace okapi
@@ -9,6 +9,7 @@
 
 #include "okapi/api/control/util/flywheelSimulator.hpp"
 #include "okapi/api/util/mathUtil.hpp"
+#include <algorithm>
 #include <cmath>
 #include <utility>
 
@@ -41,38 +42,88 @@ double FlywheelSimulator::step(const double itorque) {
 }
 
 double FlywheelSimulator::stepImpl() {
-  double torqueTotal = inputTorque + torqueFunc(angle, mass, linkLen);
+  const double dt = timestep / substeps;
 
-  if (omega == 0 && muStatic > std::fabs(torqueTotal)) {
-    torqueTotal = 0;
-  }
+  for (std::size_t i = 0; i < substeps; i++) {
+    switch (integrator) {
+    case Integrator::explicitEuler:
+      explicitEulerStep(dt);
+      break;
 
-  if (omega != 0) {
-    if (torqueTotal > 0) {
-      torqueTotal -= muDynamic * omega;
-    } else {
-      torqueTotal += muDynamic * omega * -1;
+    case Integrator::semiImplicitEuler:
+      semiImplicitEulerStep(dt);
+      break;
+
+    case Integrator::rk4:
+      rk4Step(dt);
+      break;
+    }
+
+    if (radianToDegree * angle > 181) {
+      angle = pi;
+      omega = 0;
+    }
+
+    if (radianToDegree * angle < -1) {
+      angle = 0;
+      omega = 0;
     }
   }
 
-  accel = torqueTotal / I;
-  omega += accel * ipow(timestep, 2);
+  return angle;
+}
+
+double FlywheelSimulator::computeAcceleration(const double iangle, const double iomega) const {
+  double torqueTotal = inputTorque + torqueFunc(iangle, mass, linkLen);
 
-  if (omega != 0) {
-    angle += omega * timestep;
+  if (iomega == 0 && muStatic > std::fabs(torqueTotal)) {
+    return 0;
   }
 
-  if (radianToDegree * angle > 181) {
-    angle = pi;
-    omega = 0;
+  return (torqueTotal - muDynamic * iomega) / I;
+}
+
+void FlywheelSimulator::explicitEulerStep(const double idt) {
+  accel = computeAcceleration(angle, omega);
+  omega += accel * (timestep * idt);
+
+  if (omega != 0) {
+    angle += omega * idt;
   }
+}
+
+void FlywheelSimulator::semiImplicitEulerStep(const double idt) {
+  const double externalTorque = inputTorque + torqueFunc(angle, mass, linkLen);
 
-  if (radianToDegree * angle < -1) {
-    angle = 0;
-    omega = 0;
+  if (omega == 0 && muStatic > std::fabs(externalTorque)) {
+    accel = 0;
+    return;
   }
 
-  return angle;
+  // Solve for the new omega with the dynamic friction evaluated at the new omega, which damps
+  // instead of overshooting when the friction is stiff
+  const double nextOmega = (omega + externalTorque / I * idt) / (1 + muDynamic / I * idt);
+  accel = (nextOmega - omega) / idt;
+  omega = nextOmega;
+  angle += omega * idt;
+}
+
+void FlywheelSimulator::rk4Step(const double idt) {
+  const double k1Angle = omega;
+  const double k1Omega = computeAcceleration(angle, omega);
+
+  const double k2Angle = omega + k1Omega * idt / 2;
+  const double k2Omega = computeAcceleration(angle + k1Angle * idt / 2, k2Angle);
+
+  const double k3Angle = omega + k2Omega * idt / 2;
+  const double k3Omega = computeAcceleration(angle + k2Angle * idt / 2, k3Angle);
+
+  const double k4Angle = omega + k3Omega * idt;
+  const double k4Omega = computeAcceleration(angle + k3Angle * idt, k4Angle);
+
+  accel = (k1Omega + 2 * k2Omega + 2 * k3Omega + k4Omega) / 6;
+  angle += (k1Angle + 2 * k2Angle + 2 * k3Angle + k4Angle) / 6 * idt;
+  omega += accel * idt;
 }
 
 void FlywheelSimulator::setExternalTorqueFunction(
@@ -112,6 +163,14 @@ void FlywheelSimulator::setLinkLength(const double ilinkLen) {
   }
 }
 
+void FlywheelSimulator::setMomentOfInertia(const double imomentOfInertia) {
+  if (imomentOfInertia < 0) {
+    I = 0;
+  } else {
+    I = imomentOfInertia;
+  }
+}
+
 void FlywheelSimulator::setStaticFriction(const double imuStatic) {
   if (imuStatic < 0) {
     muStatic = 0;
@@ -129,13 +188,21 @@ void FlywheelSimulator::setDynamicFriction(const double imuDynamic) {
 }
 
 void FlywheelSimulator::setTimestep(const double itimestep) {
-  if (timestep < minTimestep) {
+  if (itimestep < minTimestep) {
     timestep = minTimestep;
   } else {
     timestep = itimestep;
   }
 }
 
+void FlywheelSimulator::setIntegrator(const Integrator iintegrator) {
+  integrator = iintegrator;
+}
+
+void FlywheelSimulator::setSubsteps(const std::size_t isubsteps) {
+  substeps = std::max<std::size_t>(isubsteps, 1);
+}
+
 double FlywheelSimulator::getAngle() const {
   return angle;
 }
@@ -148,7 +215,39 @@ double FlywheelSimulator::getAcceleration() const {
   return accel;
 }
 
+double FlywheelSimulator::getMass() const {
+  return mass;
+}
+
+double FlywheelSimulator::getLinkLength() const {
+  return linkLen;
+}
+
+double FlywheelSimulator::getMomentOfInertia() const {
+  return I;
+}
+
+double FlywheelSimulator::getStaticFriction() const {
+  return muStatic;
+}
+
+double FlywheelSimulator::getDynamicFriction() const {
+  return muDynamic;
+}
+
 double FlywheelSimulator::getMaxTorque() const {
   return maxTorque;
 }
+
+double FlywheelSimulator::getTimestep() const {
+  return timestep;
+}
+
+FlywheelSimulator::Integrator FlywheelSimulator::getIntegrator() const {
+  return integrator;
+}
+
+std::size_t FlywheelSimulator::getSubsteps() const {
+  return substeps;
+}
 } // namespace okapi
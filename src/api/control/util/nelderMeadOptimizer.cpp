@@ -0,0 +1,151 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/nelderMeadOptimizer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace okapi {
+NelderMeadOptimizer::NelderMeadOptimizer(const std::size_t imaxEvaluations,
+                                         const double iinitialStep,
+                                         const double itolerance)
+  : logger(Logger::instance()),
+    maxEvaluations(imaxEvaluations),
+    initialStep(iinitialStep),
+    tolerance(itolerance) {
+}
+
+PIDTuner::Output NelderMeadOptimizer::optimize(const Bounds &ibounds,
+                                               const Evaluator &ievaluator,
+                                               std::mt19937 &igen) {
+  std::size_t evaluations = 0;
+  const auto evaluate = [&](const std::vector<Point> &ipoints) {
+    std::vector<PIDTuner::Output> candidates;
+    candidates.reserve(ipoints.size());
+    for (const auto &point : ipoints) {
+      candidates.push_back(toGains(point, ibounds));
+    }
+
+    evaluations += ipoints.size();
+    return ievaluator(candidates);
+  };
+
+  // Each search starts from a new random point. A search which collapses onto a (possibly local)
+  // minimum before the tests run out is restarted, and the best vertex of every search is kept.
+  std::uniform_real_distribution<double> dist(0, 1);
+  Vertex best{Point{}, std::numeric_limits<double>::max()};
+  while (evaluations == 0 || evaluations + 4 <= maxEvaluations) {
+    const Vertex found = search(Point{dist(igen), dist(igen), dist(igen)}, evaluate, evaluations);
+    if (found.error < best.error) {
+      best = found;
+    }
+  }
+
+  return toGains(best.point, ibounds);
+}
+
+NelderMeadOptimizer::Vertex NelderMeadOptimizer::search(
+  const Point &istart,
+  const std::function<std::vector<double>(const std::vector<Point> &)> &ievaluate,
+  const std::size_t &ievaluations) {
+  // Step along each axis, away from the nearer bound
+  std::vector<Point> initial{istart, istart, istart, istart};
+  for (std::size_t i = 0; i < 3; i++) {
+    initial.at(i + 1).at(i) += istart.at(i) + initialStep <= 1 ? initialStep : -initialStep;
+  }
+
+  const std::vector<double> initialErrors = ievaluate(initial);
+  std::array<Vertex, 4> simplex{};
+  for (std::size_t i = 0; i < simplex.size(); i++) {
+    simplex.at(i) = Vertex{initial.at(i), initialErrors.at(i)};
+  }
+
+  const auto byError = [](const Vertex &a, const Vertex &b) { return a.error < b.error; };
+
+  while (true) {
+    std::sort(simplex.begin(), simplex.end(), byError);
+
+    double size = 0;
+    for (std::size_t i = 1; i < simplex.size(); i++) {
+      for (std::size_t j = 0; j < 3; j++) {
+        size = std::max(size, std::abs(simplex.at(i).point.at(j) - simplex.at(0).point.at(j)));
+      }
+    }
+
+    // A step tests at most five points (a reflection, a contraction, and a shrink)
+    if (ievaluations + 5 > maxEvaluations || size < tolerance) {
+      return simplex.front();
+    }
+
+    logger->info("PIDTuner: Nelder-Mead test number " + std::to_string(ievaluations));
+
+    Point centroid{};
+    for (std::size_t i = 0; i < 3; i++) {
+      for (std::size_t j = 0; j < 3; j++) {
+        centroid.at(j) += simplex.at(i).point.at(j) / 3;
+      }
+    }
+
+    // Moves from the centroid towards (positive) or away from (negative) the worst vertex
+    Vertex &worst = simplex.back();
+    const auto along = [&](const double icoefficient) {
+      Point point{};
+      for (std::size_t j = 0; j < 3; j++) {
+        point.at(j) = std::clamp(
+          centroid.at(j) + icoefficient * (worst.point.at(j) - centroid.at(j)), 0.0, 1.0);
+      }
+      return point;
+    };
+
+    const Point reflectedPoint = along(-reflection);
+    const Vertex reflected{reflectedPoint, ievaluate({reflectedPoint}).front()};
+
+    if (reflected.error < simplex.front().error) {
+      const Point expandedPoint = along(-expansion);
+      const Vertex expanded{expandedPoint, ievaluate({expandedPoint}).front()};
+      worst = expanded.error < reflected.error ? expanded : reflected;
+    } else if (reflected.error < simplex.at(2).error) {
+      worst = reflected;
+    } else {
+      const bool outside = reflected.error < worst.error;
+      const Point contractedPoint = along(outside ? -contraction : contraction);
+      const Vertex contracted{contractedPoint, ievaluate({contractedPoint}).front()};
+
+      if (contracted.error < (outside ? reflected.error : worst.error)) {
+        worst = contracted;
+      } else {
+        // Shrink every vertex towards the best one
+        std::vector<Point> shrunk;
+        for (std::size_t i = 1; i < simplex.size(); i++) {
+          Point point{};
+          for (std::size_t j = 0; j < 3; j++) {
+            point.at(j) = simplex.front().point.at(j) +
+                          shrinkage * (simplex.at(i).point.at(j) - simplex.front().point.at(j));
+          }
+          shrunk.push_back(point);
+        }
+
+        const std::vector<double> shrunkErrors = ievaluate(shrunk);
+        for (std::size_t i = 1; i < simplex.size(); i++) {
+          simplex.at(i) = Vertex{shrunk.at(i - 1), shrunkErrors.at(i - 1)};
+        }
+      }
+    }
+  }
+}
+
+PIDTuner::Output NelderMeadOptimizer::toGains(const Point &ipoint, const Bounds &ibounds) {
+  const auto scale = [](const double ivalue, const double imin, const double imax) {
+    return imin + (imax - imin) * std::clamp(ivalue, 0.0, 1.0);
+  };
+
+  return PIDTuner::Output{scale(ipoint.at(0), ibounds.kPMin, ibounds.kPMax),
+                          scale(ipoint.at(1), ibounds.kIMin, ibounds.kIMax),
+                          scale(ipoint.at(2), ibounds.kDMin, ibounds.kDMax)};
+}
+} // namespace okapi
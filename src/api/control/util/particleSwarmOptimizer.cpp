@@ -0,0 +1,296 @@
+/**
+ * @author Jonathan Bayless, Team BLRS
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/particleSwarmOptimizer.hpp"
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace okapi {
+ParticleSwarmOptimizer::ParticleSwarmOptimizer(const std::size_t inumIterations,
+                                               const std::size_t inumParticles)
+  : logger(Logger::instance()), numIterations(inumIterations), numParticles(inumParticles) {
+}
+
+PIDTuner::Output ParticleSwarmOptimizer::optimize(const Bounds &ibounds,
+                                                  const Evaluator &ievaluator,
+                                                  std::mt19937 &igen) {
+  std::uniform_real_distribution<double> dist(0, 1);
+
+  particles.clear();
+  for (std::size_t i = 0; i < numParticles; i++) {
+    ParticleSet set{};
+    set.kP.pos = ibounds.kPMin + (ibounds.kPMax - ibounds.kPMin) * dist(igen);
+    set.kP.vel = set.kP.pos / increment;
+    set.kP.best = set.kP.pos;
+
+    set.kI.pos = ibounds.kIMin + (ibounds.kIMax - ibounds.kIMin) * dist(igen);
+    set.kI.vel = set.kI.pos / increment;
+    set.kI.best = set.kI.pos;
+
+    set.kD.pos = ibounds.kDMin + (ibounds.kDMax - ibounds.kDMin) * dist(igen);
+    set.kD.vel = set.kD.pos / increment;
+    set.kD.best = set.kD.pos;
+
+    set.bestError = std::numeric_limits<double>::max();
+    particles.push_back(set);
+  }
+
+  global = ParticleSet{};
+  global.kP.best = 0;
+  global.kI.best = 0;
+  global.kD.best = 0;
+  global.bestError = std::numeric_limits<double>::max();
+
+  iteration = 0;
+  numEvaluations = 0;
+  numResumedEvaluations = 0;
+
+  return run(ibounds, ievaluator, igen);
+}
+
+void ParticleSwarmOptimizer::setCheckpointFile(const std::string &ipath) {
+  checkpointFile = ipath;
+}
+
+PIDTuner::Output ParticleSwarmOptimizer::resume(const Bounds &ibounds,
+                                                const Evaluator &ievaluator,
+                                                std::mt19937 &igen) {
+  loadCheckpoint(ibounds, igen);
+  logger->info("PIDTuner: Resuming at iteration number " + std::to_string(iteration));
+  return run(ibounds, ievaluator, igen);
+}
+
+std::size_t ParticleSwarmOptimizer::getNumResumedEvaluations() const {
+  return numResumedEvaluations;
+}
+
+PIDTuner::Output ParticleSwarmOptimizer::run(const Bounds &ibounds,
+                                             const Evaluator &ievaluator,
+                                             std::mt19937 &igen) {
+  std::uniform_real_distribution<double> dist(0, 1);
+
+  // Run the optimization
+  std::vector<PIDTuner::Output> candidates(numParticles);
+  while (iteration < numIterations) {
+    logger->info("PIDTuner: Iteration number " + std::to_string(iteration));
+
+    for (std::size_t particleIndex = 0; particleIndex < numParticles; particleIndex++) {
+      candidates.at(particleIndex) = PIDTuner::Output{particles.at(particleIndex).kP.pos,
+                                                      particles.at(particleIndex).kI.pos,
+                                                      particles.at(particleIndex).kD.pos};
+    }
+
+    const std::vector<double> errors = ievaluator(candidates);
+    numEvaluations += candidates.size();
+
+    for (std::size_t particleIndex = 0; particleIndex < numParticles; particleIndex++) {
+      const double error = errors.at(particleIndex);
+
+      if (error < particles.at(particleIndex).bestError) {
+        particles.at(particleIndex).kP.best = particles.at(particleIndex).kP.pos;
+        particles.at(particleIndex).kI.best = particles.at(particleIndex).kI.pos;
+        particles.at(particleIndex).kD.best = particles.at(particleIndex).kD.pos;
+        particles.at(particleIndex).bestError = error;
+
+        if (error < global.bestError) {
+          global.kP.best = particles.at(particleIndex).kP.pos;
+          global.kI.best = particles.at(particleIndex).kI.pos;
+          global.kD.best = particles.at(particleIndex).kD.pos;
+          global.bestError = error;
+        }
+      }
+    }
+
+    // Update particle trajectories
+    for (std::size_t i = 0; i < numParticles; i++) {
+      // Factor in the particles inertia to keep on the same trajectory
+      particles.at(i).kP.vel *= inertia;
+      // Move towards particle's best
+      particles.at(i).kP.vel +=
+        confSelf * ((particles.at(i).kP.best - particles.at(i).kP.pos) / increment) * dist(igen);
+      // Move towards swarm's best
+      particles.at(i).kP.vel +=
+        confSwarm * ((global.kP.best - particles.at(i).kP.pos) / increment) * dist(igen);
+      // Kinematics
+      particles.at(i).kP.pos += particles.at(i).kP.vel * increment;
+
+      // Factor in the particles inertia to keep on the same trajectory
+      particles.at(i).kI.vel *= inertia;
+      // Move towards particle's best
+      particles.at(i).kI.vel +=
+        confSelf * ((particles.at(i).kI.best - particles.at(i).kI.pos) / increment) * dist(igen);
+      // Move towards swarm's best
+      particles.at(i).kI.vel +=
+        confSwarm * ((global.kI.best - particles.at(i).kI.pos) / increment) * dist(igen);
+      // Kinematics
+      particles.at(i).kI.pos += particles.at(i).kI.vel * increment;
+
+      // Factor in the particles inertia to keep on the same trajectory
+      particles.at(i).kD.vel *= inertia;
+      // Move towards particle's best
+      particles.at(i).kD.vel +=
+        confSelf * ((particles.at(i).kD.best - particles.at(i).kD.pos) / increment) * dist(igen);
+      // Move towards swarm's best
+      particles.at(i).kD.vel +=
+        confSwarm * ((global.kD.best - particles.at(i).kD.pos) / increment) * dist(igen);
+      // Kinematics
+      particles.at(i).kD.pos += particles.at(i).kD.vel * increment;
+
+      particles.at(i).kP.pos = std::clamp(particles.at(i).kP.pos, ibounds.kPMin, ibounds.kPMax);
+      particles.at(i).kI.pos = std::clamp(particles.at(i).kI.pos, ibounds.kIMin, ibounds.kIMax);
+      particles.at(i).kD.pos = std::clamp(particles.at(i).kD.pos, ibounds.kDMin, ibounds.kDMax);
+    }
+
+    iteration++;
+    if (!checkpointFile.empty()) {
+      saveCheckpoint(ibounds, igen);
+    }
+  }
+
+  return PIDTuner::Output{global.kP.best, global.kI.best, global.kD.best};
+}
+
+namespace {
+template <typename T> bool writeValue(std::FILE *ifile, const T &ivalue) {
+  return std::fwrite(&ivalue, sizeof(T), 1, ifile) == 1;
+}
+
+template <typename T> bool readValue(std::FILE *ifile, T &ovalue) {
+  return std::fread(&ovalue, sizeof(T), 1, ifile) == 1;
+}
+} // namespace
+
+void ParticleSwarmOptimizer::saveCheckpoint(const Bounds &ibounds,
+                                            const std::mt19937 &igen) const {
+  // The standard only defines the generator state as text, so it is stored as the numbers in that
+  // text
+  std::stringstream genText;
+  genText << igen;
+  std::vector<std::uint32_t> genState;
+  for (std::uint32_t word; genText >> word;) {
+    genState.push_back(word);
+  }
+
+  const std::string tempFile = checkpointFile + ".tmp";
+  std::FILE *file = std::fopen(tempFile.c_str(), "wb");
+  if (file == nullptr) {
+    logger->warn("PIDTuner: Could not open " + tempFile + " to save a checkpoint.");
+    return;
+  }
+
+  bool ok = writeValue(file, checkpointMagic) && writeValue(file, checkpointVersion) &&
+            writeValue<std::uint64_t>(file, numIterations) &&
+            writeValue<std::uint64_t>(file, numParticles) &&
+            writeValue<std::uint64_t>(file, iteration) &&
+            writeValue<std::uint64_t>(file, numEvaluations) && writeValue(file, ibounds);
+
+  for (const auto &particle : particles) {
+    ok = ok && writeValue(file, particle);
+  }
+
+  ok = ok && writeValue(file, global) && writeValue<std::uint64_t>(file, genState.size());
+  ok = ok && std::fwrite(genState.data(), sizeof(std::uint32_t), genState.size(), file) ==
+               genState.size();
+
+  // The last checkpoint is kept if this one could not be written
+  ok = std::fclose(file) == 0 && ok;
+  if (!ok) {
+    std::remove(tempFile.c_str());
+    logger->warn("PIDTuner: Could not write a checkpoint to " + tempFile + ".");
+    return;
+  }
+
+  // Some filesystems will not rename over an existing file
+  if (std::rename(tempFile.c_str(), checkpointFile.c_str()) != 0) {
+    std::remove(checkpointFile.c_str());
+    if (std::rename(tempFile.c_str(), checkpointFile.c_str()) != 0) {
+      logger->warn("PIDTuner: Could not move a checkpoint to " + checkpointFile + ".");
+    }
+  }
+}
+
+void ParticleSwarmOptimizer::loadCheckpoint(const Bounds &ibounds, std::mt19937 &igen) {
+  std::FILE *file = std::fopen(checkpointFile.c_str(), "rb");
+  if (file == nullptr) {
+    checkpointError("PIDTuner: Could not open the checkpoint " + checkpointFile + ".", nullptr);
+  }
+
+  std::uint32_t magic = 0, version = 0;
+  std::uint64_t savedIterations = 0, savedParticles = 0, savedIteration = 0,
+                savedEvaluations = 0;
+  Bounds savedBounds{};
+  if (!readValue(file, magic) || !readValue(file, version) || magic != checkpointMagic ||
+      version != checkpointVersion) {
+    checkpointError("PIDTuner: " + checkpointFile + " is not a particle swarm checkpoint.", file);
+  }
+
+  if (!readValue(file, savedIterations) || !readValue(file, savedParticles) ||
+      !readValue(file, savedIteration) || !readValue(file, savedEvaluations) ||
+      !readValue(file, savedBounds)) {
+    checkpointError("PIDTuner: The checkpoint " + checkpointFile + " is truncated.", file);
+  }
+
+  if (savedIterations != numIterations || savedParticles != numParticles ||
+      savedIteration > numIterations || savedBounds.kPMin != ibounds.kPMin ||
+      savedBounds.kPMax != ibounds.kPMax || savedBounds.kIMin != ibounds.kIMin ||
+      savedBounds.kIMax != ibounds.kIMax || savedBounds.kDMin != ibounds.kDMin ||
+      savedBounds.kDMax != ibounds.kDMax) {
+    checkpointError("PIDTuner: The checkpoint " + checkpointFile +
+                      " was saved with a different number of iterations, particles, or bounds.",
+                    file);
+  }
+
+  std::vector<ParticleSet> savedParticleSets(numParticles);
+  ParticleSet savedGlobal{};
+  std::uint64_t genStateSize = 0;
+  bool ok = true;
+  for (auto &particle : savedParticleSets) {
+    ok = ok && readValue(file, particle);
+  }
+  ok = ok && readValue(file, savedGlobal) && readValue(file, genStateSize) &&
+       genStateSize <= std::mt19937::state_size + 1;
+
+  std::vector<std::uint32_t> genState(ok ? genStateSize : 0);
+  ok = ok && std::fread(genState.data(), sizeof(std::uint32_t), genState.size(), file) ==
+               genState.size();
+  if (!ok) {
+    checkpointError("PIDTuner: The checkpoint " + checkpointFile + " is truncated.", file);
+  }
+
+  std::fclose(file);
+
+  std::stringstream genText;
+  for (const auto word : genState) {
+    genText << word << ' ';
+  }
+
+  std::mt19937 savedGen;
+  if (!(genText >> savedGen)) {
+    checkpointError("PIDTuner: The checkpoint " + checkpointFile + " is corrupt.", nullptr);
+  }
+
+  particles = std::move(savedParticleSets);
+  global = savedGlobal;
+  iteration = savedIteration;
+  numEvaluations = savedEvaluations;
+  numResumedEvaluations = savedEvaluations;
+  igen = savedGen;
+}
+
+void ParticleSwarmOptimizer::checkpointError(const std::string &imessage,
+                                             std::FILE *ifile) const {
+  if (ifile != nullptr) {
+    std::fclose(ifile);
+  }
+
+  logger->error(imessage);
+  throw std::runtime_error(imessage);
+}
+} // namespace okapi
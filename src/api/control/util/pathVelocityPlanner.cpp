@@ -0,0 +1,145 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/pathVelocityPlanner.hpp"
+#include "okapi/api/util/mathUtil.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace okapi {
+PathVelocityPlanner::PathVelocityPlanner(const Limits &ilimits, const double isampleDistance)
+  : limits(ilimits), sampleDistance(isampleDistance) {
+  if (ilimits.maxVel <= 0 || ilimits.maxAccel <= 0 || ilimits.maxWheelVel <= 0 ||
+      ilimits.wheelbaseWidth <= 0 || isampleDistance <= 0) {
+    const std::string msg =
+      "PathVelocityPlanner: The limits and the sample distance must be greater than zero.";
+    Logger::instance()->error(msg);
+    throw std::invalid_argument(msg);
+  }
+}
+
+std::vector<Segment> PathVelocityPlanner::plan(const Segment *itrajectory,
+                                               const int ilength,
+                                               const double idt) const {
+  if (ilength < 2 || itrajectory[ilength - 1].position <= 0) {
+    return std::vector<Segment>(itrajectory, itrajectory + std::max(ilength, 0));
+  }
+
+  // Sample the path at even distances. At least three samples are needed so the chassis can
+  // move between the stopped samples at the ends.
+  const double length = itrajectory[ilength - 1].position;
+  const auto count =
+    std::max<std::size_t>(3, static_cast<std::size_t>(std::ceil(length / sampleDistance)) + 1);
+  const double ds = length / (count - 1);
+
+  std::vector<double> xs(count);
+  std::vector<double> ys(count);
+  std::vector<double> headings(count);
+  std::size_t segment = 0;
+  for (std::size_t i = 0; i < count; i++) {
+    const double position = std::min(i * ds, length);
+    while (segment + 2 < static_cast<std::size_t>(ilength) &&
+           itrajectory[segment + 1].position < position) {
+      segment++;
+    }
+
+    const Segment &before = itrajectory[segment];
+    const Segment &after = itrajectory[segment + 1];
+    const double span = after.position - before.position;
+    const double fraction =
+      span > 0 ? std::clamp((position - before.position) / span, 0.0, 1.0) : 0;
+
+    xs[i] = before.x + (after.x - before.x) * fraction;
+    ys[i] = before.y + (after.y - before.y) * fraction;
+
+    // Keep the heading continuous so differences across a wrap are small
+    const double heading =
+      before.heading + std::remainder(after.heading - before.heading, 2 * pi) * fraction;
+    headings[i] =
+      i == 0 ? heading : headings[i - 1] + std::remainder(heading - headings[i - 1], 2 * pi);
+  }
+
+  // The outer wheel moves at v * (1 + |curvature| * width / 2), which must not be above the
+  // maximum wheel velocity. Use the sharper of the curvatures on either side of each sample, so
+  // the limit holds between samples too.
+  std::vector<double> velocities(count);
+  for (std::size_t i = 0; i < count; i++) {
+    const double before = i == 0 ? 0 : std::abs(headings[i] - headings[i - 1]) / ds;
+    const double after = i + 1 == count ? 0 : std::abs(headings[i + 1] - headings[i]) / ds;
+    const double curvature = std::max(before, after);
+    velocities[i] = std::min(
+      limits.maxVel, limits.maxWheelVel / (1 + curvature * limits.wheelbaseWidth / 2));
+  }
+
+  // Start and end stopped, and limit the acceleration in each direction
+  velocities.front() = 0;
+  velocities.back() = 0;
+  for (std::size_t i = 1; i < count; i++) {
+    velocities[i] =
+      std::min(velocities[i], std::sqrt(ipow(velocities[i - 1], 2) + 2 * limits.maxAccel * ds));
+  }
+
+  for (std::size_t i = count - 1; i > 0; i--) {
+    velocities[i - 1] =
+      std::min(velocities[i - 1], std::sqrt(ipow(velocities[i], 2) + 2 * limits.maxAccel * ds));
+  }
+
+  // The acceleration is constant between samples, so the time between them follows from the
+  // average velocity
+  std::vector<double> times(count);
+  times[0] = 0;
+  for (std::size_t i = 1; i < count; i++) {
+    times[i] = times[i - 1] + 2 * ds / (velocities[i - 1] + velocities[i]);
+  }
+
+  const auto steps = static_cast<std::size_t>(std::ceil(times.back() / idt));
+  std::vector<Segment> out;
+  out.reserve(steps + 1);
+
+  std::size_t sample = 0;
+  double lastAcceleration = 0;
+  for (std::size_t step = 0; step <= steps; step++) {
+    const double time = std::min(step * idt, times.back());
+    while (sample + 2 < count && times[sample + 1] <= time) {
+      sample++;
+    }
+
+    const double acceleration =
+      (ipow(velocities[sample + 1], 2) - ipow(velocities[sample], 2)) / (2 * ds);
+    const double elapsed = time - times[sample];
+    const double velocity = std::max(0.0, velocities[sample] + acceleration * elapsed);
+    const double fraction = std::clamp(
+      (velocities[sample] * elapsed + acceleration * elapsed * elapsed / 2) / ds, 0.0, 1.0);
+
+    Segment seg;
+    seg.dt = idt;
+    seg.x = xs[sample] + (xs[sample + 1] - xs[sample]) * fraction;
+    seg.y = ys[sample] + (ys[sample + 1] - ys[sample]) * fraction;
+    seg.position = (sample + fraction) * ds;
+    seg.velocity = velocity;
+    seg.acceleration = acceleration;
+    seg.jerk = step == 0 ? 0 : (acceleration - lastAcceleration) / idt;
+    seg.heading = headings[sample] + (headings[sample + 1] - headings[sample]) * fraction;
+
+    // Wrap the heading to [0, 2pi) like pathfinder does
+    seg.heading = std::fmod(seg.heading, 2 * pi);
+    if (seg.heading < 0) {
+      seg.heading += 2 * pi;
+    }
+    out.push_back(seg);
+
+    lastAcceleration = acceleration;
+  }
+
+  return out;
+}
+
+const PathVelocityPlanner::Limits &PathVelocityPlanner::getLimits() const {
+  return limits;
+}
+} // namespace okapi
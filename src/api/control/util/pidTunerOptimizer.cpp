@@ -0,0 +1,26 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/pidTunerOptimizer.hpp"
+#include <stdexcept>
+
+namespace okapi {
+void PIDTunerOptimizer::setCheckpointFile(const std::string &) {
+  Logger::instance()->error("PIDTunerOptimizer: This optimizer does not support checkpoints.");
+  throw std::invalid_argument("PIDTunerOptimizer: This optimizer does not support checkpoints.");
+}
+
+PIDTuner::Output
+PIDTunerOptimizer::resume(const Bounds &, const Evaluator &, std::mt19937 &) {
+  Logger::instance()->error("PIDTunerOptimizer: This optimizer does not support checkpoints.");
+  throw std::invalid_argument("PIDTunerOptimizer: This optimizer does not support checkpoints.");
+}
+
+std::size_t PIDTunerOptimizer::getNumResumedEvaluations() const {
+  return 0;
+}
+} // namespace okapi
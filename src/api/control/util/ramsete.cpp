@@ -0,0 +1,47 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/ramsete.hpp"
+#include "okapi/api/util/mathUtil.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace okapi {
+Ramsete::Ramsete(const Gains &igains) : gains(igains) {
+  if (igains.b <= 0 || igains.zeta <= 0 || igains.zeta >= 1) {
+    const std::string msg =
+      "Ramsete: b must be greater than zero and zeta must be between zero and one.";
+    Logger::instance()->error(msg);
+    throw std::invalid_argument(msg);
+  }
+}
+
+Ramsete::Output Ramsete::calculate(const OdomState &ipose,
+                                   const OdomState &itarget,
+                                   const double ivelocity,
+                                   const double iangularVelocity) const {
+  const double theta = ipose.theta.convert(radian);
+  const double dx = (itarget.x - ipose.x).convert(meter);
+  const double dy = (itarget.y - ipose.y).convert(meter);
+
+  // The error in the chassis frame, with the heading error wrapped to [-pi, pi]
+  const double errorX = std::cos(theta) * dx + std::sin(theta) * dy;
+  const double errorY = -std::sin(theta) * dx + std::cos(theta) * dy;
+  const double errorTheta = std::remainder(itarget.theta.convert(radian) - theta, 2 * pi);
+
+  const double sinc = std::abs(errorTheta) < 1e-9 ? 1 : std::sin(errorTheta) / errorTheta;
+  const double k = 2 * gains.zeta *
+                   std::sqrt(iangularVelocity * iangularVelocity + gains.b * ivelocity * ivelocity);
+
+  return Output{ivelocity * std::cos(errorTheta) + k * errorX,
+                iangularVelocity + k * errorTheta + gains.b * ivelocity * sinc * errorY};
+}
+
+const Ramsete::Gains &Ramsete::getGains() const {
+  return gains;
+}
+} // namespace okapi
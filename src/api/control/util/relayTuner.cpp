@@ -0,0 +1,159 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/relayTuner.hpp"
+#include "okapi/api/util/mathUtil.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace okapi {
+RelayTuner::RelayTuner(const std::shared_ptr<ControllerInput<double>> &iinput,
+                       const std::shared_ptr<ControllerOutput<double>> &ioutput,
+                       const TimeUtil &itimeUtil,
+                       const double isetpoint,
+                       const double irelayAmplitude,
+                       const double ihysteresis,
+                       const std::size_t inumCycles,
+                       const QTime itimeout,
+                       const QTime iloopDelta)
+  : logger(Logger::instance()),
+    input(iinput),
+    output(ioutput),
+    rate(itimeUtil.getRate()),
+    setpoint(isetpoint),
+    relayAmplitude(std::abs(irelayAmplitude)),
+    hysteresis(std::abs(ihysteresis)),
+    numCycles(std::max<std::size_t>(inumCycles, 1)),
+    timeout(itimeout),
+    loopDelta(iloopDelta) {
+}
+
+RelayTuner::~RelayTuner() = default;
+
+RelayTuner::Result RelayTuner::autotune(const TuningRule irule) {
+  const double start = input->controllerGet();
+
+  double relayOutput = relayAmplitude;
+  double cycleMax = std::numeric_limits<double>::lowest();
+  double cycleMin = std::numeric_limits<double>::max();
+  bool hasRisingSwitch = false;
+  QTime lastRisingSwitch = 0_ms;
+
+  // The first cycle starts from rest, so it is not measured
+  std::size_t cyclesSeen = 0;
+  std::size_t cyclesMeasured = 0;
+  QTime periodSum = 0_ms;
+  double peakToPeakSum = 0;
+
+  const auto maxSteps = static_cast<std::size_t>(
+    std::lround(timeout.convert(millisecond) / loopDelta.convert(millisecond)));
+  std::size_t steps = 0;
+  while (cyclesMeasured < numCycles) {
+    if (++steps > maxSteps) {
+      output->controllerSet(0);
+      logger->error("RelayTuner: The system did not oscillate before the timeout. Increase the "
+                    "relay amplitude or the timeout.");
+      throw std::runtime_error("RelayTuner: The system did not oscillate before the timeout. "
+                               "Increase the relay amplitude or the timeout.");
+    }
+
+    const QTime time = loopDelta * static_cast<double>(steps);
+    const double reading = input->controllerGet() - start;
+    cycleMax = std::max(cycleMax, reading);
+    cycleMin = std::min(cycleMin, reading);
+
+    const double error = setpoint - reading;
+    if (relayOutput > 0 && error < -hysteresis) {
+      relayOutput = -relayAmplitude;
+    } else if (relayOutput < 0 && error > hysteresis) {
+      relayOutput = relayAmplitude;
+
+      // A cycle runs from one rising switch to the next
+      if (hasRisingSwitch && ++cyclesSeen > 1) {
+        periodSum += time - lastRisingSwitch;
+        peakToPeakSum += cycleMax - cycleMin;
+        cyclesMeasured++;
+      }
+
+      hasRisingSwitch = true;
+      lastRisingSwitch = time;
+      cycleMax = reading;
+      cycleMin = reading;
+    }
+
+    output->controllerSet(relayOutput);
+    rate->delayUntil(loopDelta);
+  }
+
+  output->controllerSet(0);
+
+  const QTime period = periodSum / static_cast<double>(cyclesMeasured);
+  const double amplitude = peakToPeakSum / (2 * cyclesMeasured);
+
+  // Describing function of a relay with hysteresis
+  const double effectiveAmplitude =
+    amplitude > hysteresis ? std::sqrt(amplitude * amplitude - hysteresis * hysteresis) : amplitude;
+  const double ultimateGain = 4 * relayAmplitude / (pi * effectiveAmplitude);
+
+  logger->info("RelayTuner: Ultimate gain " + std::to_string(ultimateGain) + ", ultimate period " +
+               std::to_string(period.convert(millisecond)) + " ms");
+
+  return Result{ultimateGain,
+                period,
+                amplitude,
+                loopDelta * static_cast<double>(steps),
+                computeGains(ultimateGain, period, irule)};
+}
+
+PIDTuner::Output RelayTuner::computeGains(const double iultimateGain,
+                                          const QTime iultimatePeriod,
+                                          const TuningRule irule) {
+  const double tu = iultimatePeriod.convert(second);
+
+  // Proportional gain, integral time, and derivative time
+  double kP = 0, tI = 0, tD = 0;
+  switch (irule) {
+  case TuningRule::zieglerNichols:
+    kP = 0.6 * iultimateGain;
+    tI = tu / 2;
+    tD = tu / 8;
+    break;
+  case TuningRule::zieglerNicholsPI:
+    kP = 0.45 * iultimateGain;
+    tI = tu / 1.2;
+    break;
+  case TuningRule::tyreusLuyben:
+    kP = iultimateGain / 2.2;
+    tI = 2.2 * tu;
+    tD = tu / 6.3;
+    break;
+  case TuningRule::tyreusLuybenPI:
+    kP = iultimateGain / 3.2;
+    tI = 2.2 * tu;
+    break;
+  case TuningRule::pessenIntegral:
+    kP = 0.7 * iultimateGain;
+    tI = tu / 2.5;
+    tD = 0.15 * tu;
+    break;
+  case TuningRule::someOvershoot:
+    kP = 0.33 * iultimateGain;
+    tI = tu / 2;
+    tD = tu / 3;
+    break;
+  case TuningRule::noOvershoot:
+    kP = 0.2 * iultimateGain;
+    tI = tu / 2;
+    tD = tu / 3;
+    break;
+  }
+
+  return PIDTuner::Output{kP, tI > 0 ? kP / tI : 0, kP * tD};
+}
+} // namespace okapi
@@ -22,28 +22,33 @@ SettledUtil::SettledUtil(std::unique_ptr<AbstractTimer> iatTargetTimer,
 SettledUtil::~SettledUtil() = default;
 
 bool SettledUtil::isSettled(const double ierror) {
+  return isSettled(ierror, atTargetTimer->millis());
+}
+
+bool SettledUtil::isSettled(const double ierror, const QTime inow) {
   if (std::fabs(ierror) <= atTargetError && std::fabs(ierror - lastError) <= atTargetDerivative) {
-    /**
-     * Timer::getDtFromhardMark() returns 0_ms if there is no hard mark set, so this needs to be
-     * special-cased. Setting atTargetTime to 0_ms means that the user wants to exit immediately
-     * when in range of the target.
-     */
+    // Setting atTargetTime to 0_ms means that the user wants to exit immediately when in range of
+    // the target.
     if (atTargetTime == 0_ms) {
       return true;
     }
 
-    atTargetTimer->placeHardMark();
+    // The mark is only placed when entering the target range, like a hard mark
+    if (!hasAtTargetMark) {
+      atTargetMark = inow;
+      hasAtTargetMark = true;
+    }
   } else {
-    atTargetTimer->clearHardMark();
+    hasAtTargetMark = false;
   }
 
   lastError = ierror;
 
-  return atTargetTimer->getDtFromHardMark() > atTargetTime;
+  return hasAtTargetMark && inow - atTargetMark > atTargetTime;
 }
 
 void SettledUtil::reset() {
-  atTargetTimer->clearHardMark();
+  hasAtTargetMark = false;
   lastError = 0;
 }
 } // namespace okapi
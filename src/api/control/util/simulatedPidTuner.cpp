@@ -0,0 +1,100 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/util/simulatedPidTuner.hpp"
+#include "okapi/api/util/mathUtil.hpp"
+#include "okapi/api/util/parallelFor.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace okapi {
+SimulatedPIDTuner::SimulatedPIDTuner(
+  const Supplier<std::unique_ptr<FlywheelSimulator>> &isimulatorSupplier,
+  const TimeUtil &itimeUtil,
+  const QTime itimeout,
+  const std::int32_t igoal,
+  const double ikPMin,
+  const double ikPMax,
+  const double ikIMin,
+  const double ikIMax,
+  const double ikDMin,
+  const double ikDMax,
+  const std::size_t inumIterations,
+  const std::size_t inumParticles,
+  const double ikSettle,
+  const double ikITAE,
+  const std::size_t inumThreads)
+  : PIDTuner(nullptr,
+             nullptr,
+             itimeUtil,
+             itimeout,
+             igoal,
+             ikPMin,
+             ikPMax,
+             ikIMin,
+             ikIMax,
+             ikDMin,
+             ikDMax,
+             inumIterations,
+             inumParticles,
+             ikSettle,
+             ikITAE),
+    simulatorSupplier(isimulatorSupplier),
+    numThreads(std::max<std::size_t>(inumThreads, 1)) {
+}
+
+std::vector<double>
+SimulatedPIDTuner::evaluateCandidates(const std::vector<Output> &icandidates) {
+  std::vector<double> errors(icandidates.size());
+
+  // Each test gets a new simulator, so there is no need to alternate the goal like the hardware
+  // tests do (and the simulator cannot turn past its starting angle)
+  parallelFor(
+    icandidates.size(),
+    numThreads,
+    [&](const std::size_t i) { errors.at(i) = runTrial(icandidates.at(i), goal); },
+    *rate);
+
+  return errors;
+}
+
+double SimulatedPIDTuner::runTrial(const Output &igains, const std::int32_t itarget) {
+  auto simulator = simulatorSupplier.get();
+  auto settledUtil = timeUtil.getSettledUtil();
+
+  IterativePosPIDController testController(0, 0, 0, 0, timeUtil);
+  testController.setGains(igains.kP, igains.kI, igains.kD);
+  testController.setTarget(itarget);
+
+  const double startAngle = simulator->getAngle() * radianToDegree;
+  const long substeps =
+    std::max(1L, std::lround(loopDelta.convert(second) / simulator->getTimestep()));
+
+  QTime settleTime = 0_ms;
+  double itae = 0;
+  bool isSettled = false;
+  while (!isSettled) {
+    settleTime += loopDelta;
+    if (settleTime > timeout)
+      break;
+
+    const double inputVal = simulator->getAngle() * radianToDegree - startAngle;
+    const double outputVal = testController.step(inputVal, settleTime);
+    const double error = testController.getError();
+    // sum of the error emphasizing later error
+    itae += (settleTime.convert(millisecond) * abs((int)error)) / divisor;
+
+    for (long i = 0; i < substeps; i++) {
+      simulator->step(outputVal * simulator->getMaxTorque());
+    }
+
+    isSettled = settledUtil->isSettled(error, settleTime);
+  }
+
+  return computeError(settleTime, itae);
+}
+} // namespace okapi
@@ -0,0 +1,387 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/device/motor/simulatedMotor.hpp"
+#include "okapi/api/device/rotarysensor/simulatedIntegratedEncoder.hpp"
+#include "okapi/api/util/logging.hpp"
+#include "okapi/api/util/mathUtil.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace okapi {
+SimulatedMotor::SimulatedMotor(const gearset igearset, const double iloadInertia)
+  : loadInertia(iloadInertia), gearing(igearset) {
+}
+
+SimulatedMotor::~SimulatedMotor() = default;
+
+void SimulatedMotor::step(const QTime idt) {
+  double remaining = idt.convert(second);
+  while (remaining > 1e-9) {
+    const double dt = std::min(remaining, maxStep);
+    const double accel = computeTorque(dt * second) / loadInertia;
+    const double nextVelocity = velocity + accel * dt;
+
+    // Stop at zero instead of overshooting it, so friction cannot reverse the motor
+    advance(dt * second, velocity * nextVelocity < 0 ? 0 : nextVelocity);
+    remaining -= dt;
+  }
+}
+
+double SimulatedMotor::computeTorque(const QTime idt) {
+  const double ratio = getRatio();
+  const double kT = motorStallTorque / ratedCurrent;
+  const double kE = nominalVoltage / motorFreeSpeed;
+  const double motorVelocity = velocity * ratio;
+
+  voltage = computeVoltage(idt.convert(second));
+
+  if (mode == Mode::voltage && targetVoltage == 0 && brake == brakeMode::coast) {
+    // The windings are left open, so no current flows
+    current = 0;
+  } else {
+    current = std::clamp((voltage - kE * motorVelocity) / resistance, -currentLimit, currentLimit);
+  }
+
+  const double motorTorque = kT * current * ratio;
+  const double friction = frictionFraction * motorStallTorque * ratio;
+
+  if (std::abs(velocity) > 1e-6) {
+    torque = motorTorque - std::copysign(friction, velocity);
+  } else if (std::abs(motorTorque) > friction) {
+    torque = motorTorque - std::copysign(friction, motorTorque);
+  } else {
+    torque = 0;
+  }
+
+  return torque;
+}
+
+void SimulatedMotor::advance(const QTime idt, const double ivelocity) {
+  const double dt = idt.convert(second);
+  velocity = ivelocity;
+  position += velocity * dt;
+  time += dt;
+}
+
+double SimulatedMotor::computeVoltage(const double idt) {
+  const auto positionLoop = [&](const double ilimit) {
+    // posKP is in RPM per degree of error
+    const double rpm = posKP * (targetPosition - position) * radianToDegree;
+    return std::clamp(rpm * 2 * pi / 60, -ilimit, ilimit);
+  };
+
+  double velocityTarget = 0;
+  switch (mode) {
+  case Mode::voltage:
+    if (targetVoltage != 0 || brake != brakeMode::hold) {
+      velIntegral = 0;
+      return std::clamp(targetVoltage, -voltageLimit, voltageLimit);
+    }
+
+    // Hold the position the motor was stopped at
+    velocityTarget = positionLoop(getFreeSpeed());
+    break;
+
+  case Mode::velocity:
+    velocityTarget = targetVelocity;
+    break;
+
+  case Mode::position:
+    velocityTarget = positionLoop(profiledVelocity);
+    break;
+  }
+
+  const double error = (velocityTarget - velocity) / getFreeSpeed();
+  const double output =
+    (velKF * velocityTarget / getFreeSpeed() + velKP * error + velKI * velIntegral) *
+    nominalVoltage;
+
+  // Only integrate while the output can still act on the error, so the integral does not wind up
+  // while the motor accelerates at its voltage or current limit
+  const bool saturated = std::abs(output) >= voltageLimit || std::abs(current) >= currentLimit;
+  if (velKI <= 0) {
+    velIntegral = 0;
+  } else if (!saturated || error * output < 0) {
+    velIntegral = std::clamp(velIntegral + error * idt, -1 / velKI, 1 / velKI);
+  }
+
+  return std::clamp(output, -voltageLimit, voltageLimit);
+}
+
+QTime SimulatedMotor::getTime() const {
+  return time * second;
+}
+
+double SimulatedMotor::getShaftVelocity() const {
+  return velocity;
+}
+
+double SimulatedMotor::getStallTorque() const {
+  return motorStallTorque / ratedCurrent * currentLimit * getRatio();
+}
+
+double SimulatedMotor::getFreeSpeed() const {
+  return motorFreeSpeed / getRatio();
+}
+
+double SimulatedMotor::getRatio() const {
+  return 3600.0 / getMaxRPM();
+}
+
+double SimulatedMotor::getMaxRPM() const {
+  switch (gearing) {
+  case gearset::red:
+    return 100;
+  case gearset::blue:
+    return 600;
+  default:
+    return 200;
+  }
+}
+
+double SimulatedMotor::unitsToRadians(const double iposition) const {
+  switch (units) {
+  case encoderUnits::rotations:
+    return iposition * 2 * pi;
+  case encoderUnits::counts:
+    return iposition / (imev5TPR * 100 / getMaxRPM()) * 2 * pi;
+  default:
+    return iposition / radianToDegree;
+  }
+}
+
+double SimulatedMotor::radiansToUnits(const double iposition) const {
+  switch (units) {
+  case encoderUnits::rotations:
+    return iposition / (2 * pi);
+  case encoderUnits::counts:
+    return iposition / (2 * pi) * (imev5TPR * 100 / getMaxRPM());
+  default:
+    return iposition * radianToDegree;
+  }
+}
+
+std::int32_t SimulatedMotor::moveAbsolute(const double iposition, const std::int32_t ivelocity) {
+  mode = Mode::position;
+  targetPosition = zeroPosition + (reversed ? -1 : 1) * unitsToRadians(iposition);
+  profiledVelocity = std::abs(ivelocity) * 2 * pi / 60;
+  return 1;
+}
+
+std::int32_t SimulatedMotor::moveRelative(const double iposition, const std::int32_t ivelocity) {
+  mode = Mode::position;
+  targetPosition = position + (reversed ? -1 : 1) * unitsToRadians(iposition);
+  profiledVelocity = std::abs(ivelocity) * 2 * pi / 60;
+  return 1;
+}
+
+std::int32_t SimulatedMotor::moveVelocity(const std::int16_t ivelocity) {
+  mode = Mode::velocity;
+  targetVelocity = (reversed ? -1 : 1) * ivelocity * 2 * pi / 60;
+  return 1;
+}
+
+std::int32_t SimulatedMotor::moveVoltage(const std::int16_t ivoltage) {
+  mode = Mode::voltage;
+  targetVoltage = (reversed ? -1 : 1) * std::clamp(ivoltage / 1000.0, -12.0, 12.0);
+  if (targetVoltage == 0) {
+    // Remember where the motor stopped for the hold brake mode
+    targetPosition = position;
+  }
+  return 1;
+}
+
+std::int32_t SimulatedMotor::modifyProfiledVelocity(const std::int32_t ivelocity) {
+  profiledVelocity = std::abs(ivelocity) * 2 * pi / 60;
+  return 1;
+}
+
+double SimulatedMotor::getTargetPosition() {
+  return (reversed ? -1 : 1) * radiansToUnits(targetPosition - zeroPosition);
+}
+
+double SimulatedMotor::getPosition() {
+  return (reversed ? -1 : 1) * radiansToUnits(position - zeroPosition);
+}
+
+std::int32_t SimulatedMotor::tarePosition() {
+  zeroPosition = position;
+  return 1;
+}
+
+std::int32_t SimulatedMotor::getTargetVelocity() {
+  const double rpm = (reversed ? -1 : 1) * targetVelocity * 60 / (2 * pi);
+  return static_cast<std::int32_t>(std::lround(rpm));
+}
+
+double SimulatedMotor::getActualVelocity() {
+  return (reversed ? -1 : 1) * velocity * 60 / (2 * pi);
+}
+
+std::int32_t SimulatedMotor::getCurrentDraw() {
+  return static_cast<std::int32_t>(std::lround((reversed ? -1 : 1) * current * 1000));
+}
+
+std::int32_t SimulatedMotor::getDirection() {
+  return getActualVelocity() < 0 ? -1 : 1;
+}
+
+double SimulatedMotor::getEfficiency() {
+  const double power = voltage * current;
+  return power > 0 ? std::clamp(100 * torque * velocity / power, 0.0, 100.0) : 0;
+}
+
+std::int32_t SimulatedMotor::isOverCurrent() {
+  return std::abs(current) >= currentLimit ? 1 : 0;
+}
+
+std::int32_t SimulatedMotor::isOverTemp() {
+  return 0;
+}
+
+std::int32_t SimulatedMotor::isStopped() {
+  return std::abs(getActualVelocity()) < 1 ? 1 : 0;
+}
+
+std::int32_t SimulatedMotor::getZeroPositionFlag() {
+  return position == zeroPosition ? 1 : 0;
+}
+
+uint32_t SimulatedMotor::getFaults() {
+  return 0;
+}
+
+uint32_t SimulatedMotor::getFlags() {
+  return 0;
+}
+
+std::int32_t SimulatedMotor::getRawPosition(std::uint32_t *timestamp) {
+  if (timestamp != nullptr) {
+    *timestamp = static_cast<std::uint32_t>(std::lround(time * 1000));
+  }
+
+  const double counts = (reversed ? -1 : 1) * position / (2 * pi) * (imev5TPR * 100 / getMaxRPM());
+  return static_cast<std::int32_t>(std::lround(counts));
+}
+
+double SimulatedMotor::getPower() {
+  return std::abs(voltage * current);
+}
+
+double SimulatedMotor::getTemperature() {
+  return 25;
+}
+
+double SimulatedMotor::getTorque() {
+  return (reversed ? -1 : 1) * torque;
+}
+
+std::int32_t SimulatedMotor::getVoltage() {
+  return static_cast<std::int32_t>(std::lround((reversed ? -1 : 1) * voltage * 1000));
+}
+
+std::int32_t SimulatedMotor::setBrakeMode(const brakeMode imode) {
+  brake = imode;
+  return 1;
+}
+
+AbstractMotor::brakeMode SimulatedMotor::getBrakeMode() {
+  return brake;
+}
+
+std::int32_t SimulatedMotor::setCurrentLimit(const std::int32_t ilimit) {
+  currentLimit = std::clamp(ilimit / 1000.0, 0.0, ratedCurrent);
+  return 1;
+}
+
+std::int32_t SimulatedMotor::getCurrentLimit() {
+  return static_cast<std::int32_t>(std::lround(currentLimit * 1000));
+}
+
+std::int32_t SimulatedMotor::setEncoderUnits(const encoderUnits iunits) {
+  units = iunits;
+  return 1;
+}
+
+AbstractMotor::encoderUnits SimulatedMotor::getEncoderUnits() {
+  return units;
+}
+
+std::int32_t SimulatedMotor::setGearing(const gearset igearset) {
+  gearing = igearset;
+  return 1;
+}
+
+AbstractMotor::gearset SimulatedMotor::getGearing() {
+  return gearing;
+}
+
+std::int32_t SimulatedMotor::setReversed(const bool ireverse) {
+  reversed = ireverse;
+  return 1;
+}
+
+std::int32_t SimulatedMotor::setVoltageLimit(const std::int32_t ilimit) {
+  voltageLimit = std::clamp(ilimit / 1000.0, 0.0, nominalVoltage);
+  return 1;
+}
+
+std::int32_t SimulatedMotor::setPosPID(double, const double ikP, double, double) {
+  posKP = ikP;
+  return 1;
+}
+
+std::int32_t SimulatedMotor::setPosPIDFull(double,
+                                           const double ikP,
+                                           double,
+                                           double,
+                                           double,
+                                           double,
+                                           double,
+                                           double) {
+  posKP = ikP;
+  return 1;
+}
+
+std::int32_t
+SimulatedMotor::setVelPID(const double ikF, const double ikP, const double ikI, double) {
+  velKF = ikF;
+  velKP = ikP;
+  velKI = ikI;
+  velIntegral = 0;
+  return 1;
+}
+
+std::int32_t SimulatedMotor::setVelPIDFull(const double ikF,
+                                           const double ikP,
+                                           const double ikI,
+                                           double,
+                                           double,
+                                           double,
+                                           double,
+                                           double) {
+  return setVelPID(ikF, ikP, ikI, 0);
+}
+
+std::shared_ptr<ContinuousRotarySensor> SimulatedMotor::getEncoder() {
+  const auto self = weak_from_this().lock();
+  if (!self) {
+    Logger::instance()->error(
+      "SimulatedMotor: The motor must be owned by a std::shared_ptr to get its encoder.");
+    throw std::runtime_error(
+      "SimulatedMotor: The motor must be owned by a std::shared_ptr to get its encoder.");
+  }
+
+  return std::make_shared<SimulatedIntegratedEncoder>(self);
+}
+
+void SimulatedMotor::controllerSet(const double ivalue) {
+  moveVelocity(static_cast<std::int16_t>(ivalue * getMaxRPM()));
+}
+} // namespace okapi
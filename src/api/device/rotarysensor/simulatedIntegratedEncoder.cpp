@@ -0,0 +1,27 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/device/rotarysensor/simulatedIntegratedEncoder.hpp"
+
+namespace okapi {
+SimulatedIntegratedEncoder::SimulatedIntegratedEncoder(
+  const std::shared_ptr<SimulatedMotor> &imotor)
+  : motor(imotor) {
+}
+
+double SimulatedIntegratedEncoder::get() const {
+  return motor->getPosition();
+}
+
+std::int32_t SimulatedIntegratedEncoder::reset() {
+  return motor->tarePosition();
+}
+
+double SimulatedIntegratedEncoder::controllerGet() {
+  return get();
+}
+} // namespace okapi
@@ -0,0 +1,193 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/filter/biquadFilter.hpp"
+#include "okapi/api/util/logging.hpp"
+#include "okapi/api/util/mathUtil.hpp"
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+
+namespace okapi {
+BiquadFilter::BiquadFilter(const std::vector<Coefficients> &isections) {
+  if (isections.empty()) {
+    const std::string msg = "BiquadFilter: The filter must have at least one section.";
+    Logger::instance()->error(msg);
+    throw std::invalid_argument(msg);
+  }
+
+  sections.reserve(isections.size());
+  for (const auto &coefficients : isections) {
+    sections.push_back(Section{coefficients, 0, 0});
+  }
+}
+
+BiquadFilter BiquadFilter::butterworthLowPass(const std::size_t iorder,
+                                              const QFrequency icutoff,
+                                              const QTime isampleTime) {
+  return BiquadFilter(butterworth(iorder, prewarp(icutoff, isampleTime), false));
+}
+
+BiquadFilter BiquadFilter::butterworthHighPass(const std::size_t iorder,
+                                               const QFrequency icutoff,
+                                               const QTime isampleTime) {
+  return BiquadFilter(butterworth(iorder, prewarp(icutoff, isampleTime), true));
+}
+
+BiquadFilter
+BiquadFilter::notch(const QFrequency icenter, const double iq, const QTime isampleTime) {
+  if (iq <= 0) {
+    const std::string msg = "BiquadFilter: The quality factor must be greater than zero.";
+    Logger::instance()->error(msg);
+    throw std::invalid_argument(msg);
+  }
+
+  const double k = prewarp(icenter, isampleTime);
+  const double norm = 1 / (1 + k / iq + k * k);
+  const double b0 = (1 + k * k) * norm;
+  const double b1 = 2 * (k * k - 1) * norm;
+
+  return BiquadFilter({Coefficients{b0, b1, b0, b1, (1 - k / iq + k * k) * norm}});
+}
+
+double BiquadFilter::filter(const double ireading) {
+  double value = ireading;
+
+  for (auto &section : sections) {
+    const auto &c = section.coefficients;
+    const double y = c.b0 * value + section.s1;
+    section.s1 = c.b1 * value - c.a1 * y + section.s2;
+    section.s2 = c.b2 * value - c.a2 * y;
+    value = y;
+  }
+
+  output = value;
+  return output;
+}
+
+double BiquadFilter::getOutput() const {
+  return output;
+}
+
+void BiquadFilter::filterBatch(const double *iinput, double *ioutput, const std::size_t icount) {
+  if (icount == 0) {
+    return;
+  }
+
+  // Run the whole batch through each section in turn with its state in locals. Each section sees
+  // the same sequence as it would one reading at a time, so the results are the same.
+  const double *in = iinput;
+  for (auto &section : sections) {
+    const auto c = section.coefficients;
+    double s1 = section.s1;
+    double s2 = section.s2;
+
+    for (std::size_t i = 0; i < icount; i++) {
+      const double x = in[i];
+      const double y = c.b0 * x + s1;
+      s1 = c.b1 * x - c.a1 * y + s2;
+      s2 = c.b2 * x - c.a2 * y;
+      ioutput[i] = y;
+    }
+
+    section.s1 = s1;
+    section.s2 = s2;
+    in = ioutput;
+  }
+
+  output = ioutput[icount - 1];
+}
+
+void BiquadFilter::reset() {
+  for (auto &section : sections) {
+    section.s1 = 0;
+    section.s2 = 0;
+  }
+
+  output = 0;
+}
+
+std::vector<BiquadFilter::Coefficients> BiquadFilter::getSections() const {
+  std::vector<Coefficients> out;
+  out.reserve(sections.size());
+  for (const auto &section : sections) {
+    out.push_back(section.coefficients);
+  }
+  return out;
+}
+
+double BiquadFilter::getMagnitude(const QFrequency ifrequency, const QTime isampleTime) const {
+  const double w = 2 * pi * ifrequency.convert(Hz) * isampleTime.convert(second);
+  const std::complex<double> z1 = std::polar(1.0, -w);
+  const std::complex<double> z2 = z1 * z1;
+
+  std::complex<double> response = 1;
+  for (const auto &section : sections) {
+    const auto &c = section.coefficients;
+    response *= (c.b0 + c.b1 * z1 + c.b2 * z2) / (1.0 + c.a1 * z1 + c.a2 * z2);
+  }
+
+  return std::abs(response);
+}
+
+double BiquadFilter::prewarp(const QFrequency ifrequency, const QTime isampleTime) {
+  if (isampleTime.convert(second) <= 0) {
+    const std::string msg = "BiquadFilter: The sample time must be greater than zero.";
+    Logger::instance()->error(msg);
+    throw std::invalid_argument(msg);
+  }
+
+  const double normalized = ifrequency.convert(Hz) * isampleTime.convert(second);
+  if (normalized <= 0 || normalized >= 0.5) {
+    const std::string msg =
+      "BiquadFilter: The frequency must be between zero and the Nyquist frequency (half of the "
+      "sample rate).";
+    Logger::instance()->error(msg);
+    throw std::invalid_argument(msg);
+  }
+
+  return std::tan(pi * normalized);
+}
+
+std::vector<BiquadFilter::Coefficients>
+BiquadFilter::butterworth(const std::size_t iorder, const double ik, const bool ihighPass) {
+  if (iorder == 0) {
+    const std::string msg = "BiquadFilter: The order must be greater than zero.";
+    Logger::instance()->error(msg);
+    throw std::invalid_argument(msg);
+  }
+
+  std::vector<Coefficients> out;
+  const double kk = ik * ik;
+
+  // Each conjugate pair of analog poles becomes one section with the pair's quality factor
+  for (std::size_t i = 0; i < iorder / 2; i++) {
+    const double q = -1 / (2 * std::cos(pi * (2 * i + iorder + 1) / (2 * iorder)));
+    const double norm = 1 / (1 + ik / q + kk);
+    const double a1 = 2 * (kk - 1) * norm;
+    const double a2 = (1 - ik / q + kk) * norm;
+
+    if (ihighPass) {
+      out.push_back(Coefficients{norm, -2 * norm, norm, a1, a2});
+    } else {
+      out.push_back(Coefficients{kk * norm, 2 * kk * norm, kk * norm, a1, a2});
+    }
+  }
+
+  // An odd order has one real pole left over, which becomes a first-order section
+  if (iorder % 2 == 1) {
+    const double norm = 1 / (1 + ik);
+    if (ihighPass) {
+      out.push_back(Coefficients{norm, -norm, 0, (ik - 1) * norm, 0});
+    } else {
+      out.push_back(Coefficients{ik * norm, ik * norm, 0, (ik - 1) * norm, 0});
+    }
+  }
+
+  return out;
+}
+} // namespace okapi
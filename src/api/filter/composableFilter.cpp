@@ -6,6 +6,7 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/.
  */
 #include "okapi/api/filter/composableFilter.hpp"
+#include <algorithm>
 #include <utility>
 
 namespace okapi {
@@ -38,6 +39,26 @@ double ComposableFilter::getOutput() const {
   return output;
 }
 
+void ComposableFilter::filterBatch(const double *iinput,
+                                   double *ioutput,
+                                   const std::size_t icount) {
+  if (filters.empty()) {
+    std::fill(ioutput, ioutput + icount, 0);
+    return;
+  }
+
+  // Each filter sees the same sequence as it would one reading at a time, so the whole sequence
+  // can go through each filter in turn
+  filters.front()->filterBatch(iinput, ioutput, icount);
+  for (std::size_t i = 1; i < filters.size(); i++) {
+    filters[i]->filterBatch(ioutput, ioutput, icount);
+  }
+
+  if (icount > 0) {
+    output = filters.back()->getOutput();
+  }
+}
+
 void ComposableFilter::addFilter(const std::shared_ptr<Filter> &ifilter) {
   filters.push_back(ifilter);
 }
@@ -23,6 +23,28 @@ double DemaFilter::getOutput() const {
   return outputS + outputB;
 }
 
+void DemaFilter::filterBatch(const double *iinput, double *ioutput, const std::size_t icount) {
+  // Keep the state in locals so it can stay in registers, using the same arithmetic as filter()
+  const double a = alpha;
+  const double b = beta;
+  double s = lastOutputS;
+  double trend = lastOutputB;
+
+  for (std::size_t i = 0; i < icount; i++) {
+    const double nextS = (a * iinput[i]) + ((1.0 - a) * (s + trend));
+    trend = (b * (nextS - s)) + ((1.0 - b) * trend);
+    s = nextS;
+    ioutput[i] = s + trend;
+  }
+
+  if (icount > 0) {
+    outputS = s;
+    lastOutputS = s;
+    outputB = trend;
+    lastOutputB = trend;
+  }
+}
+
 void DemaFilter::setGains(const double ialpha, const double ibeta) {
   alpha = ialpha;
   beta = ibeta;
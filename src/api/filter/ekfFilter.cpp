@@ -34,4 +34,36 @@ double EKFFilter::filter(const double ireading, const double icontrol) {
 double EKFFilter::getOutput() const {
   return xHat;
 }
+
+void EKFFilter::filterBatch(const double *iinput, double *ioutput, const std::size_t icount) {
+  if (icount == 0) {
+    return;
+  }
+
+  // Keep the state in locals so it can stay in registers, using the same arithmetic as filter()
+  // with no control input
+  double x = xHatPrev;
+  double p = Pprev;
+  double xMinus = xHatMinus;
+  double pMinus = Pminus;
+  double k = K;
+
+  for (std::size_t i = 0; i < icount; i++) {
+    // Adding the zero control input turns -0 into 0 like filter() does
+    xMinus = x + 0.0;
+    pMinus = p + Q;
+    k = pMinus / (pMinus + R);
+    x = xMinus + k * (iinput[i] - xMinus);
+    p = (1 - k) * pMinus;
+    ioutput[i] = x;
+  }
+
+  xHatMinus = xMinus;
+  Pminus = pMinus;
+  K = k;
+  xHat = x;
+  xHatPrev = x;
+  P = p;
+  Pprev = p;
+}
 } // namespace okapi
@@ -21,6 +21,22 @@ double EmaFilter::getOutput() const {
   return output;
 }
 
+void EmaFilter::filterBatch(const double *iinput, double *ioutput, const std::size_t icount) {
+  // Keep the state in locals so it can stay in registers, using the same arithmetic as filter()
+  const double a = alpha;
+  double last = lastOutput;
+
+  for (std::size_t i = 0; i < icount; i++) {
+    last = a * iinput[i] + (1.0 - a) * last;
+    ioutput[i] = last;
+  }
+
+  if (icount > 0) {
+    output = last;
+    lastOutput = last;
+  }
+}
+
 void EmaFilter::setGains(const double ialpha) {
   alpha = ialpha;
 }
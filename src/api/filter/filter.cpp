@@ -9,4 +9,10 @@
 
 namespace okapi {
 Filter::~Filter() = default;
+
+void Filter::filterBatch(const double *iinput, double *ioutput, const std::size_t icount) {
+  for (std::size_t i = 0; i < icount; i++) {
+    ioutput[i] = filter(iinput[i]);
+  }
+}
 } // namespace okapi
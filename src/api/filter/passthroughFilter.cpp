@@ -7,6 +7,7 @@
  */
 
 #include "okapi/api/filter/passthroughFilter.hpp"
+#include <algorithm>
 
 namespace okapi {
 PassthroughFilter::PassthroughFilter() = default;
@@ -19,4 +20,18 @@ double PassthroughFilter::filter(const double ireading) {
 double PassthroughFilter::getOutput() const {
   return lastOutput;
 }
+
+void PassthroughFilter::filterBatch(const double *iinput,
+                                    double *ioutput,
+                                    const std::size_t icount) {
+  if (icount == 0) {
+    return;
+  }
+
+  if (iinput != ioutput) {
+    std::copy(iinput, iinput + icount, ioutput);
+  }
+
+  lastOutput = ioutput[icount - 1];
+}
 } // namespace okapi
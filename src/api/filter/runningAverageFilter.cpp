@@ -0,0 +1,54 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/filter/runningAverageFilter.hpp"
+#include "okapi/api/util/logging.hpp"
+#include <numeric>
+#include <stdexcept>
+
+namespace okapi {
+DynamicRunningAverageFilter::DynamicRunningAverageFilter(const std::size_t iwindowSize)
+  : data(iwindowSize, 0) {
+  if (iwindowSize == 0) {
+    const std::string msg =
+      "DynamicRunningAverageFilter: The window size must be greater than zero.";
+    Logger::instance()->error(msg);
+    throw std::invalid_argument(msg);
+  }
+}
+
+double DynamicRunningAverageFilter::filter(const double ireading) {
+  sum += ireading - data[index];
+  data[index++] = ireading;
+
+  if (index >= data.size()) {
+    index = 0;
+
+    // Start each pass over the window from an exact sum so rounding errors cannot build up
+    sum = std::accumulate(data.begin(), data.end(), 0.0);
+  }
+
+  output = sum / static_cast<double>(data.size());
+  return output;
+}
+
+double DynamicRunningAverageFilter::getOutput() const {
+  return output;
+}
+
+void DynamicRunningAverageFilter::filterBatch(const double *iinput,
+                                              double *ioutput,
+                                              const std::size_t icount) {
+  for (std::size_t i = 0; i < icount; i++) {
+    ioutput[i] = DynamicRunningAverageFilter::filter(iinput[i]);
+  }
+}
+
+std::size_t DynamicRunningAverageFilter::getWindowSize() const {
+  return data.size();
+}
+} // namespace okapi
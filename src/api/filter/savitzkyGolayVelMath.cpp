@@ -0,0 +1,185 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/filter/savitzkyGolayVelMath.hpp"
+#include "okapi/api/util/mathUtil.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace okapi {
+SavitzkyGolayVelMath::SavitzkyGolayVelMath(const double iticksPerRev,
+                                           const std::size_t iwindowSize,
+                                           const std::size_t iorder,
+                                           const QTime isampleTime,
+                                           std::unique_ptr<AbstractTimer> iloopDtTimer,
+                                           const std::shared_ptr<Filter> &ifilter)
+  : VelMath(iticksPerRev, ifilter, isampleTime, std::move(iloopDtTimer)),
+    windowSize(iwindowSize),
+    order(iorder),
+    times(iwindowSize),
+    positions(iwindowSize),
+    windowTimes(iwindowSize),
+    windowPositions(iwindowSize),
+    velCoefficients(iwindowSize),
+    accelCoefficients(iwindowSize) {
+  if (iorder < 1 || iorder > maxOrder) {
+    const std::string msg = "SavitzkyGolayVelMath: The order must be 1, 2, or 3.";
+    logger->error(msg);
+    throw std::invalid_argument(msg);
+  }
+
+  if (iwindowSize <= iorder) {
+    const std::string msg =
+      "SavitzkyGolayVelMath: The window size must be greater than the order.";
+    logger->error(msg);
+    throw std::invalid_argument(msg);
+  }
+
+  // Fit each unit impulse over sample indices ending at zero. By linearity, the fit's derivatives
+  // for any positions are the sums of the impulses' derivatives weighted by the positions.
+  std::vector<double> x(windowSize);
+  std::vector<double> impulse(windowSize, 0);
+  for (std::size_t i = 0; i < windowSize; i++) {
+    x[i] = static_cast<double>(i) - static_cast<double>(windowSize - 1);
+  }
+
+  for (std::size_t i = 0; i < windowSize; i++) {
+    impulse[i] = 1;
+    const auto coefficients = fit(x.data(), impulse.data(), windowSize, order);
+    velCoefficients[i] = coefficients[1];
+    accelCoefficients[i] = 2 * coefficients[2];
+    impulse[i] = 0;
+  }
+}
+
+std::size_t SavitzkyGolayVelMath::getWindowSize() const {
+  return windowSize;
+}
+
+std::size_t SavitzkyGolayVelMath::getOrder() const {
+  return order;
+}
+
+void SavitzkyGolayVelMath::calculate(const double inewPos, const QTime idt) {
+  if (count == 0) {
+    // Start the window with the position the first difference is taken from
+    times[0] = time;
+    positions[0] = lastPos;
+    count = 1;
+  }
+
+  time += idt.convert(second);
+
+  if (count < windowSize) {
+    times[count] = time;
+    positions[count] = inewPos;
+    count++;
+  } else {
+    times[head] = time;
+    positions[head] = inewPos;
+    head = (head + 1) % windowSize;
+  }
+
+  // Copy the window out oldest first, relative to the newest sample
+  double *x = windowTimes.data();
+  double *y = windowPositions.data();
+
+  bool evenlySpaced = count == windowSize;
+  const double spacing = count > 1 ? (time - times[head]) / (count - 1) : 0;
+  for (std::size_t i = 0; i < count; i++) {
+    const std::size_t index = (head + i) % windowSize;
+    x[i] = times[index] - time;
+    y[i] = positions[index];
+
+    if (i > 0 && std::abs(x[i] - x[i - 1] - spacing) > timestampEpsilon.convert(second)) {
+      evenlySpaced = false;
+    }
+  }
+
+  double velocity = 0;     // ticks/s
+  double acceleration = 0; // ticks/s^2
+  if (evenlySpaced) {
+    for (std::size_t i = 0; i < count; i++) {
+      velocity += velCoefficients[i] * y[i];
+      acceleration += accelCoefficients[i] * y[i];
+    }
+
+    velocity /= spacing;
+    acceleration /= spacing * spacing;
+  } else if (count > 1 && spacing > 0) {
+    // Scale the times to about one unit per sample so the normal equations are well conditioned
+    for (std::size_t i = 0; i < count; i++) {
+      x[i] /= spacing;
+    }
+
+    const auto coefficients = fit(x, y, count, std::min(order, count - 1));
+    velocity = coefficients[1] / spacing;
+    acceleration = 2 * coefficients[2] / (spacing * spacing);
+  }
+
+  const double toRPM = 60 / ticksPerRev;
+  vel = filter->filter(velocity * toRPM) * rpm;
+  accel = acceleration * toRPM * rpm / second;
+
+  lastVel = vel;
+  lastPos = inewPos;
+}
+
+std::array<double, SavitzkyGolayVelMath::maxOrder + 1> SavitzkyGolayVelMath::fit(
+  const double *ix, const double *iy, const std::size_t in, const std::size_t idegree) {
+  constexpr std::size_t size = maxOrder + 1;
+  const std::size_t n = idegree + 1;
+
+  // Build the normal equations (A^T A) c = A^T y, where A[i][j] = x_i^j
+  std::array<std::array<double, size + 1>, size> m{};
+  for (std::size_t i = 0; i < in; i++) {
+    std::array<double, 2 * maxOrder + 1> powers{};
+    powers[0] = 1;
+    for (std::size_t p = 1; p < 2 * n - 1; p++) {
+      powers[p] = powers[p - 1] * ix[i];
+    }
+
+    for (std::size_t r = 0; r < n; r++) {
+      for (std::size_t c = 0; c < n; c++) {
+        m[r][c] += powers[r + c];
+      }
+      m[r][n] += powers[r] * iy[i];
+    }
+  }
+
+  // Gaussian elimination with partial pivoting
+  for (std::size_t col = 0; col < n; col++) {
+    std::size_t pivot = col;
+    for (std::size_t r = col + 1; r < n; r++) {
+      if (std::abs(m[r][col]) > std::abs(m[pivot][col])) {
+        pivot = r;
+      }
+    }
+    std::swap(m[col], m[pivot]);
+
+    for (std::size_t r = col + 1; r < n; r++) {
+      const double factor = m[r][col] / m[col][col];
+      for (std::size_t c = col; c <= n; c++) {
+        m[r][c] -= factor * m[col][c];
+      }
+    }
+  }
+
+  std::array<double, size> coefficients{};
+  for (std::size_t r = n; r-- > 0;) {
+    double sum = m[r][n];
+    for (std::size_t c = r + 1; c < n; c++) {
+      sum -= m[r][c] * coefficients[c];
+    }
+    coefficients[r] = sum / m[r][r];
+  }
+
+  return coefficients;
+}
+} // namespace okapi
@@ -0,0 +1,102 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/filter/slidingMedianFilter.hpp"
+#include "okapi/api/util/logging.hpp"
+#include <iterator>
+#include <stdexcept>
+
+namespace okapi {
+DynamicSlidingMedianFilter::DynamicSlidingMedianFilter(const std::size_t iwindowSize)
+  : data(iwindowSize, 0),
+    sorted(data.begin(), data.end()),
+    middleIndex(iwindowSize % 2 == 1 ? iwindowSize / 2 : iwindowSize / 2 - 1) {
+  if (iwindowSize == 0) {
+    const std::string msg =
+      "DynamicSlidingMedianFilter: The window size must be greater than zero.";
+    Logger::instance()->error(msg);
+    throw std::invalid_argument(msg);
+  }
+
+  median = std::next(sorted.begin(), middleIndex);
+}
+
+DynamicSlidingMedianFilter::DynamicSlidingMedianFilter(const DynamicSlidingMedianFilter &iother)
+  : Filter(iother),
+    data(iother.data),
+    sorted(iother.sorted),
+    median(std::next(sorted.begin(), iother.middleIndex)),
+    middleIndex(iother.middleIndex),
+    index(iother.index),
+    output(iother.output) {
+}
+
+DynamicSlidingMedianFilter &
+DynamicSlidingMedianFilter::operator=(const DynamicSlidingMedianFilter &iother) {
+  if (this != &iother) {
+    data = iother.data;
+    sorted = iother.sorted;
+    middleIndex = iother.middleIndex;
+    median = std::next(sorted.begin(), middleIndex);
+    index = iother.index;
+    output = iother.output;
+  }
+
+  return *this;
+}
+
+double DynamicSlidingMedianFilter::filter(const double ireading) {
+  if (data.size() == 1) {
+    data[0] = ireading;
+    output = ireading;
+    return output;
+  }
+
+  // Remove the oldest reading. lower_bound finds the first of any equal readings, so it is at or
+  // before the median when the reading is not greater than the median, and the median moves up to
+  // stay at the middle index.
+  const double oldest = data[index];
+  const auto oldestNode = sorted.lower_bound(oldest);
+  if (oldest <= *median) {
+    ++median;
+  }
+  auto node = sorted.extract(oldestNode);
+
+  // Insert the new reading in the same node. Equal readings are inserted after the median, so
+  // the median only moves down when the new reading is strictly less than it.
+  node.value() = ireading;
+  const bool insertedBeforeMedian = ireading < *median;
+  sorted.insert(std::move(node));
+  if (insertedBeforeMedian) {
+    --median;
+  }
+
+  data[index++] = ireading;
+  if (index >= data.size()) {
+    index = 0;
+  }
+
+  output = *median;
+  return output;
+}
+
+double DynamicSlidingMedianFilter::getOutput() const {
+  return output;
+}
+
+void DynamicSlidingMedianFilter::filterBatch(const double *iinput,
+                                             double *ioutput,
+                                             const std::size_t icount) {
+  for (std::size_t i = 0; i < icount; i++) {
+    ioutput[i] = DynamicSlidingMedianFilter::filter(iinput[i]);
+  }
+}
+
+std::size_t DynamicSlidingMedianFilter::getWindowSize() const {
+  return data.size();
+}
+} // namespace okapi
@@ -9,6 +9,7 @@
 #include "okapi/api/filter/averageFilter.hpp"
 #include "okapi/api/filter/medianFilter.hpp"
 #include "okapi/api/util/mathUtil.hpp"
+#include <limits>
 #include <utility>
 
 namespace okapi {
@@ -49,18 +50,70 @@ VelMath::~VelMath() = default;
 
 QAngularSpeed VelMath::step(const double inewPos) {
   if (loopDtTimer->readDt() >= sampleTime) {
-    const QTime dt = loopDtTimer->getDt();
+    calculate(inewPos, loopDtTimer->getDt());
+  }
 
-    vel = filter->filter(((inewPos - lastPos) * (60 / ticksPerRev)) / dt.convert(second)) * rpm;
-    accel = (vel - lastVel) / dt;
+  return vel;
+}
 
-    lastVel = vel;
+QAngularSpeed VelMath::step(const double inewPos, const QTime inow) {
+  if (!hasLastStepTime) {
     lastPos = inewPos;
+    lastStepTime = inow;
+    hasLastStepTime = true;
+  } else if (const QTime dt = inow - lastStepTime;
+             dt > 0_ms && dt >= sampleTime - timestampEpsilon) {
+    calculate(inewPos, dt);
+    lastStepTime = inow;
   }
 
   return vel;
 }
 
+QAngularSpeed VelMath::step(AbstractMotor &imotor, bool *onewVelocity) {
+  if (onewVelocity != nullptr) {
+    *onewVelocity = false;
+  }
+
+  std::uint32_t timestamp = 0;
+  const std::int32_t position = imotor.getRawPosition(&timestamp);
+
+  // PROS_ERR
+  if (position == std::numeric_limits<std::int32_t>::max()) {
+    return vel;
+  }
+
+  if (!hasLastStepTime) {
+    lastPos = position;
+    lastStepTime = timestamp * 1_ms;
+    lastTimestamp = timestamp;
+    hasLastStepTime = true;
+    return vel;
+  }
+
+  // Unsigned subtraction keeps the elapsed time right when the timestamp wraps around
+  const QTime dt = static_cast<std::uint32_t>(timestamp - lastTimestamp) * 1_ms;
+  if (dt > 0_ms && dt >= sampleTime - timestampEpsilon) {
+    calculate(position, dt);
+    lastStepTime += dt;
+    lastTimestamp = timestamp;
+
+    if (onewVelocity != nullptr) {
+      *onewVelocity = true;
+    }
+  }
+
+  return vel;
+}
+
+void VelMath::calculate(const double inewPos, const QTime idt) {
+  vel = filter->filter(((inewPos - lastPos) * (60 / ticksPerRev)) / idt.convert(second)) * rpm;
+  accel = (vel - lastVel) / idt;
+
+  lastVel = vel;
+  lastPos = inewPos;
+}
+
 void VelMath::setTicksPerRev(const double iTPR) {
   ticksPerRev = iTPR;
 }
@@ -72,4 +125,8 @@ QAngularSpeed VelMath::getVelocity() const {
 QAngularAcceleration VelMath::getAccel() const {
   return accel;
 }
+
+QTime VelMath::getLastSampleTime() const {
+  return lastStepTime;
+}
 } // namespace okapi
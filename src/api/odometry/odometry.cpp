@@ -0,0 +1,145 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/odometry/odometry.hpp"
+#include "okapi/api/util/mathUtil.hpp"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace okapi {
+Odometry::Odometry(const std::shared_ptr<ReadOnlyChassisModel> &imodel,
+                   const ChassisScales &iscales,
+                   const TimeUtil &itimeUtil,
+                   const QTime iperiod,
+                   const QLength imiddleWheelDistance,
+                   const std::shared_ptr<ContinuousRotarySensor> &igyro)
+  : logger(Logger::instance()),
+    model(imodel),
+    scales(iscales),
+    timeUtil(itimeUtil),
+    timer(itimeUtil.getTimer()),
+    period(iperiod),
+    middleWheelDistance(imiddleWheelDistance.convert(meter)),
+    gyro(igyro) {
+  if (iscales.straight <= 0 || iscales.wheelbaseWidth.convert(meter) <= 0) {
+    const std::string msg =
+      "Odometry: The straight scale and the wheelbase width must be greater than zero.";
+    logger->error(msg);
+    throw std::invalid_argument(msg);
+  }
+
+  if (iperiod.convert(millisecond) <= 0) {
+    const std::string msg = "Odometry: The period must be greater than zero.";
+    logger->error(msg);
+    throw std::invalid_argument(msg);
+  }
+}
+
+Odometry::~Odometry() {
+  dtorCalled.store(true, std::memory_order_release);
+  delete task;
+}
+
+void Odometry::step() {
+  constexpr std::int32_t prosErr = std::numeric_limits<std::int32_t>::max(); // PROS_ERR
+
+  std::int32_t readings[3]{0, 0, 0};
+  const std::size_t count = model->fillSensorVals(readings, 3);
+  const double gyroReading = gyro ? gyro->get() : 0;
+  const QTime time = timer->millis();
+
+  const bool hasMiddle = count > 2;
+  if (count < 2 || readings[0] == prosErr || readings[1] == prosErr ||
+      (hasMiddle && readings[2] == prosErr) || gyroReading == prosErr) {
+    return;
+  }
+
+  const std::int32_t middle = hasMiddle ? readings[2] : 0;
+
+  if (!hasLastReadings) {
+    hasLastReadings = true;
+  } else {
+    // Cast before subtracting so the differences cannot overflow
+    const double dLeft =
+      (static_cast<double>(readings[0]) - static_cast<double>(lastLeft)) / scales.straight;
+    const double dRight =
+      (static_cast<double>(readings[1]) - static_cast<double>(lastRight)) / scales.straight;
+    const double dMiddle =
+      (static_cast<double>(middle) - static_cast<double>(lastMiddle)) / scales.straight;
+
+    const double dTheta = gyro ? (gyroReading - lastGyro) / 10 * (pi / 180)
+                               : (dRight - dLeft) / scales.wheelbaseWidth.convert(meter);
+
+    // The middle wheel also sees the rotation because it is not at the center of rotation
+    const double forward = (dLeft + dRight) / 2;
+    const double lateral = dMiddle + middleWheelDistance * dTheta;
+
+    // The chord of an arc is shorter than the arc by this factor and points along the average
+    // heading over the arc
+    const double chordScale = std::abs(dTheta) < 1e-9 ? 1 : 2 * std::sin(dTheta / 2) / dTheta;
+    const double heading = theta + dTheta / 2;
+    const double cosHeading = std::cos(heading);
+    const double sinHeading = std::sin(heading);
+
+    x += chordScale * (forward * cosHeading - lateral * sinHeading);
+    y += chordScale * (forward * sinHeading + lateral * cosHeading);
+    theta += dTheta;
+  }
+
+  lastLeft = readings[0];
+  lastRight = readings[1];
+  lastMiddle = middle;
+  lastGyro = gyroReading;
+
+  publish(time);
+}
+
+OdomState Odometry::getState() const {
+  return state.read();
+}
+
+OdomState Odometry::controllerGet() {
+  return getState();
+}
+
+void Odometry::setState(const OdomState &istate) {
+  x = istate.x.convert(meter);
+  y = istate.y.convert(meter);
+  theta = istate.theta.convert(radian);
+  publish(timer->millis());
+}
+
+QTime Odometry::getPeriod() const {
+  return period;
+}
+
+void Odometry::publish(const QTime itime) {
+  state.write(OdomState{x * meter, y * meter, theta * radian, itime});
+}
+
+void Odometry::trampoline(void *context) {
+  if (context) {
+    static_cast<Odometry *>(context)->loop();
+  }
+}
+
+void Odometry::loop() {
+  auto rate = timeUtil.getRate();
+
+  while (!dtorCalled.load(std::memory_order_acquire)) {
+    step();
+    rate->delayUntil(period);
+  }
+}
+
+void Odometry::startThread() {
+  if (!task) {
+    task = new CrossplatformThread(trampoline, this);
+  }
+}
+} // namespace okapi
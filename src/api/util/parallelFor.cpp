@@ -0,0 +1,71 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/util/parallelFor.hpp"
+#include "okapi/api/coreProsAPI.hpp"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace okapi {
+namespace {
+/**
+ * The work shared by the threads in one call to parallelFor().
+ */
+struct Batch {
+  std::size_t count;
+  const std::function<void(std::size_t)> *body;
+  std::atomic_size_t nextIndex{0};
+  std::atomic_size_t finishedThreads{0};
+};
+
+void runBatch(Batch &ibatch) {
+  for (std::size_t i = ibatch.nextIndex.fetch_add(1, std::memory_order_relaxed); i < ibatch.count;
+       i = ibatch.nextIndex.fetch_add(1, std::memory_order_relaxed)) {
+    (*ibatch.body)(i);
+  }
+}
+
+void trampoline(void *ibatch) {
+  auto *batch = static_cast<Batch *>(ibatch);
+  runBatch(*batch);
+  batch->finishedThreads.fetch_add(1, std::memory_order_release);
+
+  // The worker must not return on PROS, the batch's owner deletes it
+  CrossplatformThread::waitToBeDeleted();
+}
+} // namespace
+
+void parallelFor(const std::size_t icount,
+                 const std::size_t inumThreads,
+                 const std::function<void(std::size_t)> &ibody,
+                 AbstractRate &irate) {
+  Batch batch;
+  batch.count = icount;
+  batch.body = &ibody;
+
+  const std::size_t threadCount = std::min(inumThreads, icount);
+  if (threadCount <= 1) {
+    runBatch(batch);
+    return;
+  }
+
+  std::vector<std::unique_ptr<CrossplatformThread>> workers;
+  workers.reserve(threadCount);
+  for (std::size_t i = 0; i < threadCount; i++) {
+    workers.push_back(std::make_unique<CrossplatformThread>(trampoline, &batch));
+  }
+
+  while (batch.finishedThreads.load(std::memory_order_acquire) < threadCount) {
+    irate.delayUntil(1_ms);
+  }
+
+  // Deletes the waiting workers on PROS, or joins them with std::thread
+  workers.clear();
+}
+} // namespace okapi
@@ -20,6 +20,16 @@ IterativeControllerFactory::posPID(const double ikP,
     ikP, ikI, ikD, ikBias, TimeUtilFactory::create(), std::move(iderivativeFilter));
 }
 
+IterativeGainScheduledPosPIDController IterativeControllerFactory::gainScheduledPosPID(
+  const std::vector<IterativeGainScheduledPosPIDController::Breakpoint> &ischedule,
+  std::shared_ptr<ControllerInput<double>> ischeduleInput,
+  std::unique_ptr<Filter> iderivativeFilter) {
+  return IterativeGainScheduledPosPIDController(ischedule,
+                                                std::move(ischeduleInput),
+                                                TimeUtilFactory::create(),
+                                                std::move(iderivativeFilter));
+}
+
 IterativeVelPIDController
 IterativeControllerFactory::velPID(const double ikP,
                                    const double ikD,
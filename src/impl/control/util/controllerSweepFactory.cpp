@@ -0,0 +1,43 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/impl/control/util/controllerSweepFactory.hpp"
+#include "okapi/impl/util/timeUtilFactory.hpp"
+
+namespace okapi {
+ControllerSweep ControllerSweepFactory::create(
+  const Supplier<std::unique_ptr<FlywheelSimulator>> &isimulatorSupplier,
+  const Supplier<std::unique_ptr<IterativePosPIDController>> &icontrollerSupplier,
+  const double itarget,
+  const QTime itimeout,
+  const QTime iloopDelta,
+  const std::int32_t inumThreads) {
+  return ControllerSweep(isimulatorSupplier,
+                         icontrollerSupplier,
+                         TimeUtilFactory::create(),
+                         itarget,
+                         itimeout,
+                         iloopDelta,
+                         inumThreads);
+}
+
+std::unique_ptr<ControllerSweep> ControllerSweepFactory::createPtr(
+  const Supplier<std::unique_ptr<FlywheelSimulator>> &isimulatorSupplier,
+  const Supplier<std::unique_ptr<IterativePosPIDController>> &icontrollerSupplier,
+  const double itarget,
+  const QTime itimeout,
+  const QTime iloopDelta,
+  const std::int32_t inumThreads) {
+  return std::make_unique<ControllerSweep>(isimulatorSupplier,
+                                           icontrollerSupplier,
+                                           TimeUtilFactory::create(),
+                                           itarget,
+                                           itimeout,
+                                           iloopDelta,
+                                           inumThreads);
+}
+} // namespace okapi
@@ -36,4 +36,12 @@ std::unique_ptr<VelMath> VelMathFactory::createPtr(const double iticksPerRev,
 std::unique_ptr<VelMath> VelMathFactory::createPtr(const VelMathArgs &ivelMathArgs) {
   return std::make_unique<VelMath>(ivelMathArgs, std::make_unique<Timer>());
 }
+
+std::unique_ptr<VelMath> VelMathFactory::createSavitzkyGolayPtr(const double iticksPerRev,
+                                                                const std::size_t iwindowSize,
+                                                                const std::size_t iorder,
+                                                                const QTime isampleTime) {
+  return std::make_unique<SavitzkyGolayVelMath>(
+    iticksPerRev, iwindowSize, iorder, isampleTime, std::make_unique<Timer>());
+}
 } // namespace okapi
@@ -179,3 +179,49 @@ TEST_F(AsyncLinearMotionProfileControllerTest, DisabledStopsMotors) {
   EXPECT_TRUE(controller->isSettled());
   EXPECT_EQ(output->lastControllerOutputSet, 0);
 }
+
+TEST_F(AsyncLinearMotionProfileControllerTest, FeedforwardModeWritesFeedforwardOutput) {
+  controller->setFeedforward({0.05, 0.5, 0.1, 0});
+
+  std::vector<ProfileTrackingSample> samples;
+  controller->setTrackingCallback(
+    [&](const ProfileTrackingSample &isample) { samples.push_back(isample); });
+
+  controller->moveTo(0, 3);
+
+  ASSERT_FALSE(samples.empty());
+  Feedforward feedforward({0.05, 0.5, 0.1, 0});
+  for (const auto &sample : samples) {
+    EXPECT_DOUBLE_EQ(sample.output,
+                     feedforward.calculate(sample.targetVelocity, sample.targetAcceleration));
+  }
+
+  EXPECT_EQ(output->lastControllerOutputSet, 0);
+  EXPECT_GT(output->maxControllerOutputSet, 0);
+}
+
+TEST_F(AsyncLinearMotionProfileControllerTest, SettingsChangedDuringAPathTakeEffectOnTheNextPath) {
+  controller->setFeedforward({0.05, 0.5, 0.1, 0});
+
+  std::vector<ProfileTrackingSample> samples;
+  controller->setTrackingCallback([&](const ProfileTrackingSample &isample) {
+    samples.push_back(isample);
+
+    // The path keeps the callback and gains it started with
+    controller->setTrackingCallback(nullptr);
+    controller->disableFeedforward();
+  });
+
+  controller->moveTo(0, 3);
+
+  ASSERT_GT(samples.size(), 1);
+  Feedforward feedforward({0.05, 0.5, 0.1, 0});
+  for (const auto &sample : samples) {
+    EXPECT_DOUBLE_EQ(sample.output,
+                     feedforward.calculate(sample.targetVelocity, sample.targetAcceleration));
+  }
+
+  const std::size_t numSamples = samples.size();
+  controller->moveTo(0, 3);
+  EXPECT_EQ(samples.size(), numSamples);
+}
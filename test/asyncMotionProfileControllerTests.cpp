@@ -5,8 +5,12 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this
  * file, You can obtain one at http://mozilla.org/MPL/2.0/.
  */
+#include "okapi/api/chassis/model/xDriveModel.hpp"
+#include "okapi/api/chassis/simulator/skidSteerSimulator.hpp"
+#include "okapi/api/chassis/simulator/xDriveSimulator.hpp"
 #include "okapi/api/control/async/asyncMotionProfileController.hpp"
 #include "test/tests/api/implMocks.hpp"
+#include <cmath>
 #include <gtest/gtest.h>
 
 using namespace okapi;
@@ -15,6 +19,8 @@ class MockAsyncMotionProfileController : public AsyncMotionProfileController {
   public:
   using AsyncMotionProfileController::AsyncMotionProfileController;
   using AsyncMotionProfileController::convertLinearToRotational;
+  using AsyncMotionProfileController::model;
+  using AsyncMotionProfileController::paths;
 
   void executeSinglePath(const TrajectoryPair &path, std::unique_ptr<AbstractRate> rate) override {
     executeSinglePathCalled = true;
@@ -218,3 +224,574 @@ TEST_F(AsyncMotionProfileControllerTest, FollowPathBackwards) {
   // still running
   controller->flipDisable(true);
 }
+
+TEST_F(AsyncMotionProfileControllerTest, FeedforwardModeUsesVoltage) {
+  controller->setFeedforward({500, 6000, 1500, 0});
+
+  double maxLeftOutput = 0;
+  controller->setTrackingCallback(
+    [&](const ProfileTrackingSample &ileft, const ProfileTrackingSample &) {
+      maxLeftOutput = std::max(maxLeftOutput, ileft.output);
+    });
+
+  controller->moveTo({Point{0_m, 0_m, 0_deg}, Point{3_ft, 0_m, 0_deg}});
+
+  // Only the velocity commands from stopping the chassis were sent
+  EXPECT_EQ(leftMotor->lastVelocity, 0);
+  EXPECT_EQ(rightMotor->lastVelocity, 0);
+  EXPECT_EQ(leftMotor->maxVelocity, 0);
+  EXPECT_EQ(rightMotor->maxVelocity, 0);
+  EXPECT_GT(maxLeftOutput, 0);
+  EXPECT_LE(maxLeftOutput, 1);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, SettingsChangedDuringAPathTakeEffectOnTheNextPath) {
+  controller->setFeedforward({500, 6000, 1500, 0});
+
+  int numSamples = 0;
+  controller->setTrackingCallback(
+    [&](const ProfileTrackingSample &, const ProfileTrackingSample &) {
+      numSamples++;
+
+      // The path keeps the callback and gains it started with
+      controller->setTrackingCallback(nullptr);
+      controller->disableFeedforward();
+    });
+
+  controller->generatePath({Point{0_m, 0_m, 0_deg}, Point{3_ft, 0_m, 0_deg}}, "A");
+  const int length = controller->paths.at("A").length;
+
+  controller->executeSinglePath(controller->paths.at("A"), std::make_unique<NoDelayRate>());
+  EXPECT_EQ(numSamples, length);
+  EXPECT_EQ(leftMotor->maxVelocity, 0);
+
+  controller->executeSinglePath(controller->paths.at("A"), std::make_unique<NoDelayRate>());
+  EXPECT_EQ(numSamples, length);
+  EXPECT_GT(leftMotor->maxVelocity, 0);
+}
+
+/**
+ * A pose input which stays at the origin and disables Ramsete the first time it is read.
+ */
+class DisablingPoseInput : public ControllerInput<OdomState> {
+  public:
+  explicit DisablingPoseInput(AsyncMotionProfileController &icontroller)
+    : controller(icontroller) {
+  }
+
+  OdomState controllerGet() override {
+    numReads++;
+    controller.disableRamsete();
+    return OdomState{};
+  }
+
+  AsyncMotionProfileController &controller;
+  int numReads{0};
+};
+
+TEST_F(AsyncMotionProfileControllerTest, DisablingRamseteDuringAPathTakesEffectOnTheNextPath) {
+  auto poseInput = std::make_shared<DisablingPoseInput>(*controller);
+  controller->setRamsete(poseInput, Ramsete::Gains{});
+
+  controller->generatePath({Point{0_m, 0_m, 0_deg}, Point{3_ft, 0_m, 0_deg}}, "A");
+  const int length = controller->paths.at("A").length;
+
+  // The start pose and one pose per segment
+  controller->executeSinglePath(controller->paths.at("A"), std::make_unique<NoDelayRate>());
+  EXPECT_EQ(poseInput->numReads, length + 1);
+
+  controller->executeSinglePath(controller->paths.at("A"), std::make_unique<NoDelayRate>());
+  EXPECT_EQ(poseInput->numReads, length + 1);
+}
+
+/**
+ * A gyro which stays at zero and disables the encoder follower every time it is read.
+ */
+class DisablingGyro : public ContinuousRotarySensor {
+  public:
+  explicit DisablingGyro(AsyncMotionProfileController &icontroller) : controller(icontroller) {
+  }
+
+  double get() const override {
+    numReads++;
+    controller.disableEncoderFollower();
+    return 0;
+  }
+
+  std::int32_t reset() override {
+    return 1;
+  }
+
+  double controllerGet() override {
+    return get();
+  }
+
+  AsyncMotionProfileController &controller;
+  mutable int numReads{0};
+};
+
+TEST_F(AsyncMotionProfileControllerTest, DisablingTheFollowerDuringAPathTakesEffectOnTheNextPath) {
+  auto gyro = std::make_shared<DisablingGyro>(*controller);
+  controller->setEncoderFollower({1, 0, 1, 0, 0.01}, gyro);
+
+  controller->generatePath({Point{0_m, 0_m, 0_deg}, Point{3_ft, 0_m, 0_deg}}, "A");
+  const int length = controller->paths.at("A").length;
+
+  // The start heading and one heading per segment
+  controller->executeSinglePath(controller->paths.at("A"), std::make_unique<NoDelayRate>());
+  EXPECT_EQ(gyro->numReads, length + 1);
+
+  controller->executeSinglePath(controller->paths.at("A"), std::make_unique<NoDelayRate>());
+  EXPECT_EQ(gyro->numReads, length + 1);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, EncoderFollowerModeUsesVoltage) {
+  controller->setEncoderFollower({1, 0, 1, 0, 0});
+
+  double maxLeftOutput = 0;
+  controller->setTrackingCallback(
+    [&](const ProfileTrackingSample &ileft, const ProfileTrackingSample &) {
+      maxLeftOutput = std::max(maxLeftOutput, ileft.output);
+    });
+
+  controller->moveTo({Point{0_m, 0_m, 0_deg}, Point{3_ft, 0_m, 0_deg}});
+
+  // Only the velocity commands from stopping the chassis were sent
+  EXPECT_EQ(leftMotor->lastVelocity, 0);
+  EXPECT_EQ(rightMotor->lastVelocity, 0);
+  EXPECT_EQ(leftMotor->maxVelocity, 0);
+  EXPECT_EQ(rightMotor->maxVelocity, 0);
+  EXPECT_GT(maxLeftOutput, 0);
+  EXPECT_LE(maxLeftOutput, 1);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, DisableEncoderFollowerUsesVelocity) {
+  controller->setEncoderFollower({1, 0, 1, 0, 0});
+  controller->disableEncoderFollower();
+
+  controller->moveTo({Point{0_m, 0_m, 0_deg}, Point{3_ft, 0_m, 0_deg}});
+
+  EXPECT_GT(leftMotor->maxVelocity, 0);
+  EXPECT_GT(rightMotor->maxVelocity, 0);
+}
+
+TEST_F(AsyncMotionProfileControllerTest, HolonomicPathNeedsAnXDriveModel) {
+  EXPECT_THROW(controller->generateHolonomicPath(
+                 {Point{0_m, 0_m, 90_deg}, Point{0_m, 2_ft, 90_deg}}, "A"),
+               std::runtime_error);
+  EXPECT_TRUE(controller->getPaths().empty());
+}
+
+TEST(AsyncMotionProfileControllerHolonomicTest, StrafeLeftDrivesEachWheel) {
+  auto topLeft = std::make_shared<MockMotor>();
+  auto topRight = std::make_shared<MockMotor>();
+  auto bottomRight = std::make_shared<MockMotor>();
+  auto bottomLeft = std::make_shared<MockMotor>();
+
+  MockAsyncMotionProfileController controller(
+    createTimeUtil(),
+    1.0,
+    2.0,
+    10.0,
+    std::make_shared<XDriveModel>(topLeft, topRight, bottomRight, bottomLeft, 200),
+    {4_in, 10.5_in},
+    AbstractMotor::gearset::green);
+
+  controller.generateHolonomicPath({Point{0_m, 0_m, 90_deg}, Point{0_m, 2_ft, 90_deg}}, "A");
+  controller.executeSinglePath(controller.paths.at("A"), std::make_unique<NoDelayRate>());
+
+  // Strafing left drives the top right and bottom left wheels forward and the others backward
+  EXPECT_GT(topRight->maxVelocity, 0);
+  EXPECT_GT(bottomLeft->maxVelocity, 0);
+  EXPECT_EQ(topLeft->maxVelocity, 0);
+  EXPECT_EQ(bottomRight->maxVelocity, 0);
+  EXPECT_EQ(topLeft->lastVelocity, -topRight->lastVelocity);
+}
+
+TEST(AsyncMotionProfileControllerHolonomicTest, RemoveAHolonomicPath) {
+  auto motor = std::make_shared<MockMotor>();
+  MockAsyncMotionProfileController controller(
+    createTimeUtil(),
+    1.0,
+    2.0,
+    10.0,
+    std::make_shared<XDriveModel>(motor, motor, motor, motor, 200),
+    {4_in, 10.5_in},
+    AbstractMotor::gearset::green);
+
+  controller.generateHolonomicPath({Point{0_m, 0_m, 0_deg}, Point{2_ft, 0_m, 0_deg}}, "A");
+  EXPECT_EQ(controller.getPaths(), std::vector<std::string>{"A"});
+
+  controller.removePath("A");
+  EXPECT_TRUE(controller.getPaths().empty());
+}
+
+TEST(AsyncMotionProfileControllerPlanningTest, VelocityPlanningKeepsWheelsUnderFreeSpeed) {
+  auto generateMaxWheelVelocity = [](const bool iplan) {
+    auto motor = std::make_shared<MockMotor>();
+    MockAsyncMotionProfileController controller(createTimeUtil(),
+                                                1.0,
+                                                2.0,
+                                                10.0,
+                                                std::make_shared<SkidSteerModel>(motor, motor, 200),
+                                                {4_in, 11.5_in},
+                                                AbstractMotor::gearset::green);
+    controller.setVelocityPlanning(iplan);
+    controller.generatePath({Point{0_m, 0_m, 0_deg}, Point{1_m, 1_m, 90_deg}}, "A");
+
+    const auto &path = controller.paths.at("A");
+    double max = 0;
+    for (int i = 0; i < path.length; i++) {
+      max = std::max({max, std::abs(path.left[i].velocity), std::abs(path.right[i].velocity)});
+    }
+    return max;
+  };
+
+  // The free speed of a green gearset on 4 inch wheels
+  const double freeSpeed = 200.0 / 60 * pi * (4_in).convert(meter);
+  EXPECT_GT(generateMaxWheelVelocity(false), freeSpeed);
+  EXPECT_LT(generateMaxWheelVelocity(true), freeSpeed * 1.01);
+}
+
+/**
+ * One side of a drivetrain. Velocity commands are tracked by the motor's internal controller with
+ * a first-order lag and voltage commands drive a kS/kV/kA plant. Each command advances the
+ * simulation by one profile step.
+ */
+class SimulatedDriveMotor : public MockMotor {
+  public:
+  SimulatedDriveMotor(const double imetersPerDegree, const Feedforward::Gains &iplant)
+    : metersPerDegree(imetersPerDegree), plant(iplant) {
+  }
+
+  std::int32_t moveVelocity(const std::int16_t ivelocity) override {
+    MockMotor::moveVelocity(ivelocity);
+    const double target = ivelocity * 6.0 * metersPerDegree; // rpm -> deg/s -> m/s
+    integrate((target - velocity) / velocityTimeConstant);
+    return 1;
+  }
+
+  std::int32_t moveVoltage(const std::int16_t ivoltage) override {
+    MockMotor::moveVoltage(ivoltage);
+    const double friction = velocity != 0 ? std::copysign(plant.kS, velocity) : 0;
+    if (velocity == 0 && std::abs(ivoltage) <= plant.kS) {
+      integrate(0);
+    } else {
+      integrate((ivoltage - friction - plant.kV * velocity) / plant.kA);
+    }
+    return 1;
+  }
+
+  void integrate(const double iacceleration) {
+    velocity += iacceleration * dt;
+    position += velocity * dt;
+    encoder->value = static_cast<std::int32_t>(std::lround(position / metersPerDegree));
+  }
+
+  const double metersPerDegree;
+  const Feedforward::Gains plant;
+  const double dt{0.001};
+  const double velocityTimeConstant{0.1};
+  double velocity{0};
+  double position{0};
+};
+
+/**
+ * Follows a path on a simulated drivetrain and returns the RMS position tracking error of the left
+ * side in meters.
+ */
+static double simulateTrackingError(const bool iuseFeedforward, const Feedforward::Gains &igains) {
+  const ChassisScales scales({4_in, 10.5_in});
+  const Feedforward::Gains plant{500, 6000, 1500, 0};
+  const double metersPerDegree = 1 / scales.straight;
+
+  auto left = std::make_shared<SimulatedDriveMotor>(metersPerDegree, plant);
+  auto right = std::make_shared<SimulatedDriveMotor>(metersPerDegree, plant);
+
+  MockAsyncMotionProfileController controller(createTimeUtil(),
+                                              1.0,
+                                              2.0,
+                                              10.0,
+                                              std::make_shared<SkidSteerModel>(left, right, 200),
+                                              scales,
+                                              AbstractMotor::gearset::green);
+
+  if (iuseFeedforward) {
+    controller.setFeedforward(igains);
+  }
+
+  double squaredErrorSum = 0;
+  int count = 0;
+  controller.setTrackingCallback(
+    [&](const ProfileTrackingSample &ileft, const ProfileTrackingSample &) {
+      squaredErrorSum += ipow(ileft.targetPosition - ileft.measuredPosition, 2);
+      count++;
+    });
+
+  controller.generatePath({Point{0_m, 0_m, 0_deg}, Point{4_ft, 0_m, 0_deg}}, "A");
+  controller.executeSinglePath(controller.paths.at("A"), std::make_unique<NoDelayRate>());
+
+  return std::sqrt(squaredErrorSum / count);
+}
+
+TEST(AsyncMotionProfileControllerTrackingTest, FeedforwardReducesTrackingError) {
+  const double velocityError = simulateTrackingError(false, {});
+  const double exactError = simulateTrackingError(true, {500, 6000, 1500, 0});
+
+  // Gains which are 10% off from the simulated plant, with and without position correction
+  const double mismatchedError = simulateTrackingError(true, {450, 5400, 1350, 0});
+  const double correctedError = simulateTrackingError(true, {450, 5400, 1350, 20000});
+
+  EXPECT_LT(exactError, velocityError);
+  EXPECT_LT(correctedError, velocityError);
+  EXPECT_LT(correctedError, mismatchedError);
+}
+
+/**
+ * Steps a chassis simulation by the time each delay would wait, so a path runs in simulated time.
+ */
+class SimulationRate : public AbstractRate {
+  public:
+  explicit SimulationRate(ChassisSimulator &isimulator) : simulator(isimulator) {
+  }
+
+  void delay(QFrequency ihz) override {
+    simulator.step(1 / ihz);
+  }
+
+  void delay(int ihz) override {
+    simulator.step(1000_ms / ihz);
+  }
+
+  void delayUntil(QTime itime) override {
+    simulator.step(itime);
+  }
+
+  void delayUntil(uint32_t ims) override {
+    simulator.step(ims * millisecond);
+  }
+
+  ChassisSimulator &simulator;
+};
+
+/**
+ * Measures the pose of a simulated chassis exactly, like odometry on tracking wheels which do not
+ * slip.
+ */
+class SimulatedPoseInput : public ControllerInput<OdomState> {
+  public:
+  explicit SimulatedPoseInput(ChassisSimulator &isimulator) : simulator(isimulator) {
+  }
+
+  OdomState controllerGet() override {
+    const auto pose = simulator.getPose();
+    return OdomState{pose.x, pose.y, pose.theta, simulator.getTime()};
+  }
+
+  ChassisSimulator &simulator;
+};
+
+/**
+ * Follows an S-shaped path on a simulated chassis whose wheels are slightly larger than the scales
+ * say (like wheels which slip, or worn or mismeasured wheels) and returns the distance between
+ * where the chassis stopped and the end of the path in meters.
+ */
+static double simulateFinalError(const bool iuseRamsete,
+                                 const double imaxVel,
+                                 const double imaxAccel,
+                                 const double imaxJerk,
+                                 const bool ibackwards = false) {
+  auto createMotor = []() {
+    auto motor = std::make_shared<SimulatedMotor>(AbstractMotor::gearset::green);
+    motor->setEncoderUnits(AbstractMotor::encoderUnits::degrees);
+    return motor;
+  };
+
+  auto left = createMotor();
+  auto right = createMotor();
+  SkidSteerSimulator simulator(left, right, 4.15_in, 11.5_in);
+
+  MockAsyncMotionProfileController controller(createTimeUtil(),
+                                              imaxVel,
+                                              imaxAccel,
+                                              imaxJerk,
+                                              std::make_shared<SkidSteerModel>(left, right, 200),
+                                              {4_in, 11.5_in},
+                                              AbstractMotor::gearset::green);
+
+  if (iuseRamsete) {
+    controller.setRamsete(std::make_shared<SimulatedPoseInput>(simulator), Ramsete::Gains{});
+  }
+
+  controller.generatePath({Point{0_m, 0_m, 0_deg}, Point{4_ft, 2_ft, 0_deg}}, "A");
+  controller.setTarget("A", ibackwards);
+  controller.executeSinglePath(controller.paths.at("A"),
+                               std::make_unique<SimulationRate>(simulator));
+
+  // Let the chassis stop
+  controller.model->stop();
+  simulator.step(500_ms);
+
+  const auto pose = simulator.getPose();
+  const double sign = ibackwards ? -1 : 1;
+  return std::hypot(pose.x.convert(meter) - sign * (4_ft).convert(meter),
+                    pose.y.convert(meter) - (2_ft).convert(meter));
+}
+
+TEST(AsyncMotionProfileControllerTrackingTest, RamseteAllowsFasterPathsWithTheSameAccuracy) {
+  const double slowOpenLoopError = simulateFinalError(false, 0.5, 1, 5);
+  const double fastOpenLoopError = simulateFinalError(false, 0.9, 3, 15);
+  const double fastRamseteError = simulateFinalError(true, 0.9, 3, 15);
+
+  EXPECT_LT(fastRamseteError, slowOpenLoopError);
+  EXPECT_LT(fastRamseteError, fastOpenLoopError);
+}
+
+TEST(AsyncMotionProfileControllerTrackingTest, RamseteFollowsPathsBackwards) {
+  const double openLoopError = simulateFinalError(false, 0.9, 3, 15, true);
+  const double ramseteError = simulateFinalError(true, 0.9, 3, 15, true);
+
+  EXPECT_LT(ramseteError, openLoopError);
+}
+
+/**
+ * Measures the heading of a simulated chassis like an ADIGyro, in tenths of a degree
+ * counterclockwise.
+ */
+class SimulatedGyro : public ContinuousRotarySensor {
+  public:
+  explicit SimulatedGyro(ChassisSimulator &isimulator) : simulator(isimulator) {
+  }
+
+  double get() const override {
+    return simulator.getPose().theta.convert(degree) * 10;
+  }
+
+  double controllerGet() override {
+    return get();
+  }
+
+  std::int32_t reset() override {
+    return 1;
+  }
+
+  ChassisSimulator &simulator;
+};
+
+enum class FollowerMode { openLoop, encoder, encoderAndGyro };
+
+/**
+ * Follows an S-shaped path on a simulated chassis whose right side has less torque than its left
+ * side (like a side with a worn motor or more friction) and returns the distance between where the
+ * chassis stopped and the end of the path in meters.
+ */
+static double simulateWeakSideError(const FollowerMode imode) {
+  auto left = std::make_shared<SimulatedMotor>(AbstractMotor::gearset::green);
+  auto right = std::make_shared<SimulatedMotor>(AbstractMotor::gearset::green);
+  left->setEncoderUnits(AbstractMotor::encoderUnits::degrees);
+  right->setEncoderUnits(AbstractMotor::encoderUnits::degrees);
+  right->setCurrentLimit(1200);
+  SkidSteerSimulator simulator(left, right, 4_in, 11.5_in);
+
+  MockAsyncMotionProfileController controller(createTimeUtil(),
+                                              0.9,
+                                              3,
+                                              15,
+                                              std::make_shared<SkidSteerModel>(left, right, 200),
+                                              {4_in, 11.5_in},
+                                              AbstractMotor::gearset::green);
+
+  // kV is the inverse of the free speed of the chassis in m/s
+  const double kV = 1 / (200.0 / 60 * pi * (4_in).convert(meter));
+  if (imode == FollowerMode::encoder) {
+    controller.setEncoderFollower({5, 0, kV, 0.05, 0});
+  } else if (imode == FollowerMode::encoderAndGyro) {
+    controller.setEncoderFollower({5, 0, kV, 0.05, 0.02},
+                                  std::make_shared<SimulatedGyro>(simulator));
+  }
+
+  controller.generatePath({Point{0_m, 0_m, 0_deg}, Point{4_ft, 2_ft, 0_deg}}, "A");
+  controller.executeSinglePath(controller.paths.at("A"),
+                               std::make_unique<SimulationRate>(simulator));
+
+  controller.model->stop();
+  simulator.step(500_ms);
+
+  const auto pose = simulator.getPose();
+  return std::hypot(pose.x.convert(meter) - (4_ft).convert(meter),
+                    pose.y.convert(meter) - (2_ft).convert(meter));
+}
+
+TEST(AsyncMotionProfileControllerTrackingTest, EncoderFollowerCorrectsAWeakSide) {
+  const double openLoopError = simulateWeakSideError(FollowerMode::openLoop);
+  const double encoderError = simulateWeakSideError(FollowerMode::encoder);
+  const double gyroError = simulateWeakSideError(FollowerMode::encoderAndGyro);
+
+  EXPECT_LT(encoderError, openLoopError);
+  EXPECT_LT(gyroError, openLoopError);
+}
+
+/**
+ * Follows a holonomic path on a simulated X-drive and returns where the chassis stopped.
+ */
+static ChassisSimulator::Pose simulateHolonomicPath(std::initializer_list<Point> iwaypoints,
+                                                   const QAngle iheading,
+                                                   const bool ibackwards = false) {
+  auto createMotor = []() {
+    auto motor = std::make_shared<SimulatedMotor>(AbstractMotor::gearset::green);
+    motor->setEncoderUnits(AbstractMotor::encoderUnits::degrees);
+    return motor;
+  };
+
+  auto topLeft = createMotor();
+  auto topRight = createMotor();
+  auto bottomRight = createMotor();
+  auto bottomLeft = createMotor();
+  XDriveSimulator simulator(topLeft, topRight, bottomRight, bottomLeft, 4_in, 11.5_in, 11.5_in);
+
+  // Each wheel rolls at 45 degrees, so the chassis drives as if its wheels were sqrt(2) larger
+  MockAsyncMotionProfileController controller(
+    createTimeUtil(),
+    0.5,
+    1,
+    5,
+    std::make_shared<XDriveModel>(topLeft, topRight, bottomRight, bottomLeft, 200),
+    {4_in * std::sqrt(2), 11.5_in},
+    AbstractMotor::gearset::green);
+
+  controller.generateHolonomicPath(iwaypoints, "A", iheading);
+  controller.setTarget("A", ibackwards);
+  controller.executeSinglePath(controller.paths.at("A"),
+                               std::make_unique<SimulationRate>(simulator));
+
+  controller.model->stop();
+  simulator.step(500_ms);
+  return simulator.getPose();
+}
+
+TEST(AsyncMotionProfileControllerHolonomicTest, StrafesWithoutTurning) {
+  const auto pose =
+    simulateHolonomicPath({Point{0_m, 0_m, 90_deg}, Point{0_m, 2_ft, 90_deg}}, 0_deg);
+
+  EXPECT_NEAR(pose.x.convert(meter), 0, 0.03);
+  EXPECT_NEAR(pose.y.convert(meter), (2_ft).convert(meter), 0.03);
+  EXPECT_NEAR(pose.theta.convert(degree), 0, 3);
+}
+
+TEST(AsyncMotionProfileControllerHolonomicTest, TurnsWhileDrivingForward) {
+  const auto pose =
+    simulateHolonomicPath({Point{0_m, 0_m, 0_deg}, Point{3_ft, 0_m, 0_deg}}, 90_deg);
+
+  EXPECT_NEAR(pose.x.convert(meter), (3_ft).convert(meter), 0.05);
+  EXPECT_NEAR(pose.y.convert(meter), 0, 0.05);
+  EXPECT_NEAR(pose.theta.convert(degree), 90, 5);
+}
+
+TEST(AsyncMotionProfileControllerHolonomicTest, FollowsPathsBackwards) {
+  const auto pose =
+    simulateHolonomicPath({Point{0_m, 0_m, 45_deg}, Point{2_ft, 2_ft, 45_deg}}, 0_deg, true);
+
+  EXPECT_NEAR(pose.x.convert(meter), -(2_ft).convert(meter), 0.05);
+  EXPECT_NEAR(pose.y.convert(meter), (2_ft).convert(meter), 0.05);
+  EXPECT_NEAR(pose.theta.convert(degree), 0, 3);
+}
@@ -0,0 +1,250 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/chassis/model/skidSteerModel.hpp"
+#include "okapi/api/chassis/model/xDriveModel.hpp"
+#include "okapi/api/chassis/simulator/skidSteerSimulator.hpp"
+#include "okapi/api/chassis/simulator/xDriveSimulator.hpp"
+#include "okapi/api/device/motor/simulatedMotor.hpp"
+#include "okapi/api/util/mathUtil.hpp"
+#include "test/tests/api/implMocks.hpp"
+#include <gtest/gtest.h>
+#include <iostream>
+
+using namespace okapi;
+
+TEST(SimulatedMotorTest, FullVoltageReachesNearlyFreeSpeed) {
+  SimulatedMotor motor(AbstractMotor::gearset::green);
+  motor.moveVoltage(12000);
+  motor.step(2_s);
+
+  EXPECT_GT(motor.getActualVelocity(), 180);
+  EXPECT_LT(motor.getActualVelocity(), 200);
+  EXPECT_GT(motor.getPosition(), 0);
+  EXPECT_NEAR(motor.getTime().convert(second), 2, 1e-9);
+}
+
+TEST(SimulatedMotorTest, MoveVelocityTracksTheTarget) {
+  SimulatedMotor motor(AbstractMotor::gearset::green);
+  motor.moveVelocity(-150);
+  motor.step(1_s);
+
+  EXPECT_NEAR(motor.getActualVelocity(), -150, 2);
+  EXPECT_EQ(motor.getTargetVelocity(), -150);
+  EXPECT_EQ(motor.getDirection(), -1);
+}
+
+TEST(SimulatedMotorTest, MoveAbsoluteReachesTheTargetWithinTheVelocityLimit) {
+  SimulatedMotor motor(AbstractMotor::gearset::green);
+  motor.moveAbsolute(360, 100);
+
+  double maxVelocity = 0;
+  for (std::size_t i = 0; i < 300; i++) {
+    motor.step(10_ms);
+    maxVelocity = std::max(maxVelocity, motor.getActualVelocity());
+  }
+
+  EXPECT_NEAR(motor.getPosition(), 360, 2);
+  EXPECT_LT(maxVelocity, 105);
+  EXPECT_EQ(motor.isStopped(), 1);
+}
+
+TEST(SimulatedMotorTest, CurrentLimitCapsTheTorque) {
+  SimulatedMotor motor(AbstractMotor::gearset::red, 1000);
+  motor.setCurrentLimit(1250);
+  motor.moveVoltage(12000);
+  motor.step(1_ms);
+
+  EXPECT_EQ(motor.getCurrentDraw(), 1250);
+  EXPECT_EQ(motor.isOverCurrent(), 1);
+  EXPECT_NEAR(motor.getStallTorque(), 1.05, 1e-3);
+
+  // Friction is 2% of the stall torque at the rated current
+  EXPECT_NEAR(motor.getTorque(), motor.getStallTorque() - 0.02 * 2.1, 1e-3);
+}
+
+TEST(SimulatedMotorTest, ReversedMotorAndEncoderUnits) {
+  SimulatedMotor motor(AbstractMotor::gearset::green);
+  motor.setReversed(true);
+  motor.setEncoderUnits(AbstractMotor::encoderUnits::rotations);
+  motor.moveVelocity(120);
+  motor.step(1_s);
+
+  EXPECT_NEAR(motor.getActualVelocity(), 120, 2);
+  EXPECT_LT(motor.getShaftVelocity(), 0);
+  EXPECT_GT(motor.getPosition(), 1);
+
+  std::uint32_t timestamp = 0;
+  const auto counts = motor.getRawPosition(&timestamp);
+  EXPECT_EQ(timestamp, 1000);
+  EXPECT_NEAR(counts / 900.0, motor.getPosition(), 1e-2);
+}
+
+TEST(SimulatedMotorTest, EncoderKeepsTheMotorAlive) {
+  auto motor = std::make_shared<SimulatedMotor>(AbstractMotor::gearset::green);
+  motor->moveVelocity(120);
+  motor->step(1_s);
+  const double position = motor->getPosition();
+
+  auto encoder = motor->getEncoder();
+  motor.reset();
+  EXPECT_DOUBLE_EQ(encoder->get(), position);
+  encoder->reset();
+  EXPECT_DOUBLE_EQ(encoder->get(), 0);
+}
+
+TEST(SimulatedMotorTest, GetEncoderThrowsWithoutASharedPtr) {
+  SimulatedMotor motor(AbstractMotor::gearset::green);
+  EXPECT_THROW(motor.getEncoder(), std::runtime_error);
+}
+
+TEST(SimulatedMotorTest, CoastAndHoldBrakeModes) {
+  SimulatedMotor coasting(AbstractMotor::gearset::green);
+  SimulatedMotor holding(AbstractMotor::gearset::green);
+  holding.setBrakeMode(AbstractMotor::brakeMode::hold);
+
+  for (auto *motor : {&coasting, &holding}) {
+    motor->moveVoltage(12000);
+    motor->step(1_s);
+    motor->moveVoltage(0);
+  }
+
+  const double holdPosition = holding.getPosition();
+  coasting.step(2_s);
+  holding.step(2_s);
+
+  EXPECT_EQ(coasting.getCurrentDraw(), 0);
+  EXPECT_NEAR(holding.getPosition(), holdPosition, 5);
+  EXPECT_GT(coasting.getPosition(), holding.getPosition());
+}
+
+class ChassisSimulatorTest : public ::testing::Test {
+  protected:
+  std::shared_ptr<SimulatedMotor> createMotor() const {
+    auto motor = std::make_shared<SimulatedMotor>(AbstractMotor::gearset::green);
+    motor->setEncoderUnits(AbstractMotor::encoderUnits::degrees);
+    return motor;
+  }
+
+  const QLength wheelDiameter = 4_in;
+};
+
+TEST_F(ChassisSimulatorTest, SkidSteerDrivesStraight) {
+  auto left = createMotor();
+  auto right = createMotor();
+  SkidSteerSimulator sim(left, right, wheelDiameter, 12_in);
+  SkidSteerModel model(left, right, 200);
+
+  model.forward(1);
+  sim.step(2_s);
+
+  // 200 RPM on a 4 inch wheel
+  const double topSpeed = 200.0 / 60 * pi * wheelDiameter.convert(meter);
+  EXPECT_NEAR(sim.getForwardVelocity().convert(mps), topSpeed, topSpeed * 0.05);
+  EXPECT_GT(sim.getPose().x.convert(meter), 1.5);
+  EXPECT_NEAR(sim.getPose().y.convert(meter), 0, 1e-9);
+  EXPECT_NEAR(sim.getPose().theta.convert(degree), 0, 1e-9);
+
+  // The encoders measure the distance travelled
+  const auto sensors = model.getSensorVals();
+  EXPECT_NEAR(sensors[0] / 360.0 * pi * wheelDiameter.convert(meter),
+              sim.getPose().x.convert(meter),
+              1e-3);
+  EXPECT_NEAR(sensors[0], sensors[1], 1e-9);
+}
+
+TEST_F(ChassisSimulatorTest, SkidSteerTurnsInPlace) {
+  auto left = createMotor();
+  auto right = createMotor();
+  SkidSteerSimulator sim(left, right, wheelDiameter, 12_in);
+  SkidSteerModel model(left, right, 200);
+
+  // Positive rotation turns right, which is clockwise
+  model.rotate(0.5);
+  sim.step(1_s);
+
+  EXPECT_LT(sim.getPose().theta.convert(degree), -90);
+  EXPECT_LT(sim.getAngularVelocity().convert(radps), 0);
+  EXPECT_NEAR(sim.getPose().x.convert(meter), 0, 1e-9);
+  EXPECT_NEAR(sim.getPose().y.convert(meter), 0, 1e-9);
+}
+
+TEST_F(ChassisSimulatorTest, SkidSteerStopsAfterDriving) {
+  auto left = createMotor();
+  auto right = createMotor();
+  SkidSteerSimulator sim(left, right, wheelDiameter, 12_in);
+  SkidSteerModel model(left, right, 200);
+
+  model.setBrakeMode(AbstractMotor::brakeMode::brake);
+  model.forward(1);
+  sim.step(1_s);
+  model.stop();
+  sim.step(1_s);
+
+  EXPECT_NEAR(sim.getForwardVelocity().convert(mps), 0, 1e-3);
+}
+
+TEST_F(ChassisSimulatorTest, XDriveStrafesRight) {
+  auto topLeft = createMotor();
+  auto topRight = createMotor();
+  auto bottomRight = createMotor();
+  auto bottomLeft = createMotor();
+  XDriveSimulator sim(topLeft, topRight, bottomRight, bottomLeft, wheelDiameter, 14_in, 14_in);
+  XDriveModel model(topLeft, topRight, bottomRight, bottomLeft, 200);
+
+  model.xArcade(1, 0, 0);
+  sim.step(1_s);
+
+  EXPECT_LT(sim.getPose().y.convert(meter), -0.3);
+  EXPECT_NEAR(sim.getPose().x.convert(meter), 0, 1e-6);
+  EXPECT_NEAR(sim.getPose().theta.convert(degree), 0, 1e-6);
+}
+
+TEST_F(ChassisSimulatorTest, XDriveDrivesForwardAndTurns) {
+  auto topLeft = createMotor();
+  auto topRight = createMotor();
+  auto bottomRight = createMotor();
+  auto bottomLeft = createMotor();
+  XDriveSimulator sim(topLeft, topRight, bottomRight, bottomLeft, wheelDiameter, 14_in, 14_in);
+  XDriveModel model(topLeft, topRight, bottomRight, bottomLeft, 200);
+
+  model.forward(1);
+  sim.step(1_s);
+  EXPECT_GT(sim.getPose().x.convert(meter), 0.5);
+  EXPECT_NEAR(sim.getPose().y.convert(meter), 0, 1e-6);
+
+  model.rotate(1);
+  sim.step(500_ms);
+  EXPECT_LT(sim.getPose().theta.convert(degree), -30);
+}
+
+TEST_F(ChassisSimulatorTest, DISABLED_BenchmarkVirtualTimeThroughput) {
+  auto left = createMotor();
+  auto right = createMotor();
+  SkidSteerSimulator sim(left, right, wheelDiameter, 12_in);
+  SkidSteerModel model(left, right, 200);
+
+  // A 15 second routine: drive, turn, drive, controlled every 10 ms
+  const double nsPerLoop = benchmarkNsPerCall(
+    [&]() {
+      const double t = sim.getTime().convert(second);
+      if (t < 5) {
+        model.forward(1);
+      } else if (t < 7) {
+        model.rotate(0.5);
+      } else {
+        model.forward(0.5);
+      }
+      sim.step(10_ms);
+    },
+    1500);
+
+  std::cout << "Simulated a 15 s routine at " << nsPerLoop / 1000
+            << " us per 10 ms loop (" << 1e7 / nsPerLoop << "x real time)" << std::endl;
+
+  EXPECT_NEAR(sim.getTime().convert(second), 15, 1e-6);
+}
@@ -6,7 +6,10 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/.
  */
 #include "okapi/api/control/util/flywheelSimulator.hpp"
+#include "test/tests/api/implMocks.hpp"
+#include <cmath>
 #include <gtest/gtest.h>
+#include <iostream>
 
 using namespace okapi;
 
@@ -20,3 +23,141 @@ TEST(FlywheelSimulatorTest, BasicTest) {
   EXPECT_NEAR(sim.getOmega(), 0.0020193, 0.000005);
   EXPECT_NEAR(sim.getAcceleration(), 20.193, 0.0005);
 }
+
+namespace {
+struct FlywheelState {
+  double angle;
+  double omega;
+};
+
+constexpr double flywheelLowFriction = 0.01;
+constexpr double flywheelStiffFriction = 5;
+
+/**
+ * Drives the pendulum with a constant torque for one second. The stiff case gets more torque so it
+ * still moves noticeably against the friction.
+ */
+FlywheelState simulateFlywheel(const FlywheelSimulator::Integrator iintegrator,
+                               const double itimestep,
+                               const std::size_t isubsteps,
+                               const double imuDynamic) {
+  FlywheelSimulator sim(0.01, 1, 0.01, imuDynamic, itimestep);
+  sim.setIntegrator(iintegrator);
+  sim.setSubsteps(isubsteps);
+  sim.setTorque(imuDynamic == flywheelStiffFriction ? 0.5 : 0.12);
+
+  const long steps = std::lround(1 / itimestep);
+  for (long i = 0; i < steps; i++) {
+    sim.step();
+  }
+
+  return {sim.getAngle(), sim.getOmega()};
+}
+} // namespace
+
+TEST(FlywheelSimulatorTest, SubstepsKeepTheExplicitEulerDynamics) {
+  // Splitting a step refines the legacy dynamics without changing them
+  const auto coarse =
+    simulateFlywheel(FlywheelSimulator::Integrator::explicitEuler, 0.01, 1, flywheelLowFriction);
+  const auto fine =
+    simulateFlywheel(FlywheelSimulator::Integrator::explicitEuler, 0.01, 100, flywheelLowFriction);
+
+  EXPECT_NEAR(coarse.angle, fine.angle, fine.angle * 0.02);
+}
+
+TEST(FlywheelSimulatorTest, SetTimestepEnforcesTheMinimum) {
+  FlywheelSimulator sim;
+  sim.setTimestep(0);
+  EXPECT_DOUBLE_EQ(sim.getTimestep(), 0.000001);
+
+  sim.setTimestep(0.005);
+  EXPECT_DOUBLE_EQ(sim.getTimestep(), 0.005);
+
+  sim.setSubsteps(0);
+  EXPECT_EQ(sim.getSubsteps(), 1);
+}
+
+TEST(FlywheelSimulatorTest, SetMomentOfInertiaIsSeparateFromTheMass) {
+  FlywheelSimulator sim(0.01, 2);
+  EXPECT_DOUBLE_EQ(sim.getMomentOfInertia(), 0.04);
+
+  sim.setMass(0.02);
+  EXPECT_DOUBLE_EQ(sim.getMomentOfInertia(), 0.04);
+
+  sim.setMomentOfInertia(0.08);
+  EXPECT_DOUBLE_EQ(sim.getMomentOfInertia(), 0.08);
+
+  sim.setMomentOfInertia(-1);
+  EXPECT_DOUBLE_EQ(sim.getMomentOfInertia(), 0);
+}
+
+TEST(FlywheelSimulatorTest, RK4IsAccurateAtFiftyTimesTheStep) {
+  const auto reference =
+    simulateFlywheel(FlywheelSimulator::Integrator::rk4, 0.00001, 1, flywheelLowFriction);
+  const auto semiImplicit = simulateFlywheel(
+    FlywheelSimulator::Integrator::semiImplicitEuler, 0.0001, 1, flywheelLowFriction);
+  const auto rk4 =
+    simulateFlywheel(FlywheelSimulator::Integrator::rk4, 0.005, 1, flywheelLowFriction);
+
+  EXPECT_GT(reference.angle, 0.5);
+  EXPECT_LT(std::abs(rk4.angle - reference.angle), std::abs(semiImplicit.angle - reference.angle));
+}
+
+TEST(FlywheelSimulatorTest, StiffFrictionIsStableWithSemiImplicitEulerAndSubsteps) {
+  const auto reference =
+    simulateFlywheel(FlywheelSimulator::Integrator::rk4, 0.00001, 1, flywheelStiffFriction);
+
+  // The friction time constant is 2 ms, so a 20 ms RK4 step diverges without substeps
+  const auto rk4 =
+    simulateFlywheel(FlywheelSimulator::Integrator::rk4, 0.02, 1, flywheelStiffFriction);
+  const auto rk4Substeps =
+    simulateFlywheel(FlywheelSimulator::Integrator::rk4, 0.02, 10, flywheelStiffFriction);
+  const auto semiImplicit = simulateFlywheel(
+    FlywheelSimulator::Integrator::semiImplicitEuler, 0.02, 1, flywheelStiffFriction);
+
+  EXPECT_FALSE(std::abs(rk4.omega - reference.omega) < 1e-3);
+  EXPECT_NEAR(rk4Substeps.angle, reference.angle, 1e-4);
+  EXPECT_NEAR(rk4Substeps.omega, reference.omega, 1e-4);
+  EXPECT_NEAR(semiImplicit.angle, reference.angle, 2e-3);
+  EXPECT_NEAR(semiImplicit.omega, reference.omega, 2e-3);
+}
+
+TEST(FlywheelSimulatorTest, DISABLED_BenchmarkIntegratorAccuracyAndThroughput) {
+  struct Config {
+    const char *name;
+    FlywheelSimulator::Integrator integrator;
+    double timestep;
+    std::size_t substeps;
+  };
+
+  const Config configs[] = {
+    {"semi-implicit Euler 0.1 ms", FlywheelSimulator::Integrator::semiImplicitEuler, 0.0001, 1},
+    {"semi-implicit Euler 1 ms", FlywheelSimulator::Integrator::semiImplicitEuler, 0.001, 1},
+    {"semi-implicit Euler 5 ms", FlywheelSimulator::Integrator::semiImplicitEuler, 0.005, 1},
+    {"RK4 1 ms", FlywheelSimulator::Integrator::rk4, 0.001, 1},
+    {"RK4 5 ms", FlywheelSimulator::Integrator::rk4, 0.005, 1},
+    {"RK4 10 ms x 4 substeps", FlywheelSimulator::Integrator::rk4, 0.01, 4},
+  };
+
+  for (const double muDynamic : {flywheelLowFriction, flywheelStiffFriction}) {
+    const auto reference =
+      simulateFlywheel(FlywheelSimulator::Integrator::rk4, 0.00001, 1, muDynamic);
+    std::cout << (muDynamic == flywheelStiffFriction ? "Stiff" : "Low") << " friction"
+              << std::endl;
+
+    for (const auto &config : configs) {
+      FlywheelState state{};
+      const double nsPerSecond = benchmarkNsPerCall(
+        [&]() {
+          state = simulateFlywheel(config.integrator, config.timestep, config.substeps, muDynamic);
+        },
+        20);
+
+      std::cout << "  " << config.name << ": angle error "
+                << std::abs(state.angle - reference.angle) << " rad, " << nsPerSecond / 1000
+                << " us per simulated second" << std::endl;
+
+      EXPECT_TRUE(std::isfinite(state.angle));
+    }
+  }
+}
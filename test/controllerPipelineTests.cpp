@@ -0,0 +1,191 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/controllerPipeline.hpp"
+#include "okapi/api/control/iterative/iterativePosPidController.hpp"
+#include "okapi/api/filter/emaFilter.hpp"
+#include "okapi/api/filter/filteredControllerInput.hpp"
+#include "okapi/api/filter/passthroughFilter.hpp"
+#include "test/tests/api/implMocks.hpp"
+#include <gtest/gtest.h>
+#include <iostream>
+#include <utility>
+
+using namespace okapi;
+
+/**
+ * A concrete input which counts up by one each time it is read.
+ */
+class RampInput : public ControllerInput<double> {
+  public:
+  double controllerGet() override {
+    return value++;
+  }
+
+  double value{0};
+};
+
+/**
+ * A concrete output which remembers the last value written.
+ */
+class RecordingOutput : public ControllerOutput<double> {
+  public:
+  void controllerSet(const double ivalue) override {
+    lastValue = ivalue;
+  }
+
+  double lastValue{0};
+};
+
+class ControllerPipelineTest : public ::testing::Test {
+  protected:
+  static IterativePosPIDController createController() {
+    return IterativePosPIDController(0.01, 0.001, 0.0001, 0, createConstantTimeUtil(10_ms));
+  }
+
+  /**
+   * Steps a pipeline and, on the same components, the statement AsyncWrapper::loop runs each tick.
+   * Checks that both wrote the same output.
+   *
+   * @param iiterations the number of ticks to step each
+   * @return the nanoseconds per tick of the pipeline and of the AsyncWrapper loop body
+   */
+  static std::pair<double, double> compareWithAsyncWrapperLoopBody(const std::size_t iiterations) {
+    auto pipeline =
+      makeControllerPipeline(RampInput(), EmaFilter(0.5), createController(), RecordingOutput());
+    pipeline.setTarget(1e9);
+
+    std::shared_ptr<ControllerInput<double>> input =
+      std::make_shared<FilteredControllerInput<double, EmaFilter>>(
+        std::make_unique<RampInput>(), std::make_unique<EmaFilter>(0.5));
+    auto recordingOutput = std::make_shared<RecordingOutput>();
+    std::shared_ptr<ControllerOutput<double>> output = recordingOutput;
+    std::unique_ptr<IterativeController<double, double>> controller =
+      std::make_unique<IterativePosPIDController>(createController());
+    controller->setTarget(1e9);
+
+    const double pipelineNs = benchmarkNsPerCall([&]() { pipeline.step(); }, iiterations);
+    const double wrapperNs = benchmarkNsPerCall(
+      [&]() { output->controllerSet(controller->step(input->controllerGet())); }, iiterations);
+
+    EXPECT_DOUBLE_EQ(pipeline.getOutput().lastValue, recordingOutput->lastValue);
+    return {pipelineNs, wrapperNs};
+  }
+};
+
+TEST_F(ControllerPipelineTest, MatchesVirtualChain) {
+  auto pipeline =
+    makeControllerPipeline(RampInput(), EmaFilter(0.5), createController(), RecordingOutput());
+  pipeline.setTarget(100);
+
+  RampInput input;
+  EmaFilter filter(0.5);
+  auto controller = createController();
+  RecordingOutput output;
+  controller.setTarget(100);
+
+  for (int i = 0; i < 50; i++) {
+    const double expected = controller.step(filter.filter(input.controllerGet()));
+    output.controllerSet(expected);
+
+    EXPECT_DOUBLE_EQ(pipeline.step(), expected);
+    EXPECT_DOUBLE_EQ(pipeline.getOutput().lastValue, output.lastValue);
+    EXPECT_DOUBLE_EQ(pipeline.getError(), controller.getError());
+  }
+}
+
+TEST_F(ControllerPipelineTest, PointerStagesMatchValueStages) {
+  auto valuePipeline =
+    makeControllerPipeline(RampInput(), EmaFilter(0.5), createController(), RecordingOutput());
+
+  auto output = std::make_shared<RecordingOutput>();
+  auto pointerPipeline = makeControllerPipeline(
+    makePointerStage(std::make_unique<RampInput>()),
+    makePointerStage(std::make_shared<EmaFilter>(0.5)),
+    makePointerStage(std::unique_ptr<IterativeController<double, double>>(
+      std::make_unique<IterativePosPIDController>(createController()))),
+    makePointerStage(std::static_pointer_cast<ControllerOutput<double>>(output)));
+
+  valuePipeline.getController().setTarget(100);
+  pointerPipeline.getController().get()->setTarget(100);
+
+  for (int i = 0; i < 50; i++) {
+    EXPECT_DOUBLE_EQ(pointerPipeline.step(), valuePipeline.step());
+    EXPECT_DOUBLE_EQ(output->lastValue, valuePipeline.getOutput().lastValue);
+  }
+}
+
+TEST_F(ControllerPipelineTest, StepWithTimestamp) {
+  auto pipeline = makeControllerPipeline(
+    RampInput(), PassthroughFilter(), createController(), RecordingOutput());
+  pipeline.setTarget(100);
+
+  pipeline.step(0_ms);
+  const double first = pipeline.getOutput().lastValue;
+  EXPECT_GT(first, 0);
+
+  // Too soon after the last step, so the controller output should not change
+  pipeline.step(5_ms);
+  EXPECT_DOUBLE_EQ(pipeline.getOutput().lastValue, first);
+
+  pipeline.step(10_ms);
+  EXPECT_NE(pipeline.getOutput().lastValue, first);
+}
+
+TEST_F(ControllerPipelineTest, DisabledPipelineDoesNotStep) {
+  auto pipeline =
+    makeControllerPipeline(RampInput(), PassthroughFilter(), createController(), RecordingOutput());
+  pipeline.setTarget(100);
+  pipeline.step();
+  EXPECT_GT(pipeline.getOutput().lastValue, 0);
+
+  pipeline.flipDisable(true);
+  EXPECT_TRUE(pipeline.isDisabled());
+  EXPECT_TRUE(pipeline.isSettled());
+  EXPECT_EQ(pipeline.getOutput().lastValue, 0);
+
+  const double inputValue = pipeline.getInput().value;
+  EXPECT_EQ(pipeline.step(), 0);
+  EXPECT_EQ(pipeline.getInput().value, inputValue);
+  EXPECT_EQ(pipeline.getOutput().lastValue, 0);
+
+  pipeline.flipDisable();
+  EXPECT_FALSE(pipeline.isDisabled());
+  EXPECT_GT(pipeline.step(), 0);
+}
+
+TEST_F(ControllerPipelineTest, WorksThroughClosedLoopControllerInterface) {
+  auto pipeline =
+    makeControllerPipeline(RampInput(), PassthroughFilter(), createController(), RecordingOutput());
+  ClosedLoopController<double, double> &closedLoop = pipeline;
+
+  closedLoop.setTarget(42);
+  EXPECT_EQ(closedLoop.getTarget(), 42);
+
+  closedLoop.controllerSet(7);
+  EXPECT_EQ(closedLoop.getTarget(), 7);
+
+  pipeline.step();
+  pipeline.step();
+  EXPECT_EQ(closedLoop.getError(), 6);
+  EXPECT_NE(pipeline.getController().getOutput(), 0);
+
+  closedLoop.reset();
+  EXPECT_EQ(closedLoop.getError(), 7);
+  EXPECT_EQ(pipeline.getController().getOutput(), 0);
+}
+
+TEST_F(ControllerPipelineTest, MatchesAsyncWrapperLoopBody) {
+  compareWithAsyncWrapperLoopBody(100);
+}
+
+TEST_F(ControllerPipelineTest, DISABLED_BenchmarkAgainstAsyncWrapperLoopBody) {
+  const auto [pipelineNs, wrapperNs] = compareWithAsyncWrapperLoopBody(200000);
+
+  std::cout << "ControllerPipeline: " << pipelineNs << " ns/tick, AsyncWrapper loop body: "
+            << wrapperNs << " ns/tick" << std::endl;
+}
@@ -13,8 +13,16 @@
 #include "okapi/api/control/iterative/iterativeMotorVelocityController.hpp"
 #include "okapi/api/control/iterative/iterativePosPidController.hpp"
 #include "okapi/api/control/iterative/iterativeVelPidController.hpp"
+#include "okapi/api/control/util/feedforward.hpp"
+#include "okapi/api/control/util/controllerSweep.hpp"
 #include "okapi/api/control/util/flywheelSimulator.hpp"
+#include "okapi/api/control/util/nelderMeadOptimizer.hpp"
+#include "okapi/api/control/util/particleSwarmOptimizer.hpp"
+#include "okapi/api/control/util/pathVelocityPlanner.hpp"
 #include "okapi/api/control/util/pidTuner.hpp"
+#include "okapi/api/control/util/ramsete.hpp"
+#include "okapi/api/control/util/relayTuner.hpp"
+#include "okapi/api/control/util/simulatedPidTuner.hpp"
 #include "okapi/api/filter/averageFilter.hpp"
 #include "okapi/api/filter/filteredControllerInput.hpp"
 #include "okapi/api/filter/passthroughFilter.hpp"
@@ -22,6 +30,7 @@
 #include "okapi/api/util/mathUtil.hpp"
 #include "test/tests/api/implMocks.hpp"
 #include <gtest/gtest.h>
+#include <iostream>
 #include <limits>
 
 using namespace okapi;
@@ -129,6 +138,623 @@ TEST(PIDTunerTest, AutotuneShouldNotSegfault) {
   system->join(); // gtest will cause a SIGABRT if we don't join manually first
 }
 
+class SimulatedPIDTunerTest : public ::testing::Test {
+  protected:
+  static std::unique_ptr<SimulatedPIDTuner> createTuner(const std::size_t inumThreads) {
+    auto tuner = std::make_unique<SimulatedPIDTuner>(
+      Supplier<std::unique_ptr<FlywheelSimulator>>([]() {
+        auto sim = std::make_unique<FlywheelSimulator>();
+        sim->setExternalTorqueFunction([](double, double, double) { return 0; });
+        return sim;
+      }),
+      createTimeUtil(Supplier<std::unique_ptr<SettledUtil>>(
+        []() { return createSettledUtilPtr(2, 2, 100_ms); })),
+      2_s,
+      45,
+      0,
+      0.01,
+      0,
+      0.001,
+      0,
+      0.001,
+      5,
+      16,
+      1,
+      2,
+      inumThreads);
+    tuner->setSeed(1234);
+    return tuner;
+  }
+};
+
+TEST_F(SimulatedPIDTunerTest, SeededRunsAreReproducible) {
+  auto tuner1 = createTuner(4);
+  auto tuner2 = createTuner(4);
+  const auto gains1 = tuner1->autotune();
+  const auto gains2 = tuner2->autotune();
+
+  EXPECT_EQ(gains1.kP, gains2.kP);
+  EXPECT_EQ(gains1.kI, gains2.kI);
+  EXPECT_EQ(gains1.kD, gains2.kD);
+}
+
+TEST_F(SimulatedPIDTunerTest, ResultDoesNotDependOnThreadCount) {
+  auto serial = createTuner(1);
+  auto parallel = createTuner(8);
+  const auto serialGains = serial->autotune();
+  const auto parallelGains = parallel->autotune();
+
+  EXPECT_EQ(serialGains.kP, parallelGains.kP);
+  EXPECT_EQ(serialGains.kI, parallelGains.kI);
+  EXPECT_EQ(serialGains.kD, parallelGains.kD);
+}
+
+TEST_F(SimulatedPIDTunerTest, TunedGainsSettleTheSimulation) {
+  auto tuner = createTuner(4);
+  const auto gains = tuner->autotune();
+
+  EXPECT_GT(gains.kP, 0);
+  EXPECT_LE(gains.kP, 0.01);
+  EXPECT_LE(gains.kI, 0.001);
+  EXPECT_LE(gains.kD, 0.001);
+
+  FlywheelSimulator sim;
+  sim.setExternalTorqueFunction([](double, double, double) { return 0; });
+  IterativePosPIDController controller(0, 0, 0, 0, createConstantTimeUtil(10_ms));
+  controller.setGains(gains.kP, gains.kI, gains.kD);
+  controller.setTarget(45);
+
+  for (std::size_t i = 0; i < 500; i++) {
+    sim.step(controller.step(sim.getAngle() * radianToDegree) * sim.getMaxTorque());
+  }
+
+  EXPECT_NEAR(sim.getAngle() * radianToDegree, 45, 5);
+}
+
+TEST_F(SimulatedPIDTunerTest, NelderMeadTunedGainsSettleTheSimulation) {
+  auto tuner = createTuner(4);
+  tuner->setOptimizer(std::make_shared<NelderMeadOptimizer>(60));
+  const auto gains = tuner->autotune();
+
+  // A step can run up to three tests past the limit
+  EXPECT_LE(tuner->getNumEvaluations(), 63);
+  EXPECT_GT(gains.kP, 0);
+  EXPECT_LE(gains.kP, 0.01);
+  EXPECT_LE(gains.kI, 0.001);
+  EXPECT_LE(gains.kD, 0.001);
+
+  FlywheelSimulator sim;
+  sim.setExternalTorqueFunction([](double, double, double) { return 0; });
+  IterativePosPIDController controller(0, 0, 0, 0, createConstantTimeUtil(10_ms));
+  controller.setGains(gains.kP, gains.kI, gains.kD);
+  controller.setTarget(45);
+
+  for (std::size_t i = 0; i < 500; i++) {
+    sim.step(controller.step(sim.getAngle() * radianToDegree) * sim.getMaxTorque());
+  }
+
+  EXPECT_NEAR(sim.getAngle() * radianToDegree, 45, 5);
+}
+
+/**
+ * Records the error of every test run by another optimizer, in order.
+ */
+class RecordingOptimizer : public PIDTunerOptimizer {
+  public:
+  explicit RecordingOptimizer(std::shared_ptr<PIDTunerOptimizer> ioptimizer)
+    : optimizer(std::move(ioptimizer)) {
+  }
+
+  PIDTuner::Output
+  optimize(const Bounds &ibounds, const Evaluator &ievaluator, std::mt19937 &igen) override {
+    return optimizer->optimize(
+      ibounds,
+      [&](const std::vector<PIDTuner::Output> &icandidates) {
+        for (const auto &candidate : icandidates) {
+          EXPECT_GE(candidate.kP, ibounds.kPMin);
+          EXPECT_LE(candidate.kP, ibounds.kPMax);
+          EXPECT_GE(candidate.kI, ibounds.kIMin);
+          EXPECT_LE(candidate.kI, ibounds.kIMax);
+          EXPECT_GE(candidate.kD, ibounds.kDMin);
+          EXPECT_LE(candidate.kD, ibounds.kDMax);
+        }
+
+        const auto out = ievaluator(icandidates);
+        errors.insert(errors.end(), out.begin(), out.end());
+        return out;
+      },
+      igen);
+  }
+
+  std::vector<double> errors;
+
+  protected:
+  std::shared_ptr<PIDTunerOptimizer> optimizer;
+};
+
+TEST(NelderMeadOptimizerTest, FindsTheMinimumOfAQuadratic) {
+  auto optimizer =
+    std::make_shared<RecordingOptimizer>(std::make_shared<NelderMeadOptimizer>(200, 0.4, 1e-3));
+  std::mt19937 gen(1234);
+  const auto gains = optimizer->optimize(
+    PIDTunerOptimizer::Bounds{0, 2, -1, 1, 0, 10},
+    [](const std::vector<PIDTuner::Output> &icandidates) {
+      std::vector<double> errors;
+      for (const auto &candidate : icandidates) {
+        errors.push_back(std::pow(candidate.kP - 0.6, 2) + std::pow(candidate.kI + 0.4, 2) +
+                         std::pow((candidate.kD - 7) / 10, 2));
+      }
+      return errors;
+    },
+    gen);
+
+  EXPECT_NEAR(gains.kP, 0.6, 0.01);
+  EXPECT_NEAR(gains.kI, -0.4, 0.01);
+  EXPECT_NEAR(gains.kD, 7, 0.1);
+  EXPECT_LE(optimizer->errors.size(), 200);
+}
+
+TEST(NelderMeadOptimizerTest, ClampsToTheBounds) {
+  auto optimizer = std::make_shared<RecordingOptimizer>(std::make_shared<NelderMeadOptimizer>(100));
+  std::mt19937 gen(1234);
+  const auto gains = optimizer->optimize(
+    PIDTunerOptimizer::Bounds{0, 1, 0, 1, 0, 1},
+    [](const std::vector<PIDTuner::Output> &icandidates) {
+      std::vector<double> errors;
+      for (const auto &candidate : icandidates) {
+        errors.push_back(-candidate.kP - candidate.kI - candidate.kD);
+      }
+      return errors;
+    },
+    gen);
+
+  EXPECT_NEAR(gains.kP, 1, 1e-3);
+  EXPECT_NEAR(gains.kI, 1, 1e-3);
+  EXPECT_NEAR(gains.kD, 1, 1e-3);
+}
+
+TEST_F(SimulatedPIDTunerTest, NelderMeadConvergesInFewerTestsThanParticleSwarm) {
+  // A flywheel with less friction than the default so that good gains settle well within the
+  // timeout and the error is not dominated by tests which time out
+  const auto createLowFrictionTuner = []() {
+    return std::make_unique<SimulatedPIDTuner>(
+      Supplier<std::unique_ptr<FlywheelSimulator>>([]() {
+        auto sim = std::make_unique<FlywheelSimulator>(0.01, 1, 0.01, 0.1);
+        sim->setExternalTorqueFunction([](double, double, double) { return 0; });
+        return sim;
+      }),
+      createTimeUtil(Supplier<std::unique_ptr<SettledUtil>>(
+        []() { return createSettledUtilPtr(2, 2, 100_ms); })),
+      5_s,
+      45,
+      0,
+      0.1,
+      0,
+      0.01,
+      0,
+      0.01);
+  };
+
+  // Number of tests until the best error so far is within 5% of the best error either optimizer
+  // found for that seed
+  const auto testsToConverge = [](const std::vector<double> &ierrors, const double itarget) {
+    double best = std::numeric_limits<double>::max();
+    for (std::size_t i = 0; i < ierrors.size(); i++) {
+      best = std::min(best, ierrors.at(i));
+      if (best <= itarget) {
+        return i + 1;
+      }
+    }
+    return ierrors.size() + 1;
+  };
+
+  const std::size_t numSeeds = 5;
+  std::size_t psoTotal = 0, nmTotal = 0;
+  double psoBestTotal = 0, nmBestTotal = 0;
+  for (std::uint32_t seed = 0; seed < numSeeds; seed++) {
+    auto pso = std::make_shared<RecordingOptimizer>(std::make_shared<ParticleSwarmOptimizer>());
+    auto psoTuner = createLowFrictionTuner();
+    psoTuner->setSeed(seed);
+    psoTuner->setOptimizer(pso);
+    psoTuner->autotune();
+
+    auto nm = std::make_shared<RecordingOptimizer>(std::make_shared<NelderMeadOptimizer>());
+    auto nmTuner = createLowFrictionTuner();
+    nmTuner->setSeed(seed);
+    nmTuner->setOptimizer(nm);
+    nmTuner->autotune();
+
+    const double psoBest = *std::min_element(pso->errors.begin(), pso->errors.end());
+    const double nmBest = *std::min_element(nm->errors.begin(), nm->errors.end());
+    const double target = std::min(psoBest, nmBest) * 1.05;
+
+    psoTotal += testsToConverge(pso->errors, target);
+    nmTotal += testsToConverge(nm->errors, target);
+    psoBestTotal += psoBest;
+    nmBestTotal += nmBest;
+
+    EXPECT_EQ(psoTuner->getNumEvaluations(), pso->errors.size());
+    EXPECT_EQ(nmTuner->getNumEvaluations(), nm->errors.size());
+    EXPECT_LE(nm->errors.size(), 80);
+  }
+
+  // Nelder-Mead needs at least a quarter fewer tests and finds gains which are at least as good
+  EXPECT_LT(nmTotal * 4, psoTotal * 3);
+  EXPECT_LE(nmBestTotal, psoBestTotal);
+}
+
+/**
+ * A SimulatedPIDTuner which loses power after a number of batches of tests.
+ */
+class InterruptedSimulatedPIDTuner : public SimulatedPIDTuner {
+  public:
+  using SimulatedPIDTuner::SimulatedPIDTuner;
+
+  std::vector<double> evaluateCandidates(const std::vector<Output> &icandidates) override {
+    if (batchesUntilInterrupt-- == 0) {
+      throw std::runtime_error("Brownout");
+    }
+
+    firstTestNumbers.push_back(numEvaluations);
+    return SimulatedPIDTuner::evaluateCandidates(icandidates);
+  }
+
+  int batchesUntilInterrupt{-1};
+  std::vector<std::size_t> firstTestNumbers;
+};
+
+class PIDTunerCheckpointTest : public ::testing::Test {
+  protected:
+  void TearDown() override {
+    std::remove(checkpointFile);
+  }
+
+  static std::unique_ptr<InterruptedSimulatedPIDTuner> createTuner(const double ikPMax = 0.01) {
+    auto tuner = std::make_unique<InterruptedSimulatedPIDTuner>(
+      Supplier<std::unique_ptr<FlywheelSimulator>>([]() {
+        auto sim = std::make_unique<FlywheelSimulator>();
+        sim->setExternalTorqueFunction([](double, double, double) { return 0; });
+        return sim;
+      }),
+      createTimeUtil(Supplier<std::unique_ptr<SettledUtil>>(
+        []() { return createSettledUtilPtr(2, 2, 100_ms); })),
+      2_s,
+      45,
+      0,
+      ikPMax,
+      0,
+      0.001,
+      0,
+      0.001);
+    tuner->setCheckpointFile(checkpointFile);
+    return tuner;
+  }
+
+  static constexpr const char *checkpointFile = "pidTunerCheckpointTest.bin";
+};
+
+TEST_F(PIDTunerCheckpointTest, ResumedRunMatchesUninterruptedRun) {
+  auto uninterrupted = createTuner();
+  uninterrupted->setSeed(1234);
+  const auto expected = uninterrupted->autotune();
+
+  auto interrupted = createTuner();
+  interrupted->setSeed(1234);
+  interrupted->batchesUntilInterrupt = 3;
+  EXPECT_THROW(interrupted->autotune(), std::runtime_error);
+
+  // A new tuner with a different seed, like after a restart, picks up the saved generator state
+  auto resumed = createTuner();
+  resumed->setSeed(42);
+  const auto actual = resumed->resume();
+
+  EXPECT_EQ(actual.kP, expected.kP);
+  EXPECT_EQ(actual.kI, expected.kI);
+  EXPECT_EQ(actual.kD, expected.kD);
+
+  // Test numbering continues from the checkpoint, so the goal alternates as if uninterrupted
+  EXPECT_EQ(resumed->firstTestNumbers, (std::vector<std::size_t>{3 * 16, 4 * 16}));
+  EXPECT_EQ(resumed->getNumEvaluations(), 5 * 16);
+}
+
+TEST_F(PIDTunerCheckpointTest, FailingToSaveACheckpointDoesNotStopTheRun) {
+  auto expectedTuner = createTuner();
+  expectedTuner->setCheckpointFile("");
+  expectedTuner->setSeed(1234);
+  const auto expected = expectedTuner->autotune();
+
+  auto tuner = createTuner();
+  tuner->setCheckpointFile("noSuchDirectory/pidTunerCheckpointTest.bin");
+  tuner->setSeed(1234);
+  const auto actual = tuner->autotune();
+
+  EXPECT_EQ(actual.kP, expected.kP);
+  EXPECT_EQ(actual.kI, expected.kI);
+  EXPECT_EQ(actual.kD, expected.kD);
+  EXPECT_EQ(tuner->getNumEvaluations(), 5 * 16);
+}
+
+TEST_F(PIDTunerCheckpointTest, ResumingAFinishedRunReturnsItsResult) {
+  auto tuner = createTuner();
+  tuner->setSeed(1234);
+  const auto expected = tuner->autotune();
+  auto resumed = createTuner();
+  const auto actual = resumed->resume();
+
+  EXPECT_EQ(actual.kP, expected.kP);
+  EXPECT_EQ(actual.kI, expected.kI);
+  EXPECT_EQ(actual.kD, expected.kD);
+  EXPECT_EQ(resumed->getNumEvaluations(), 5 * 16);
+}
+
+TEST_F(PIDTunerCheckpointTest, ResumeThrowsWithoutACheckpoint) {
+  EXPECT_THROW(createTuner()->resume(), std::runtime_error);
+}
+
+TEST_F(PIDTunerCheckpointTest, ResumeThrowsWithDifferentBounds) {
+  auto tuner = createTuner();
+  tuner->batchesUntilInterrupt = 2;
+  EXPECT_THROW(tuner->autotune(), std::runtime_error);
+
+  EXPECT_THROW(createTuner(0.02)->resume(), std::runtime_error);
+}
+
+TEST_F(PIDTunerCheckpointTest, ResumeThrowsWithACorruptCheckpoint) {
+  std::FILE *file = std::fopen(checkpointFile, "wb");
+  std::fputs("not a checkpoint", file);
+  std::fclose(file);
+
+  EXPECT_THROW(createTuner()->resume(), std::runtime_error);
+}
+
+TEST_F(PIDTunerCheckpointTest, NelderMeadDoesNotSupportCheckpoints) {
+  auto tuner = createTuner();
+  tuner->setOptimizer(std::make_shared<NelderMeadOptimizer>());
+  EXPECT_THROW(tuner->setCheckpointFile(checkpointFile), std::invalid_argument);
+  EXPECT_THROW(tuner->resume(), std::invalid_argument);
+}
+
+TEST(RelayTunerTest, ZieglerNicholsGains) {
+  const auto gains = RelayTuner::computeGains(2, 500_ms, RelayTuner::TuningRule::zieglerNichols);
+  EXPECT_DOUBLE_EQ(gains.kP, 1.2);
+  EXPECT_DOUBLE_EQ(gains.kI, 1.2 / 0.25);
+  EXPECT_DOUBLE_EQ(gains.kD, 1.2 * 0.5 / 8);
+}
+
+TEST(RelayTunerTest, TyreusLuybenPIGains) {
+  const auto gains = RelayTuner::computeGains(3.2, 1_s, RelayTuner::TuningRule::tyreusLuybenPI);
+  EXPECT_DOUBLE_EQ(gains.kP, 1);
+  EXPECT_DOUBLE_EQ(gains.kI, 1 / 2.2);
+  EXPECT_DOUBLE_EQ(gains.kD, 0);
+}
+
+/**
+ * A flywheel which steps once each time its output is set, so a loop using a NoDelayRate runs in
+ * virtual time. Reads in degrees.
+ */
+class VirtualTimeFlywheel : public ControllerInput<double>, public ControllerOutput<double> {
+  public:
+  VirtualTimeFlywheel() {
+    simulator.setExternalTorqueFunction([](double, double, double) { return 0; });
+  }
+
+  double controllerGet() override {
+    return simulator.getAngle() * radianToDegree;
+  }
+
+  void controllerSet(const double ivalue) override {
+    simulator.step(ivalue * simulator.getMaxTorque());
+    steps++;
+  }
+
+  FlywheelSimulator simulator{0.01, 1, 0.01, 0.1};
+  std::size_t steps{0};
+};
+
+TEST(RelayTunerTest, TunesFlywheelSimulatorInVirtualTime) {
+  auto flywheel = std::make_shared<VirtualTimeFlywheel>();
+  RelayTuner tuner(
+    flywheel,
+    flywheel,
+    createTimeUtil(Supplier<std::unique_ptr<AbstractRate>>(
+      []() { return std::make_unique<NoDelayRate>(); })),
+    45,
+    0.5,
+    1,
+    3,
+    60_s);
+  const auto result = tuner.autotune(RelayTuner::TuningRule::tyreusLuyben);
+
+  EXPECT_GT(result.ultimateGain, 0);
+  EXPECT_GT(result.ultimatePeriod, 0_ms);
+  EXPECT_GT(result.amplitude, 1);
+  EXPECT_LT(result.duration, 60_s);
+  // The last step sets the output to zero
+  EXPECT_EQ(result.duration.convert(millisecond), (flywheel->steps - 1) * 10);
+
+  const auto expected = RelayTuner::computeGains(
+    result.ultimateGain, result.ultimatePeriod, RelayTuner::TuningRule::tyreusLuyben);
+  EXPECT_DOUBLE_EQ(result.gains.kP, expected.kP);
+  EXPECT_DOUBLE_EQ(result.gains.kI, expected.kI);
+  EXPECT_DOUBLE_EQ(result.gains.kD, expected.kD);
+
+  FlywheelSimulator sim(0.01, 1, 0.01, 0.1);
+  sim.setExternalTorqueFunction([](double, double, double) { return 0; });
+  IterativePosPIDController controller(0, 0, 0, 0, createConstantTimeUtil(10_ms));
+  controller.setGains(result.gains.kP, result.gains.kI, result.gains.kD);
+  controller.setTarget(45);
+
+  for (std::size_t i = 0; i < 2000; i++) {
+    sim.step(controller.step(sim.getAngle() * radianToDegree) * sim.getMaxTorque());
+  }
+
+  EXPECT_NEAR(sim.getAngle() * radianToDegree, 45, 2);
+}
+
+TEST(RelayTunerTest, ThrowsIfTheSystemDoesNotOscillate) {
+  auto input = std::make_shared<VirtualTimeFlywheel>();
+  auto output = std::make_shared<VirtualTimeFlywheel>();
+  RelayTuner tuner(input,
+                   output,
+                   createTimeUtil(Supplier<std::unique_ptr<AbstractRate>>(
+                     []() { return std::make_unique<NoDelayRate>(); })),
+                   45,
+                   0.5,
+                   0,
+                   3,
+                   1_s);
+
+  EXPECT_THROW(tuner.autotune(), std::runtime_error);
+  EXPECT_EQ(output->steps, 101); // Including setting the output to zero
+}
+
+class ControllerSweepTest : public ::testing::Test {
+  protected:
+  static std::unique_ptr<ControllerSweep> createSweep(const std::size_t inumThreads) {
+    auto sweep = std::make_unique<ControllerSweep>(
+      Supplier<std::unique_ptr<FlywheelSimulator>>([]() {
+        auto sim = std::make_unique<FlywheelSimulator>(0.01, 1, 0.01, 0.1);
+        sim->setExternalTorqueFunction([](double, double, double) { return 0; });
+        return sim;
+      }),
+      Supplier<std::unique_ptr<IterativePosPIDController>>([]() {
+        return std::make_unique<IterativePosPIDController>(
+          0.02, 0, 0.0005, 0, createConstantTimeUtil(10_ms));
+      }),
+      createTimeUtil(Supplier<std::unique_ptr<SettledUtil>>(
+        []() { return createSettledUtilPtr(2, 2, 100_ms); })),
+      45,
+      5_s,
+      10_ms,
+      inumThreads);
+    sweep->setSeed(1234);
+    return sweep;
+  }
+};
+
+TEST_F(ControllerSweepTest, ResultsDoNotDependOnThreadCount) {
+  auto serial = createSweep(1);
+  auto parallel = createSweep(8);
+  for (auto *sweep : {serial.get(), parallel.get()}) {
+    sweep->setDistribution(ControllerSweep::Parameter::batteryVoltage,
+                           ControllerSweep::Distribution::uniform(6, 12));
+    sweep->setDistribution(ControllerSweep::Parameter::muDynamic,
+                           ControllerSweep::Distribution::normal(0.1, 0.03));
+  }
+
+  const auto serialTrials = serial->run(40);
+  const auto parallelTrials = parallel->run(40);
+
+  ASSERT_EQ(serialTrials.size(), 40);
+  ASSERT_EQ(parallelTrials.size(), 40);
+  for (std::size_t i = 0; i < serialTrials.size(); i++) {
+    EXPECT_EQ(serialTrials[i].parameters, parallelTrials[i].parameters);
+    EXPECT_EQ(serialTrials[i].settled, parallelTrials[i].settled);
+    EXPECT_EQ(serialTrials[i].settleTime, parallelTrials[i].settleTime);
+    EXPECT_EQ(serialTrials[i].overshoot, parallelTrials[i].overshoot);
+    EXPECT_EQ(serialTrials[i].itae, parallelTrials[i].itae);
+  }
+}
+
+TEST_F(ControllerSweepTest, UnsweptParametersKeepTheSimulatorValues) {
+  auto sweep = createSweep(2);
+  sweep->setDistribution(ControllerSweep::Parameter::mass,
+                         ControllerSweep::Distribution::uniform(0.01, 0.02));
+  const auto trials = sweep->run(10);
+
+  for (const auto &trial : trials) {
+    EXPECT_EQ(trial.parameters[0], 12);
+    EXPECT_GE(trial.parameters[1], 0.01);
+    EXPECT_LE(trial.parameters[1], 0.02);
+    EXPECT_DOUBLE_EQ(trial.parameters[2], 0.01);
+    EXPECT_DOUBLE_EQ(trial.parameters[3], 0.1);
+    EXPECT_TRUE(trial.settled);
+  }
+}
+
+TEST_F(ControllerSweepTest, LowBatteryVoltageSettlesSlower) {
+  auto sweep = createSweep(4);
+  sweep->setDistribution(ControllerSweep::Parameter::batteryVoltage,
+                         ControllerSweep::Distribution::uniform(6, 12));
+  const auto buckets =
+    ControllerSweep::summarize(sweep->run(100), ControllerSweep::Parameter::batteryVoltage, 2);
+
+  ASSERT_EQ(buckets.size(), 2);
+  EXPECT_EQ(buckets[0].count + buckets[1].count, 100);
+  EXPECT_EQ(buckets[0].upper, buckets[1].lower);
+  EXPECT_GT(buckets[0].settleTime.mean, buckets[1].settleTime.mean);
+  EXPECT_LT(buckets[0].overshoot.mean, buckets[1].overshoot.mean);
+  EXPECT_GT(buckets[0].itae.mean, buckets[1].itae.mean);
+}
+
+TEST_F(ControllerSweepTest, HeavierMassSettlesSlower) {
+  auto sweep = createSweep(4);
+  sweep->setDistribution(ControllerSweep::Parameter::mass,
+                         ControllerSweep::Distribution::uniform(0.01, 0.04));
+  const auto buckets =
+    ControllerSweep::summarize(sweep->run(100), ControllerSweep::Parameter::mass, 2);
+
+  ASSERT_EQ(buckets.size(), 2);
+  EXPECT_EQ(buckets[0].count + buckets[1].count, 100);
+  EXPECT_EQ(buckets[0].settledFraction, 1);
+  EXPECT_EQ(buckets[1].settledFraction, 1);
+  EXPECT_LT(buckets[0].settleTime.mean, buckets[1].settleTime.mean);
+}
+
+TEST_F(ControllerSweepTest, InvalidArgumentsThrow) {
+  auto sweep = createSweep(1);
+  EXPECT_THROW(sweep->setDistribution(ControllerSweep::Parameter::mass,
+                                      ControllerSweep::Distribution::uniform(2, 1)),
+               std::invalid_argument);
+  EXPECT_THROW(sweep->setDistribution(ControllerSweep::Parameter::mass,
+                                      ControllerSweep::Distribution::normal(1, -1)),
+               std::invalid_argument);
+  EXPECT_THROW(ControllerSweep::summarize({}, ControllerSweep::Parameter::mass, 0),
+               std::invalid_argument);
+}
+
+TEST(ControllerSweepStatisticsTest, ComputeStatistics) {
+  const auto stats = ControllerSweep::computeStatistics({5, 1, 4, 2, 3});
+  EXPECT_DOUBLE_EQ(stats.mean, 3);
+  EXPECT_DOUBLE_EQ(stats.stddev, std::sqrt(2.0));
+  EXPECT_DOUBLE_EQ(stats.min, 1);
+  EXPECT_DOUBLE_EQ(stats.median, 3);
+  EXPECT_DOUBLE_EQ(stats.p95, 5);
+  EXPECT_DOUBLE_EQ(stats.max, 5);
+
+  EXPECT_DOUBLE_EQ(ControllerSweep::computeStatistics({1, 2, 3, 4}).median, 2.5);
+  EXPECT_DOUBLE_EQ(ControllerSweep::computeStatistics({}).mean, 0);
+}
+
+TEST_F(ControllerSweepTest, DISABLED_BenchmarkTrialsPerSecond) {
+  const std::size_t numTrials = 1000;
+  for (const std::size_t numThreads : {std::size_t{1}, std::size_t{4}}) {
+    auto sweep = createSweep(numThreads);
+    sweep->setDistribution(ControllerSweep::Parameter::batteryVoltage,
+                           ControllerSweep::Distribution::uniform(6, 12));
+    sweep->setDistribution(ControllerSweep::Parameter::muStatic,
+                           ControllerSweep::Distribution::uniform(0, 0.02));
+    sweep->setDistribution(ControllerSweep::Parameter::muDynamic,
+                           ControllerSweep::Distribution::normal(0.1, 0.03));
+
+    std::vector<ControllerSweep::Trial> trials;
+    const double ns = benchmarkNsPerCall([&]() { trials = sweep->run(numTrials); }, 1);
+    std::cout << numThreads << " thread(s): " << numTrials / (ns / 1e9) << " trials per second"
+              << std::endl;
+
+    for (const auto &bucket :
+         ControllerSweep::summarize(trials, ControllerSweep::Parameter::batteryVoltage, 3)) {
+      std::cout << "  " << bucket.lower << " V to " << bucket.upper << " V: " << bucket.count
+                << " trials, " << bucket.settledFraction * 100 << "% settled, settle time "
+                << bucket.settleTime.mean << " s (p95 " << bucket.settleTime.p95
+                << " s), overshoot " << bucket.overshoot.mean << " deg, ITAE "
+                << bucket.itae.mean << std::endl;
+    }
+
+    EXPECT_EQ(trials.size(), numTrials);
+  }
+}
+
 TEST(SettledUtilTest, MaxDoubleError) {
   MockRate rate;
   SettledUtil settledUtil(
@@ -170,3 +796,202 @@ TEST(SettledUtilTest, LargeErrorSignChangeWithConstantTimer) {
   EXPECT_FALSE(settledUtil.isSettled(-50000));
   EXPECT_FALSE(settledUtil.isSettled(50000));
 }
+
+TEST(SettledUtilTest, SettlesWithTimestamps) {
+  SettledUtil settledUtil(std::make_unique<ConstantMockTimer>(0_ms), 50, 5, 250_ms);
+  EXPECT_FALSE(settledUtil.isSettled(0, 0_ms));
+  EXPECT_FALSE(settledUtil.isSettled(0, 250_ms));
+  EXPECT_TRUE(settledUtil.isSettled(0, 251_ms));
+
+  // Leaving the target range clears the mark
+  EXPECT_FALSE(settledUtil.isSettled(100, 300_ms));
+  EXPECT_FALSE(settledUtil.isSettled(100, 600_ms));
+}
+
+TEST(SettledUtilTest, ResetClearsTimestampMark) {
+  SettledUtil settledUtil(std::make_unique<ConstantMockTimer>(0_ms), 50, 5, 250_ms);
+  EXPECT_FALSE(settledUtil.isSettled(0, 0_ms));
+  settledUtil.reset();
+  EXPECT_FALSE(settledUtil.isSettled(0, 300_ms));
+  EXPECT_TRUE(settledUtil.isSettled(0, 551_ms));
+}
+
+TEST(FeedforwardTest, Calculate) {
+  Feedforward feedforward({1, 2, 3, 4});
+  EXPECT_DOUBLE_EQ(feedforward.calculate(0.5, 0.25, 0.1), 1 + 2 * 0.5 + 3 * 0.25 + 4 * 0.1);
+  EXPECT_DOUBLE_EQ(feedforward.calculate(-0.5, 0, 0), -1 + 2 * -0.5);
+  EXPECT_DOUBLE_EQ(feedforward.calculate(0, 0, 0), 0);
+}
+
+TEST(FeedforwardTest, CharacterizeRecoversGains) {
+  const Feedforward::Gains truth{500, 6000, 1500, 0};
+  Feedforward model(truth);
+
+  std::vector<Feedforward::Sample> samples;
+  for (int i = -10; i <= 10; i++) {
+    const double velocity = i * 0.1;
+    const double acceleration = (i % 3) * 0.5;
+    samples.push_back({velocity, acceleration, model.calculate(velocity, acceleration)});
+  }
+
+  const auto gains = Feedforward::characterize(samples);
+  EXPECT_NEAR(gains.kS, truth.kS, 1e-6);
+  EXPECT_NEAR(gains.kV, truth.kV, 1e-6);
+  EXPECT_NEAR(gains.kA, truth.kA, 1e-6);
+  EXPECT_EQ(gains.kP, 0);
+}
+
+TEST(FeedforwardTest, CharacterizeWithoutAccelerationThrows) {
+  std::vector<Feedforward::Sample> samples{{0.5, 0, 3500}, {1, 0, 6500}, {-1, 0, -6500}};
+  EXPECT_THROW(Feedforward::characterize(samples), std::invalid_argument);
+}
+
+TEST(RamseteTest, NoErrorGivesThePathVelocities) {
+  Ramsete ramsete(Ramsete::Gains{});
+  const OdomState pose{1_m, 2_m, 30_deg};
+
+  const auto output = ramsete.calculate(pose, pose, 1.5, 0.5);
+  EXPECT_NEAR(output.velocity, 1.5, 1e-12);
+  EXPECT_NEAR(output.angularVelocity, 0.5, 1e-12);
+}
+
+TEST(RamseteTest, CorrectsErrorsInTheChassisFrame) {
+  Ramsete ramsete(Ramsete::Gains{});
+
+  // Behind the target, so speed up
+  auto output = ramsete.calculate(OdomState{0_m, 0_m, 90_deg}, OdomState{0_m, 0.1_m, 90_deg}, 1, 0);
+  EXPECT_GT(output.velocity, 1);
+  EXPECT_NEAR(output.angularVelocity, 0, 1e-12);
+
+  // The target is to the right of the chassis, so turn right (clockwise)
+  output = ramsete.calculate(OdomState{0_m, 0_m, 90_deg}, OdomState{0.1_m, 0_m, 90_deg}, 1, 0);
+  EXPECT_NEAR(output.velocity, 1, 1e-12);
+  EXPECT_LT(output.angularVelocity, 0);
+
+  // Facing left of the target heading, so turn right
+  output = ramsete.calculate(OdomState{0_m, 0_m, 10_deg}, OdomState{0_m, 0_m, 0_deg}, 1, 0);
+  EXPECT_LT(output.velocity, 1);
+  EXPECT_LT(output.angularVelocity, 0);
+}
+
+TEST(RamseteTest, HeadingErrorIsWrapped) {
+  Ramsete ramsete(Ramsete::Gains{});
+
+  // 350 degrees is 10 degrees clockwise of 0, so turn counterclockwise the short way
+  const auto output =
+    ramsete.calculate(OdomState{0_m, 0_m, 350_deg}, OdomState{0_m, 0_m, 0_deg}, 1, 0);
+  EXPECT_GT(output.angularVelocity, 0);
+  EXPECT_LT(output.angularVelocity, 1);
+}
+
+TEST(RamseteTest, InvalidGainsThrow) {
+  EXPECT_THROW(Ramsete(Ramsete::Gains{0, 0.7}), std::invalid_argument);
+  EXPECT_THROW(Ramsete(Ramsete::Gains{2, 0}), std::invalid_argument);
+  EXPECT_THROW(Ramsete(Ramsete::Gains{2, 1}), std::invalid_argument);
+}
+
+/**
+ * Generates the trajectory of the center of a chassis with pathfinder.
+ */
+static std::vector<Segment> generatePathfinderTrajectory(std::vector<Waypoint> iwaypoints,
+                                                         const double imaxVel) {
+  TrajectoryCandidate candidate;
+  pathfinder_prepare(iwaypoints.data(),
+                     static_cast<int>(iwaypoints.size()),
+                     FIT_HERMITE_CUBIC,
+                     PATHFINDER_SAMPLES_FAST,
+                     0.001,
+                     imaxVel,
+                     2,
+                     10,
+                     &candidate);
+
+  std::vector<Segment> trajectory(candidate.length);
+  pathfinder_generate(&candidate, trajectory.data());
+  return trajectory;
+}
+
+/**
+ * @return the fastest either side of a skid steer chassis goes along a trajectory
+ */
+static double maxWheelVelocity(std::vector<Segment> itrajectory, const double iwidth) {
+  std::vector<Segment> left(itrajectory.size());
+  std::vector<Segment> right(itrajectory.size());
+  pathfinder_modify_tank(itrajectory.data(),
+                         static_cast<int>(itrajectory.size()),
+                         left.data(),
+                         right.data(),
+                         iwidth);
+
+  double max = 0;
+  for (std::size_t i = 0; i < itrajectory.size(); i++) {
+    max = std::max({max, std::abs(left[i].velocity), std::abs(right[i].velocity)});
+  }
+  return max;
+}
+
+TEST(PathVelocityPlannerTest, InvalidLimitsThrow) {
+  EXPECT_THROW(PathVelocityPlanner({0, 2, 1, 0.3}, 0.005), std::invalid_argument);
+  EXPECT_THROW(PathVelocityPlanner({1, 0, 1, 0.3}, 0.005), std::invalid_argument);
+  EXPECT_THROW(PathVelocityPlanner({1, 2, 0, 0.3}, 0.005), std::invalid_argument);
+  EXPECT_THROW(PathVelocityPlanner({1, 2, 1, 0}, 0.005), std::invalid_argument);
+  EXPECT_THROW(PathVelocityPlanner({1, 2, 1, 0.3}, 0), std::invalid_argument);
+}
+
+TEST(PathVelocityPlannerTest, StraightPathRunsAtFullSpeed) {
+  const auto trajectory = generatePathfinderTrajectory({{0, 0, 0}, {2, 0, 0}}, 1);
+  const PathVelocityPlanner planner({1, 2, 1, 0.3}, 0.005);
+  const auto planned =
+    planner.plan(trajectory.data(), static_cast<int>(trajectory.size()), 0.001);
+
+  double maxVelocity = 0;
+  for (std::size_t i = 1; i < planned.size(); i++) {
+    EXPECT_GE(planned[i].position, planned[i - 1].position);
+    maxVelocity = std::max(maxVelocity, planned[i].velocity);
+  }
+
+  EXPECT_NEAR(maxVelocity, 1, 1e-9);
+  EXPECT_DOUBLE_EQ(planned.front().velocity, 0);
+  EXPECT_NEAR(planned.back().velocity, 0, 1e-9);
+  EXPECT_NEAR(planned.back().position, trajectory.back().position, 1e-9);
+  EXPECT_NEAR(planned.back().x, 2, 1e-3);
+  EXPECT_NEAR(planned.back().y, 0, 1e-3);
+
+  // Accelerate for 0.5 s, cruise for 1.5 s, then decelerate for 0.5 s
+  EXPECT_NEAR(planned.size() * 0.001, 2.5, 0.01);
+}
+
+TEST(PathVelocityPlannerTest, CurvesDoNotExceedTheWheelSpeed) {
+  const double width = 0.3;
+  const auto trajectory = generatePathfinderTrajectory({{0, 0, 0}, {1, 1, pi / 2}}, 1);
+  const PathVelocityPlanner planner({1, 2, 1, width}, 0.005);
+  const auto planned =
+    planner.plan(trajectory.data(), static_cast<int>(trajectory.size()), 0.001);
+
+  EXPECT_GT(maxWheelVelocity(trajectory, width), 1.05);
+  EXPECT_LT(maxWheelVelocity(planned, width), 1.01);
+  EXPECT_NEAR(planned.back().x, 1, 1e-3);
+  EXPECT_NEAR(planned.back().y, 1, 1e-3);
+  EXPECT_NEAR(planned.back().heading, pi / 2, 1e-3);
+}
+
+TEST(PathVelocityPlannerTest, FasterThanLoweringTheMaximumVelocity) {
+  const double width = 0.3;
+  const std::vector<Waypoint> waypoints{{0, 0, 0}, {1.5, 0.5, 0}, {2.5, 0, -pi / 2}};
+
+  // Lower the maximum velocity of the whole path until the wheels stay under their limit
+  double maxVel = 1;
+  auto uniform = generatePathfinderTrajectory(waypoints, maxVel);
+  while (maxWheelVelocity(uniform, width) > 1.01) {
+    maxVel -= 0.02;
+    uniform = generatePathfinderTrajectory(waypoints, maxVel);
+  }
+
+  const auto trajectory = generatePathfinderTrajectory(waypoints, 1);
+  const PathVelocityPlanner planner({1, 2, 1, width}, 0.005);
+  const auto planned =
+    planner.plan(trajectory.data(), static_cast<int>(trajectory.size()), 0.001);
+
+  EXPECT_LT(maxWheelVelocity(planned, width), 1.01);
+  EXPECT_LT(planned.size(), uniform.size());
+}
@@ -5,17 +5,31 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this
  * file, You can obtain one at http://mozilla.org/MPL/2.0/.
  */
+#include "okapi/api/control/iterative/iterativePosPidController.hpp"
+#include "okapi/api/control/iterative/iterativeVelPidController.hpp"
 #include "okapi/api/filter/averageFilter.hpp"
+#include "okapi/api/filter/biquadFilter.hpp"
 #include "okapi/api/filter/composableFilter.hpp"
 #include "okapi/api/filter/demaFilter.hpp"
 #include "okapi/api/filter/ekfFilter.hpp"
 #include "okapi/api/filter/emaFilter.hpp"
+#include "okapi/api/filter/filterChain.hpp"
+#include "okapi/api/filter/filteredControllerInput.hpp"
+#include "okapi/api/filter/kalmanFilter.hpp"
 #include "okapi/api/filter/medianFilter.hpp"
 #include "okapi/api/filter/passthroughFilter.hpp"
+#include "okapi/api/filter/runningAverageFilter.hpp"
+#include "okapi/api/filter/savitzkyGolayVelMath.hpp"
+#include "okapi/api/filter/slidingMedianFilter.hpp"
 #include "okapi/api/filter/velMath.hpp"
 #include "okapi/api/util/abstractTimer.hpp"
 #include "test/tests/api/implMocks.hpp"
+#include <functional>
 #include <gtest/gtest.h>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <random>
 
 using namespace okapi;
 
@@ -69,6 +83,146 @@ TEST(MedianFilterTest, OutputTest) {
   }
 }
 
+TEST(RunningAverageFilterTest, OutputTest) {
+  RunningAverageFilter<5> filter;
+
+  const double expected[] = {0, 0.2, 0.6, 1.2};
+  for (int i = 0; i < 10; i++) {
+    assertThatFilterAndFilterOutputAreEqual(filter, i, i < 4 ? expected[i] : i - 2);
+  }
+}
+
+TEST(RunningAverageFilterTest, MatchesAverageFilter) {
+  AverageFilter<7> reference;
+  RunningAverageFilter<7> filter;
+  std::mt19937 gen(1234);
+  std::uniform_real_distribution<double> dist(-1000, 1000);
+
+  for (int i = 0; i < 10000; i++) {
+    const double reading = dist(gen);
+    EXPECT_NEAR(filter.filter(reading), reference.filter(reading), 1e-9);
+  }
+}
+
+TEST(RunningAverageFilterTest, RunningSumDoesNotDrift) {
+  DynamicRunningAverageFilter filter(10);
+  std::mt19937 gen(1234);
+  std::uniform_real_distribution<double> dist(-1, 1);
+
+  // A large offset with small changes loses precision quickly in a running sum
+  for (int i = 0; i < 1000000; i++) {
+    filter.filter(1e8 + dist(gen));
+  }
+
+  for (int i = 0; i < 10; i++) {
+    filter.filter(0.5);
+  }
+
+  EXPECT_EQ(filter.getOutput(), 0.5);
+}
+
+TEST(RunningAverageFilterTest, RuntimeWindowSize) {
+  DynamicRunningAverageFilter filter(3);
+  EXPECT_EQ(filter.getWindowSize(), 3);
+  assertThatFilterAndFilterOutputAreEqual(filter, 3, 1);
+  assertThatFilterAndFilterOutputAreEqual(filter, 3, 2);
+  assertThatFilterAndFilterOutputAreEqual(filter, 3, 3);
+  assertThatFilterAndFilterOutputAreEqual(filter, 6, 4);
+
+  EXPECT_THROW(DynamicRunningAverageFilter(0), std::invalid_argument);
+}
+
+TEST(SlidingMedianFilterTest, OutputTest) {
+  SlidingMedianFilter<5> filter;
+
+  for (int i = 0; i < 10; i++) {
+    assertThatFilterAndFilterOutputAreEqual(filter, i, i < 3 ? 0 : i - 2);
+  }
+}
+
+template <std::size_t n> void expectSlidingMedianMatchesMedianFilter() {
+  MedianFilter<n> reference;
+  SlidingMedianFilter<n> filter;
+  std::mt19937 gen(n);
+
+  // Readings from a small range repeat often, which exercises equal readings around the median
+  std::uniform_int_distribution<int> dist(-5, 5);
+
+  for (int i = 0; i < 2000; i++) {
+    const double reading = dist(gen);
+    ASSERT_EQ(filter.filter(reading), reference.filter(reading)) << "n = " << n << ", i = " << i;
+  }
+}
+
+TEST(SlidingMedianFilterTest, MatchesMedianFilter) {
+  expectSlidingMedianMatchesMedianFilter<1>();
+  expectSlidingMedianMatchesMedianFilter<2>();
+  expectSlidingMedianMatchesMedianFilter<3>();
+  expectSlidingMedianMatchesMedianFilter<4>();
+  expectSlidingMedianMatchesMedianFilter<5>();
+  expectSlidingMedianMatchesMedianFilter<10>();
+  expectSlidingMedianMatchesMedianFilter<11>();
+  expectSlidingMedianMatchesMedianFilter<20>();
+}
+
+TEST(SlidingMedianFilterTest, CopiesAreIndependent) {
+  DynamicSlidingMedianFilter filter(3);
+  filter.filter(5);
+  filter.filter(6);
+
+  DynamicSlidingMedianFilter copy(filter);
+  EXPECT_EQ(filter.filter(7), 6);
+  EXPECT_EQ(copy.filter(1), 5);
+
+  copy = filter;
+  EXPECT_EQ(copy.filter(8), 7);
+  EXPECT_EQ(filter.getOutput(), 6);
+}
+
+TEST(SlidingMedianFilterTest, RuntimeWindowSize) {
+  DynamicSlidingMedianFilter filter(4);
+  EXPECT_EQ(filter.getWindowSize(), 4);
+  assertThatFilterAndFilterOutputAreEqual(filter, 4, 0);
+  assertThatFilterAndFilterOutputAreEqual(filter, 3, 0);
+  assertThatFilterAndFilterOutputAreEqual(filter, 2, 2);
+  assertThatFilterAndFilterOutputAreEqual(filter, 1, 2);
+
+  EXPECT_THROW(DynamicSlidingMedianFilter(0), std::invalid_argument);
+}
+
+template <std::size_t n> void benchmarkWindowFilters() {
+  std::mt19937 gen(1234);
+  std::uniform_real_distribution<double> dist(-1000, 1000);
+  std::vector<double> readings(4096);
+  for (auto &reading : readings) {
+    reading = dist(gen);
+  }
+
+  const auto nsPerReading = [&](Filter &ifilter) {
+    std::size_t i = 0;
+    return benchmarkNsPerCall([&]() { ifilter.filter(readings[i++ % readings.size()]); }, 20000);
+  };
+
+  AverageFilter<n> average;
+  RunningAverageFilter<n> runningAverage;
+  MedianFilter<n> median;
+  SlidingMedianFilter<n> slidingMedian;
+
+  std::cout << "Window of " << n << ": AverageFilter " << nsPerReading(average)
+            << " ns, RunningAverageFilter " << nsPerReading(runningAverage)
+            << " ns, MedianFilter " << nsPerReading(median) << " ns, SlidingMedianFilter "
+            << nsPerReading(slidingMedian) << " ns per reading" << std::endl;
+
+  EXPECT_NEAR(runningAverage.getOutput(), average.getOutput(), 1e-9);
+  EXPECT_EQ(slidingMedian.getOutput(), median.getOutput());
+}
+
+TEST(SlidingWindowFilterTest, DISABLED_BenchmarkAgainstAverageAndMedianFilters) {
+  benchmarkWindowFilters<10>();
+  benchmarkWindowFilters<20>();
+  benchmarkWindowFilters<100>();
+}
+
 TEST(EmaFilterTest, FloatingPointGainOutputTest) {
   EmaFilter filter(0.5);
 
@@ -174,6 +328,109 @@ TEST(PassthroughFilterTest, OutputTest) {
   }
 }
 
+std::vector<double> createNoisyReadings(const std::size_t icount) {
+  std::mt19937 gen(42);
+  std::normal_distribution<double> noise(0, 5);
+  std::vector<double> readings(icount);
+  for (std::size_t i = 0; i < icount; i++) {
+    readings[i] = 0.1 * i + noise(gen);
+  }
+  return readings;
+}
+
+/**
+ * Filters the same readings one at a time and in batches (out of place, then in place) with two
+ * filters made the same way and checks that the outputs and final states are exactly the same.
+ */
+void testBatchMatchesScalar(const std::function<std::unique_ptr<Filter>()> &imake) {
+  const auto readings = createNoisyReadings(1000);
+  auto scalar = imake();
+  auto batch = imake();
+
+  std::vector<double> expected(readings.size());
+  for (std::size_t i = 0; i < readings.size(); i++) {
+    expected[i] = scalar->filter(readings[i]);
+  }
+
+  const std::size_t half = readings.size() / 2;
+  std::vector<double> actual(readings);
+  batch->filterBatch(readings.data(), actual.data(), half);
+  batch->filterBatch(actual.data() + half, actual.data() + half, readings.size() - half);
+
+  for (std::size_t i = 0; i < readings.size(); i++) {
+    EXPECT_EQ(actual[i], expected[i]) << "at reading " << i;
+  }
+  EXPECT_EQ(batch->getOutput(), scalar->getOutput());
+
+  // The state carries on after a batch
+  EXPECT_EQ(batch->filter(1.5), scalar->filter(1.5));
+}
+
+TEST(FilterBatchTest, BatchMatchesScalar) {
+  testBatchMatchesScalar([]() { return std::make_unique<PassthroughFilter>(); });
+  testBatchMatchesScalar([]() { return std::make_unique<EmaFilter>(0.3); });
+  testBatchMatchesScalar([]() { return std::make_unique<DemaFilter>(0.3, 0.1); });
+  testBatchMatchesScalar([]() { return std::make_unique<EKFFilter>(0.0001, 0.04); });
+  testBatchMatchesScalar([]() { return std::make_unique<AverageFilter<5>>(); });
+  testBatchMatchesScalar([]() { return std::make_unique<MedianFilter<5>>(); });
+  testBatchMatchesScalar([]() { return std::make_unique<RunningAverageFilter<5>>(); });
+  testBatchMatchesScalar([]() { return std::make_unique<SlidingMedianFilter<5>>(); });
+  testBatchMatchesScalar([]() {
+    return std::make_unique<ComposableFilter>(std::initializer_list<std::shared_ptr<Filter>>{
+      std::make_shared<MedianFilter<3>>(), std::make_shared<EmaFilter>(0.5)});
+  });
+}
+
+TEST(FilterBatchTest, EmptyBatchDoesNotChangeTheState) {
+  EmaFilter filter(0.5);
+  filter.filter(2);
+  filter.filterBatch(nullptr, nullptr, 0);
+  EXPECT_EQ(filter.getOutput(), 1);
+
+  EKFFilter ekf;
+  ekf.filter(2);
+  const double output = ekf.getOutput();
+  ekf.filterBatch(nullptr, nullptr, 0);
+  EXPECT_EQ(ekf.getOutput(), output);
+}
+
+TEST(FilterBatchTest, ComposableFilterWithNoFiltersOutputsZero) {
+  ComposableFilter filter({});
+  std::vector<double> values{1, 2, 3};
+  filter.filterBatch(values.data(), values.data(), values.size());
+  EXPECT_EQ(values, std::vector<double>({0, 0, 0}));
+}
+
+TEST(FilterBatchTest, DISABLED_BenchmarkBatchAgainstScalar) {
+  const auto readings = createNoisyReadings(100000);
+  std::vector<double> output(readings.size());
+
+  const auto compare = [&](const std::string &iname, Filter &iscalar, Filter &ibatch) {
+    const double scalarNs = benchmarkNsPerCall(
+      [&]() {
+        for (std::size_t i = 0; i < readings.size(); i++) {
+          output[i] = iscalar.filter(readings[i]);
+        }
+      },
+      10);
+    const double batchNs = benchmarkNsPerCall(
+      [&]() { ibatch.filterBatch(readings.data(), output.data(), readings.size()); }, 10);
+
+    std::cout << iname << ": " << scalarNs / readings.size() << " ns per reading one at a time, "
+              << batchNs / readings.size() << " ns per reading in a batch" << std::endl;
+    EXPECT_EQ(ibatch.getOutput(), iscalar.getOutput());
+  };
+
+  PassthroughFilter passthrough1, passthrough2;
+  compare("PassthroughFilter", passthrough1, passthrough2);
+  EmaFilter ema1(0.3), ema2(0.3);
+  compare("EmaFilter", ema1, ema2);
+  DemaFilter dema1(0.3, 0.1), dema2(0.3, 0.1);
+  compare("DemaFilter", dema1, dema2);
+  EKFFilter ekf1, ekf2;
+  compare("EKFFilter", ekf1, ekf2);
+}
+
 void testVelMathFunctionality(VelMath &velMath) {
   for (int i = 0; i < 10; i++) {
     if (i == 0) {
@@ -187,6 +444,373 @@ void testVelMathFunctionality(VelMath &velMath) {
   }
 }
 
+TEST(BiquadFilterTest, ButterworthLowPassResponse) {
+  for (std::size_t order = 1; order <= 5; order++) {
+    const auto filter = BiquadFilter::butterworthLowPass(order, 10_Hz, 10_ms);
+    EXPECT_EQ(filter.getSections().size(), (order + 1) / 2);
+
+    EXPECT_NEAR(filter.getMagnitude(0.01_Hz, 10_ms), 1, 1e-6);
+    EXPECT_NEAR(filter.getMagnitude(10_Hz, 10_ms), 1 / std::sqrt(2), 1e-9);
+    EXPECT_LT(filter.getMagnitude(40_Hz, 10_ms), std::pow(0.3, order));
+  }
+}
+
+TEST(BiquadFilterTest, ButterworthHighPassResponse) {
+  for (std::size_t order = 1; order <= 4; order++) {
+    const auto filter = BiquadFilter::butterworthHighPass(order, 5_Hz, 10_ms);
+
+    EXPECT_LT(filter.getMagnitude(0.01_Hz, 10_ms), 1e-2);
+    EXPECT_NEAR(filter.getMagnitude(5_Hz, 10_ms), 1 / std::sqrt(2), 1e-9);
+    EXPECT_NEAR(filter.getMagnitude(49.99_Hz, 10_ms), 1, 1e-6);
+  }
+}
+
+TEST(BiquadFilterTest, LowPassSettlesToAConstantInput) {
+  auto filter = BiquadFilter::butterworthLowPass(4, 5_Hz, 10_ms);
+  for (int i = 0; i < 500; i++) {
+    filter.filter(3);
+  }
+  EXPECT_NEAR(filter.getOutput(), 3, 1e-9);
+
+  filter.reset();
+  EXPECT_EQ(filter.getOutput(), 0);
+  EXPECT_LT(filter.filter(3), 0.1);
+}
+
+TEST(BiquadFilterTest, HighPassRemovesAnOffset) {
+  auto filter = BiquadFilter::butterworthHighPass(2, 1_Hz, 10_ms);
+  for (int i = 0; i < 1000; i++) {
+    filter.filter(5);
+  }
+  EXPECT_NEAR(filter.getOutput(), 0, 1e-6);
+}
+
+TEST(BiquadFilterTest, NotchRemovesVibrationWithLessLagThanAveraging) {
+  // A ramp with a 10 Hz vibration on top, sampled every 10 ms
+  const auto reading = [](const int i) { return 0.5 * i + 3 * std::sin(2 * pi * 10 * i * 0.01); };
+
+  // Both filters remove the vibration: the average's window is exactly one period
+  auto notch = BiquadFilter::notch(10_Hz, 2, 10_ms);
+  AverageFilter<10> average;
+
+  const auto measure = [&](Filter &ifilter) {
+    std::vector<double> errors;
+    for (int i = 0; i < 1000; i++) {
+      const double output = ifilter.filter(reading(i));
+      if (i >= 500) {
+        errors.push_back(0.5 * i - output);
+      }
+    }
+
+    // The steady-state error on the ramp is the lag times the slope
+    const double lag = std::accumulate(errors.begin(), errors.end(), 0.0) / errors.size() / 0.5;
+    double ripple = 0;
+    for (const double error : errors) {
+      ripple = std::max(ripple, std::abs(error / 0.5 - lag));
+    }
+    return std::make_pair(lag, ripple);
+  };
+
+  const auto [notchLag, notchRipple] = measure(notch);
+  const auto [averageLag, averageRipple] = measure(average);
+
+  EXPECT_LT(notchRipple, 0.01);
+  EXPECT_LT(averageRipple, 0.01);
+  EXPECT_NEAR(averageLag, 4.5, 1e-6);
+  EXPECT_LT(notchLag, averageLag / 3);
+}
+
+TEST(BiquadFilterTest, NotchResponse) {
+  const auto filter = BiquadFilter::notch(20_Hz, 5, 10_ms);
+
+  EXPECT_NEAR(filter.getMagnitude(20_Hz, 10_ms), 0, 1e-9);
+  EXPECT_NEAR(filter.getMagnitude(0.01_Hz, 10_ms), 1, 1e-6);
+  EXPECT_NEAR(filter.getMagnitude(49.99_Hz, 10_ms), 1, 1e-6);
+}
+
+TEST(BiquadFilterTest, InvalidDesignsThrow) {
+  EXPECT_THROW(BiquadFilter({}), std::invalid_argument);
+  EXPECT_THROW(BiquadFilter::butterworthLowPass(0, 10_Hz, 10_ms), std::invalid_argument);
+  EXPECT_THROW(BiquadFilter::butterworthLowPass(2, 0_Hz, 10_ms), std::invalid_argument);
+  EXPECT_THROW(BiquadFilter::butterworthLowPass(2, 50_Hz, 10_ms), std::invalid_argument);
+  EXPECT_THROW(BiquadFilter::butterworthHighPass(2, 10_Hz, 0_ms), std::invalid_argument);
+  EXPECT_THROW(BiquadFilter::notch(10_Hz, 0, 10_ms), std::invalid_argument);
+}
+
+TEST(BiquadFilterTest, BatchMatchesScalar) {
+  testBatchMatchesScalar([]() {
+    return std::make_unique<BiquadFilter>(BiquadFilter::butterworthLowPass(5, 8_Hz, 10_ms));
+  });
+}
+
+TEST(BiquadFilterTest, WorksInVelMathAndFilteredControllerInput) {
+  VelMath velMath(360,
+                  std::make_shared<BiquadFilter>(BiquadFilter::butterworthLowPass(2, 10_Hz, 10_ms)),
+                  0_ms,
+                  std::make_unique<ConstantMockTimer>(10_ms));
+
+  // 10 ticks per 10 ms is ~166.67 rpm once the filter settles
+  for (int i = 0; i < 100; i++) {
+    velMath.step(i * 10, i * 10_ms);
+  }
+  EXPECT_NEAR(velMath.getVelocity().convert(rpm), 166.67, 0.01);
+
+  class ConstantInput : public ControllerInput<double> {
+    public:
+    double controllerGet() override {
+      return 2;
+    }
+  };
+
+  FilteredControllerInput<double, BiquadFilter> input(
+    std::make_unique<ConstantInput>(),
+    std::make_unique<BiquadFilter>(BiquadFilter::butterworthLowPass(2, 10_Hz, 10_ms)));
+  for (int i = 0; i < 100; i++) {
+    input.controllerGet();
+  }
+  EXPECT_NEAR(input.controllerGet(), 2, 1e-9);
+}
+
+TEST(FilterChainTest, OutputTest) {
+  FilterChain<AverageFilter<3>, AverageFilter<3>> filter;
+
+  // Same as the ComposableFilter test
+  assertThatFilterAndFilterOutputAreEqual(filter, 1, 0.1111);
+  assertThatFilterAndFilterOutputAreEqual(filter, 2, 0.4444);
+  assertThatFilterAndFilterOutputAreEqual(filter, 3, 1.1111);
+
+  for (int i = 4; i < 10; i++) {
+    assertThatFilterAndFilterOutputAreEqual(filter, i, i - 2);
+  }
+}
+
+TEST(FilterChainTest, MatchesComposableFilter) {
+  FilterChain<MedianFilter<5>, EmaFilter, DemaFilter> chain(
+    MedianFilter<5>(), EmaFilter(0.3), DemaFilter(0.5, 0.1));
+  ComposableFilter composable({std::make_shared<MedianFilter<5>>(),
+                               std::make_shared<EmaFilter>(0.3),
+                               std::make_shared<DemaFilter>(0.5, 0.1)});
+
+  for (const double reading : createNoisyReadings(1000)) {
+    EXPECT_EQ(chain.filter(reading), composable.filter(reading));
+  }
+  EXPECT_EQ(chain.getOutput(), composable.getOutput());
+}
+
+TEST(FilterChainTest, BatchMatchesScalar) {
+  testBatchMatchesScalar(
+    []() { return std::make_unique<FilterChain<SlidingMedianFilter<5>, EKFFilter>>(); });
+}
+
+TEST(FilterChainTest, StagesCanBeChanged) {
+  FilterChain<PassthroughFilter, EmaFilter> filter(PassthroughFilter(), EmaFilter(0));
+  filter.getStage<1>().setGains(1);
+
+  assertThatFilterAndFilterOutputAreEqual(filter, 5, 5);
+  assertThatFilterAndFilterOutputAreEqual(filter, 6, 6);
+}
+
+TEST(FilterChainTest, WorksWhereverAFilterIsUsed) {
+  VelMath velMath(360,
+                  std::make_shared<FilterChain<PassthroughFilter, PassthroughFilter>>(),
+                  10_ms,
+                  std::make_unique<ConstantMockTimer>(10_ms));
+  testVelMathFunctionality(velMath);
+
+  IterativePosPIDController controller(
+    0,
+    0,
+    0.001,
+    0,
+    createTimeUtil(),
+    std::make_unique<FilterChain<PassthroughFilter, EmaFilter>>(PassthroughFilter(), EmaFilter(1)));
+  // kD is divided by the 10 ms sample time, so a reading rising by 5 gives an output of -0.5
+  controller.step(0, 0_ms);
+  EXPECT_DOUBLE_EQ(controller.step(5, 10_ms), -0.5);
+}
+
+TEST(FilterChainTest, DISABLED_BenchmarkAgainstComposableFilter) {
+  const auto readings = createNoisyReadings(4096);
+
+  const auto nsPerReading = [&](Filter &ifilter) {
+    std::size_t i = 0;
+    return benchmarkNsPerCall([&]() { ifilter.filter(readings[i++ % readings.size()]); }, 100000);
+  };
+
+  FilterChain<MedianFilter<5>, EmaFilter, DemaFilter> chain(
+    MedianFilter<5>(), EmaFilter(0.3), DemaFilter(0.5, 0.1));
+  ComposableFilter composable({std::make_shared<MedianFilter<5>>(),
+                               std::make_shared<EmaFilter>(0.3),
+                               std::make_shared<DemaFilter>(0.5, 0.1)});
+
+  std::cout << "MedianFilter<5> -> EmaFilter -> DemaFilter: ComposableFilter "
+            << nsPerReading(composable) << " ns, FilterChain " << nsPerReading(chain)
+            << " ns per reading" << std::endl;
+
+  EXPECT_EQ(chain.getOutput(), composable.getOutput());
+}
+
+TEST(KalmanFilterTest, OneStateMatchesEKFFilter) {
+  EKFFilter ekf(0.0001, 0.04);
+  KalmanFilter<1> kalman(
+    Matrix<1, 1>{0}, Matrix<1, 1>{1}, KalmanFilter<1>::CovarianceUpdate::simple);
+
+  for (const double reading : createNoisyReadings(200)) {
+    kalman.predict(Matrix<1, 1>{1}, Matrix<1, 1>{0.0001});
+    kalman.update(Matrix<1, 1>{reading}, Matrix<1, 1>{1}, Matrix<1, 1>{0.04});
+    EXPECT_NEAR(kalman.getState()[0], ekf.filter(reading), 1e-12);
+  }
+}
+
+TEST(KalmanFilterTest, EstimatesVelocityFromPosition) {
+  // Constant velocity model: the state is position and velocity, and only position is measured
+  const double dt = 0.01;
+  const Matrix<2, 2> F{1, dt, 0, 1};
+  const Matrix<2, 2> Q{1e-6, 0, 0, 1e-4};
+  const Matrix<1, 2> H{1, 0};
+  const Matrix<1, 1> R{0.01};
+
+  KalmanFilter<2> kalman(Matrix<2, 1>{0, 0}, Matrix<2, 2>::identity());
+  std::mt19937 gen(5);
+  std::normal_distribution<double> noise(0, 0.1);
+
+  for (int i = 1; i <= 1000; i++) {
+    kalman.predict(F, Q);
+    kalman.update(Matrix<1, 1>{2 * i * dt + noise(gen)}, H, R);
+  }
+
+  EXPECT_NEAR(kalman.getState()[0], 20, 0.05);
+  EXPECT_NEAR(kalman.getState()[1], 2, 0.05);
+
+  // The Joseph form keeps the covariance symmetric
+  const auto &P = kalman.getCovariance();
+  EXPECT_NEAR(P(0, 1), P(1, 0), 1e-15);
+}
+
+TEST(KalmanFilterTest, JosephFormMatchesSimpleForm) {
+  const Matrix<2, 2> F{1, 0.01, 0, 1};
+  const Matrix<2, 2> Q{1e-6, 0, 0, 1e-4};
+  const Matrix<1, 2> H{1, 0};
+  const Matrix<1, 1> R{0.01};
+
+  KalmanFilter<2> joseph(Matrix<2, 1>{0, 0}, Matrix<2, 2>::identity());
+  KalmanFilter<2> simple(
+    Matrix<2, 1>{0, 0}, Matrix<2, 2>::identity(), KalmanFilter<2>::CovarianceUpdate::simple);
+
+  for (const double reading : createNoisyReadings(100)) {
+    joseph.predict(F, Q);
+    simple.predict(F, Q);
+    joseph.update(Matrix<1, 1>{reading}, H, R);
+    simple.update(Matrix<1, 1>{reading}, H, R);
+  }
+
+  for (std::size_t i = 0; i < 2; i++) {
+    EXPECT_NEAR(joseph.getState()[i], simple.getState()[i], 1e-9);
+  }
+}
+
+TEST(KalmanFilterTest, FusesSensorsWithDifferentMeasurementSizes) {
+  // Position, velocity, and a control input which sets the acceleration. An encoder measures the
+  // position every step and a second sensor measures the velocity and position every third step.
+  const double dt = 0.01;
+  const Matrix<2, 2> F{1, dt, 0, 1};
+  const Matrix<2, 1> B{0.5 * dt * dt, dt};
+  const Matrix<2, 2> Q{1e-8, 0, 0, 1e-6};
+
+  KalmanFilter<2, 1> kalman(Matrix<2, 1>{0, 0}, Matrix<2, 2>::identity());
+  std::mt19937 gen(9);
+  std::normal_distribution<double> noise(0, 1);
+
+  double position = 0;
+  double velocity = 0;
+  for (int i = 0; i < 500; i++) {
+    const double accel = std::sin(i * dt);
+    position += velocity * dt + 0.5 * accel * dt * dt;
+    velocity += accel * dt;
+
+    kalman.predict(F, B, Matrix<1, 1>{accel}, Q);
+    kalman.update(
+      Matrix<1, 1>{position + 0.05 * noise(gen)}, Matrix<1, 2>{1, 0}, Matrix<1, 1>{0.0025});
+
+    if (i % 3 == 0) {
+      kalman.update(Matrix<2, 1>{position + 0.01 * noise(gen), velocity + 0.01 * noise(gen)},
+                    Matrix<2, 2>::identity(),
+                    Matrix<2, 2>{1e-4, 0, 0, 1e-4});
+    }
+  }
+
+  EXPECT_NEAR(kalman.getState()[0], position, 0.01);
+  EXPECT_NEAR(kalman.getState()[1], velocity, 0.01);
+}
+
+TEST(KalmanFilterTest, ExtendedModels) {
+  // A point moving in a circle of radius 2 at 1 rad/s, tracked by its angle and angular velocity
+  // and measured by its x and y coordinates
+  const double dt = 0.01;
+  KalmanFilter<2> kalman(Matrix<2, 1>{0.5, 0}, Matrix<2, 2>::identity());
+  std::mt19937 gen(13);
+  std::normal_distribution<double> noise(0, 0.02);
+
+  for (int i = 1; i <= 500; i++) {
+    kalman.predict([&](const Matrix<2, 1> &ix) { return Matrix<2, 1>{ix[0] + ix[1] * dt, ix[1]}; },
+                   Matrix<2, 2>{1, dt, 0, 1},
+                   Matrix<2, 2>{1e-6, 0, 0, 1e-6});
+
+    const double theta = kalman.getState()[0];
+    const double truth = i * dt;
+    kalman.update(
+      Matrix<2, 1>{2 * std::cos(truth) + noise(gen), 2 * std::sin(truth) + noise(gen)},
+      [](const Matrix<2, 1> &ix) {
+        return Matrix<2, 1>{2 * std::cos(ix[0]), 2 * std::sin(ix[0])};
+      },
+      Matrix<2, 2>{-2 * std::sin(theta), 0, 2 * std::cos(theta), 0},
+      Matrix<2, 2>{4e-4, 0, 0, 4e-4});
+  }
+
+  EXPECT_NEAR(kalman.getState()[0], 5, 0.02);
+  EXPECT_NEAR(kalman.getState()[1], 1, 0.05);
+}
+
+TEST(KalmanFilterTest, SingularInnovationSkipsTheUpdate) {
+  KalmanFilter<2> kalman(Matrix<2, 1>{1, 2}, Matrix<2, 2>());
+  EXPECT_FALSE(kalman.update(Matrix<1, 1>{5}, Matrix<1, 2>{1, 0}, Matrix<1, 1>{0}));
+  EXPECT_EQ(kalman.getState(), (Matrix<2, 1>{1, 2}));
+}
+
+template <std::size_t N> void benchmarkKalmanFilter() {
+  // A chain of integrators with the first state measured
+  auto F = Matrix<N, N>::identity();
+  for (std::size_t i = 0; i + 1 < N; i++) {
+    F(i, i + 1) = 0.01;
+  }
+  const auto Q = Matrix<N, N>::identity() * 1e-4;
+  Matrix<1, N> H;
+  H(0, 0) = 1;
+  const Matrix<1, 1> R{0.01};
+
+  KalmanFilter<N> kalman(Matrix<N, 1>(), Matrix<N, N>::identity());
+  const auto readings = createNoisyReadings(1024);
+  std::size_t i = 0;
+
+  const double ns = benchmarkNsPerCall(
+    [&]() {
+      kalman.predict(F, Q);
+      kalman.update(Matrix<1, 1>{readings[i++ % readings.size()]}, H, R);
+    },
+    20000);
+
+  std::cout << "KalmanFilter<" << N << ">: " << ns << " ns per predict and update" << std::endl;
+  EXPECT_TRUE(std::isfinite(kalman.getState()[0]));
+}
+
+TEST(KalmanFilterTest, DISABLED_BenchmarkStepCost) {
+  benchmarkKalmanFilter<2>();
+  benchmarkKalmanFilter<3>();
+  benchmarkKalmanFilter<4>();
+  benchmarkKalmanFilter<5>();
+  benchmarkKalmanFilter<6>();
+}
+
 TEST(VelMathTest, DtLessThanSampleTime) {
   VelMath velMath(
     360, std::make_shared<PassthroughFilter>(), 0_ms, std::make_unique<ConstantMockTimer>(10_ms));
@@ -234,3 +858,220 @@ TEST(VelMathTest, VelEqualToZeroWithoutStep) {
   EXPECT_EQ(velMath.getVelocity().convert(rpm), 0);
   EXPECT_EQ(velMath.getAccel().convert(rpm / second), 0);
 }
+
+TEST(VelMathTest, StepWithTimestamp) {
+  VelMath velMath(
+    360, std::make_shared<PassthroughFilter>(), 0_ms, std::make_unique<ConstantMockTimer>(10_ms));
+
+  // The first step only records the position
+  EXPECT_EQ(velMath.step(100, 1000_ms).convert(rpm), 0);
+
+  for (int i = 1; i < 10; i++) {
+    // 10 ticks per 10 ms should be ~166.67 rpm
+    EXPECT_NEAR(velMath.step(100 + i * 10, 1000_ms + i * 10_ms).convert(rpm), 166.67, 0.01);
+  }
+}
+
+TEST(VelMathTest, StepWithTimestampIgnoresSamplesBeforeSampleTime) {
+  VelMath velMath(
+    360, std::make_shared<PassthroughFilter>(), 10_ms, std::make_unique<ConstantMockTimer>(10_ms));
+
+  velMath.step(0, 0_ms);
+  EXPECT_EQ(velMath.step(10, 5_ms).convert(rpm), 0);
+  EXPECT_NEAR(velMath.step(10, 10_ms).convert(rpm), 166.67, 0.01);
+  EXPECT_NEAR(velMath.step(10, 10_ms).convert(rpm), 166.67, 0.01);
+}
+
+TEST(VelMathTest, StepWithMotorUsesTheSampleTimestamp) {
+  VelMath velMath(
+    1800, std::make_shared<PassthroughFilter>(), 0_ms, std::make_unique<ConstantMockTimer>(10_ms));
+  SampledMockMotor motor;
+
+  // The first step only records the sample
+  motor.rawPosition = 100;
+  motor.sampleTimestamp = 5000;
+  bool newVelocity = true;
+  EXPECT_EQ(velMath.step(motor, &newVelocity).convert(rpm), 0);
+  EXPECT_FALSE(newVelocity);
+  EXPECT_EQ(velMath.getLastSampleTime(), 5000_ms);
+
+  // 30 ticks in 10 ms at 1800 ticks per rev is 100 rpm
+  motor.rawPosition = 130;
+  motor.sampleTimestamp = 5010;
+  EXPECT_NEAR(velMath.step(motor, &newVelocity).convert(rpm), 100, 1e-9);
+  EXPECT_TRUE(newVelocity);
+
+  // The motor has not sampled again, so the reading is skipped
+  EXPECT_NEAR(velMath.step(motor, &newVelocity).convert(rpm), 100, 1e-9);
+  EXPECT_FALSE(newVelocity);
+  EXPECT_EQ(velMath.getLastSampleTime(), 5010_ms);
+
+  // A failed read (PROS_ERR) is skipped
+  motor.rawPosition = std::numeric_limits<std::int32_t>::max();
+  motor.sampleTimestamp = 5020;
+  EXPECT_NEAR(velMath.step(motor).convert(rpm), 100, 1e-9);
+
+  // The same motion over 20 ms is half the velocity
+  motor.rawPosition = 160;
+  motor.sampleTimestamp = 5030;
+  EXPECT_NEAR(velMath.step(motor).convert(rpm), 50, 1e-9);
+}
+
+TEST(VelMathTest, StepWithMotorHandlesTimestampWraparound) {
+  VelMath velMath(
+    1800, std::make_shared<PassthroughFilter>(), 0_ms, std::make_unique<ConstantMockTimer>(10_ms));
+  SampledMockMotor motor;
+
+  motor.sampleTimestamp = std::numeric_limits<std::uint32_t>::max() - 4;
+  velMath.step(motor);
+
+  motor.rawPosition = 30;
+  motor.sampleTimestamp = 5;
+  EXPECT_NEAR(velMath.step(motor).convert(rpm), 100, 1e-9);
+}
+
+TEST(VelMathTest, StepWithMotorIsNotAffectedByLoopJitter) {
+  // The motor samples a constant 100 rpm every 10 ms, but the loop runs every 5 to 15 ms and sees
+  // the latest sample
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<double> loopDelay(5, 15);
+  SampledMockMotor motor;
+
+  VelMath loopTimed(
+    1800, std::make_shared<PassthroughFilter>(), 0_ms, std::make_unique<ConstantMockTimer>(10_ms));
+  VelMath sensorTimed(
+    1800, std::make_shared<PassthroughFilter>(), 0_ms, std::make_unique<ConstantMockTimer>(10_ms));
+
+  double loopTime = 0;
+  double loopTimedSquaredError = 0;
+  double sensorTimedSquaredError = 0;
+  for (int i = 0; i < 1000; i++) {
+    loopTime += loopDelay(gen);
+    const auto sample = static_cast<std::uint32_t>(loopTime / 10);
+    motor.sampleTimestamp = sample * 10;
+    motor.rawPosition = static_cast<std::int32_t>(sample * 30);
+
+    loopTimed.step(motor.rawPosition, loopTime * millisecond);
+    sensorTimed.step(motor);
+
+    if (i > 0) {
+      loopTimedSquaredError += ipow(loopTimed.getVelocity().convert(rpm) - 100, 2);
+      sensorTimedSquaredError += ipow(sensorTimed.getVelocity().convert(rpm) - 100, 2);
+    }
+  }
+
+  const double loopTimedRMS = std::sqrt(loopTimedSquaredError / 999);
+  const double sensorTimedRMS = std::sqrt(sensorTimedSquaredError / 999);
+
+  EXPECT_GT(loopTimedRMS, 10);
+  EXPECT_LT(sensorTimedRMS, 1e-9);
+}
+
+class SavitzkyGolayVelMathTest : public ::testing::Test {
+  protected:
+  std::unique_ptr<SavitzkyGolayVelMath> create(const std::size_t iwindowSize,
+                                               const std::size_t iorder) const {
+    return std::make_unique<SavitzkyGolayVelMath>(
+      1800, iwindowSize, iorder, 0_ms, std::make_unique<ConstantMockTimer>(10_ms));
+  }
+
+  // 100 rpm and 50 rpm/s at 1800 ticks per rev
+  static double position(const double itime) {
+    return 3000 * itime + 0.5 * 1500 * itime * itime;
+  }
+
+  static double velocity(const double itime) {
+    return 100 + 50 * itime;
+  }
+};
+
+TEST_F(SavitzkyGolayVelMathTest, ExactForEvenlySpacedQuadraticMotion) {
+  auto velMath = create(8, 2);
+
+  for (int i = 0; i < 50; i++) {
+    const double t = i * 0.01;
+    velMath->step(position(t), t * second);
+
+    if (i >= 8) {
+      EXPECT_NEAR(velMath->getVelocity().convert(rpm), velocity(t), 1e-6);
+      EXPECT_NEAR(velMath->getAccel().convert(rpm / second), 50, 1e-6);
+    }
+  }
+}
+
+TEST_F(SavitzkyGolayVelMathTest, ExactForUnevenlySpacedQuadraticMotion) {
+  auto velMath = create(6, 2);
+  std::mt19937 gen(3);
+  std::uniform_real_distribution<double> loopDelay(0.005, 0.015);
+
+  double t = 0;
+  for (int i = 0; i < 50; i++) {
+    t += loopDelay(gen);
+    velMath->step(position(t), t * second);
+
+    if (i >= 6) {
+      EXPECT_NEAR(velMath->getVelocity().convert(rpm), velocity(t), 1e-6);
+      EXPECT_NEAR(velMath->getAccel().convert(rpm / second), 50, 1e-6);
+    }
+  }
+}
+
+TEST_F(SavitzkyGolayVelMathTest, FillsTheWindowWithLowerOrderFits) {
+  auto velMath = create(8, 2);
+
+  // The first step only records the position, then two samples are a two-point difference
+  velMath->step(0, 0_ms);
+  EXPECT_EQ(velMath->getVelocity().convert(rpm), 0);
+  EXPECT_NEAR(velMath->step(30, 10_ms).convert(rpm), 100, 1e-9);
+  EXPECT_EQ(velMath->getAccel().convert(rpm / second), 0);
+}
+
+TEST_F(SavitzkyGolayVelMathTest, InvalidParametersThrow) {
+  EXPECT_THROW(create(8, 0), std::invalid_argument);
+  EXPECT_THROW(create(8, 4), std::invalid_argument);
+  EXPECT_THROW(create(2, 2), std::invalid_argument);
+  EXPECT_THROW(SavitzkyGolayVelMath(0, 8, 2, 0_ms, std::make_unique<ConstantMockTimer>(10_ms)),
+               std::invalid_argument);
+}
+
+TEST_F(SavitzkyGolayVelMathTest, LessNoisyThanVelMath) {
+  std::mt19937 gen(11);
+  std::normal_distribution<double> noise(0, 2); // ticks
+
+  VelMath velMath(
+    1800, std::make_shared<AverageFilter<2>>(), 0_ms, std::make_unique<ConstantMockTimer>(10_ms));
+  auto savitzkyGolay = create(10, 2);
+
+  double velMathVelError = 0, velMathAccelError = 0;
+  double savitzkyGolayVelError = 0, savitzkyGolayAccelError = 0;
+  std::size_t samples = 0;
+  for (int i = 0; i < 500; i++) {
+    const double t = i * 0.01;
+    const double reading = position(t) + noise(gen);
+    velMath.step(reading, t * second);
+    savitzkyGolay->step(reading, t * second);
+
+    if (i >= 20) {
+      velMathVelError += ipow(velMath.getVelocity().convert(rpm) - velocity(t), 2);
+      velMathAccelError += ipow(velMath.getAccel().convert(rpm / second) - 50, 2);
+      savitzkyGolayVelError += ipow(savitzkyGolay->getVelocity().convert(rpm) - velocity(t), 2);
+      savitzkyGolayAccelError += ipow(savitzkyGolay->getAccel().convert(rpm / second) - 50, 2);
+      samples++;
+    }
+  }
+
+  const auto rms = [&](const double isum) { return std::sqrt(isum / samples); };
+
+  EXPECT_LT(rms(savitzkyGolayVelError), rms(velMathVelError));
+  EXPECT_LT(rms(savitzkyGolayAccelError), rms(velMathAccelError) / 10);
+}
+
+TEST_F(SavitzkyGolayVelMathTest, WorksInIterativeVelPIDController) {
+  IterativeVelPIDController controller(
+    0, 0, 0, 0, create(4, 2), createTimeUtil(), std::make_unique<PassthroughFilter>());
+
+  for (int i = 0; i < 10; i++) {
+    controller.step(position(i * 0.01), i * 10_ms);
+  }
+  EXPECT_NEAR(controller.getVel().convert(rpm), velocity(0.09), 1e-6);
+}
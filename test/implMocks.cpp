@@ -282,6 +282,18 @@ void MockRate::delayUntil(uint32_t ims) {
   std::this_thread::sleep_for(std::chrono::milliseconds(ims));
 }
 
+void NoDelayRate::delay(QFrequency) {
+}
+
+void NoDelayRate::delay(int) {
+}
+
+void NoDelayRate::delayUntil(QTime) {
+}
+
+void NoDelayRate::delayUntil(uint32_t) {
+}
+
 std::unique_ptr<SettledUtil> createSettledUtilPtr(const double iatTargetError,
                                                   const double iatTargetDerivative,
                                                   const QTime iatTargetTime) {
@@ -318,6 +330,13 @@ TimeUtil createTimeUtil(const Supplier<std::unique_ptr<SettledUtil>> &isettledUt
     isettledUtilSupplier);
 }
 
+TimeUtil createTimeUtil(const Supplier<std::unique_ptr<AbstractRate>> &irateSupplier) {
+  return TimeUtil(
+    Supplier<std::unique_ptr<AbstractTimer>>([]() { return std::make_unique<MockTimer>(); }),
+    irateSupplier,
+    Supplier<std::unique_ptr<SettledUtil>>([]() { return createSettledUtilPtr(); }));
+}
+
 SimulatedSystem::SimulatedSystem(FlywheelSimulator &isimulator) : simulator(isimulator) {
 }
 
@@ -519,6 +538,13 @@ void assertAsyncWrapperScalesControllerSetTargets(AsyncWrapper<double, double> &
   EXPECT_DOUBLE_EQ(controller.getTarget(), 50);
 }
 
+int32_t SampledMockMotor::getRawPosition(std::uint32_t *timestamp) {
+  if (timestamp != nullptr) {
+    *timestamp = sampleTimestamp;
+  }
+  return rawPosition;
+}
+
 ThreadedMockMotor::ThreadedMockMotor() : encoder(std::make_shared<MockContinuousRotarySensor>()) {
 }
 
@@ -0,0 +1,176 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/control/iterative/iterativeGainScheduledPosPidController.hpp"
+#include "test/tests/api/implMocks.hpp"
+#include <gtest/gtest.h>
+
+using namespace okapi;
+
+class MockScheduleInput : public ControllerInput<double> {
+  public:
+  double controllerGet() override {
+    numReads++;
+    return value;
+  }
+
+  double value{0};
+  int numReads{0};
+};
+
+class IterativeGainScheduledPosPIDControllerTest : public ::testing::Test {
+  protected:
+  virtual void SetUp() {
+    scheduleInput = std::make_shared<MockScheduleInput>();
+    controller = new IterativeGainScheduledPosPIDController(
+      {{100, {0.3, 0, 0, 0}}, {0, {0.1, 0, 0, 0}}}, scheduleInput, createConstantTimeUtil(10_ms));
+  }
+
+  virtual void TearDown() {
+    delete controller;
+  }
+
+  std::shared_ptr<MockScheduleInput> scheduleInput;
+  IterativeGainScheduledPosPIDController *controller;
+};
+
+TEST_F(IterativeGainScheduledPosPIDControllerTest, InterpolatesGains) {
+  EXPECT_DOUBLE_EQ(controller->getGains(0).kP, 0.1);
+  EXPECT_DOUBLE_EQ(controller->getGains(50).kP, 0.2);
+  EXPECT_DOUBLE_EQ(controller->getGains(75).kP, 0.25);
+  EXPECT_DOUBLE_EQ(controller->getGains(100).kP, 0.3);
+}
+
+TEST_F(IterativeGainScheduledPosPIDControllerTest, HoldsGainsOutsideSchedule) {
+  EXPECT_DOUBLE_EQ(controller->getGains(-50).kP, 0.1);
+  EXPECT_DOUBLE_EQ(controller->getGains(150).kP, 0.3);
+}
+
+TEST_F(IterativeGainScheduledPosPIDControllerTest, UsesScheduleInputWhenStepping) {
+  controller->setBumplessTransfer(false);
+
+  scheduleInput->value = 50;
+  EXPECT_DOUBLE_EQ(controller->step(1), 0.2 * -1);
+
+  scheduleInput->value = 100;
+  EXPECT_DOUBLE_EQ(controller->step(1), 0.3 * -1);
+
+  scheduleInput->value = -10;
+  EXPECT_DOUBLE_EQ(controller->step(1), 0.1 * -1);
+}
+
+TEST_F(IterativeGainScheduledPosPIDControllerTest, BumplessTransferKeepsOutputContinuous) {
+  IterativeGainScheduledPosPIDController scheduled(
+    {{0, {0.1, 0.001, 0, 0}}, {100, {0.3, 0.001, 0, 0}}},
+    scheduleInput,
+    createConstantTimeUtil(10_ms));
+
+  scheduleInput->value = 0;
+  const double before = scheduled.step(1);
+  EXPECT_NEAR(before, 0.1 * -1, 1e-4);
+
+  // Same error with new gains, so the output must not jump (apart from one more step of the
+  // integral term)
+  scheduleInput->value = 100;
+  EXPECT_NEAR(scheduled.step(1), before, 1e-4);
+
+  // A change in error is now acted on with the new proportional gain
+  EXPECT_NEAR(scheduled.step(2), before + 0.3 * -1, 1e-4);
+}
+
+TEST_F(IterativeGainScheduledPosPIDControllerTest, NoBumplessTransferWithoutIntegralGain) {
+  // Nothing would wind a transferred difference back out of the integrator, so it would stay on
+  // the output forever
+  scheduleInput->value = 0;
+  EXPECT_DOUBLE_EQ(controller->step(1), 0.1 * -1);
+
+  scheduleInput->value = 100;
+  EXPECT_DOUBLE_EQ(controller->step(1), 0.3 * -1);
+
+  scheduleInput->value = 0;
+  EXPECT_DOUBLE_EQ(controller->step(1), 0.1 * -1);
+}
+
+TEST_F(IterativeGainScheduledPosPIDControllerTest, ReadsScheduleOncePerSampleTime) {
+  controller->step(1, 0_ms);
+  EXPECT_EQ(scheduleInput->numReads, 1);
+
+  controller->step(1, 5_ms);
+  EXPECT_EQ(scheduleInput->numReads, 1);
+
+  controller->step(1, 10_ms);
+  EXPECT_EQ(scheduleInput->numReads, 2);
+}
+
+TEST_F(IterativeGainScheduledPosPIDControllerTest, WithoutBumplessTransferOutputJumps) {
+  controller->setBumplessTransfer(false);
+
+  scheduleInput->value = 0;
+  EXPECT_DOUBLE_EQ(controller->step(1), 0.1 * -1);
+
+  scheduleInput->value = 100;
+  EXPECT_DOUBLE_EQ(controller->step(1), 0.3 * -1);
+}
+
+TEST_F(IterativeGainScheduledPosPIDControllerTest, SingleBreakpointMatchesPosPID) {
+  IterativeGainScheduledPosPIDController scheduled(
+    {{0, {0.01, 0.001, 0.0001, 0.05}}}, scheduleInput, createConstantTimeUtil(10_ms));
+  IterativePosPIDController plain(0.01, 0.001, 0.0001, 0.05, createConstantTimeUtil(10_ms));
+
+  scheduled.setTarget(100);
+  plain.setTarget(100);
+
+  for (int i = 0; i < 50; i++) {
+    scheduleInput->value = i;
+    EXPECT_DOUBLE_EQ(scheduled.step(i), plain.step(i));
+  }
+}
+
+TEST_F(IterativeGainScheduledPosPIDControllerTest, SampleTimeRescalesSchedule) {
+  IterativeGainScheduledPosPIDController scheduled(
+    {{0, {0.01, 0.001, 0.0001, 0}}, {10, {0.01, 0.001, 0.0001, 0}}},
+    scheduleInput,
+    createConstantTimeUtil(20_ms));
+  IterativePosPIDController plain(0.01, 0.001, 0.0001, 0, createConstantTimeUtil(20_ms));
+
+  scheduled.setSampleTime(20_ms);
+  plain.setSampleTime(20_ms);
+  scheduled.setTarget(100);
+  plain.setTarget(100);
+
+  scheduleInput->value = 5;
+  for (int i = 0; i < 20; i++) {
+    EXPECT_DOUBLE_EQ(scheduled.step(i), plain.step(i));
+  }
+}
+
+TEST_F(IterativeGainScheduledPosPIDControllerTest, DoesNotReadScheduleWhenDisabled) {
+  controller->flipDisable(true);
+  EXPECT_EQ(controller->step(1), 0);
+  EXPECT_EQ(scheduleInput->numReads, 0);
+}
+
+TEST_F(IterativeGainScheduledPosPIDControllerTest, EmptyScheduleThrows) {
+  EXPECT_THROW(
+    IterativeGainScheduledPosPIDController({}, scheduleInput, createConstantTimeUtil(10_ms)),
+    std::invalid_argument);
+}
+
+TEST_F(IterativeGainScheduledPosPIDControllerTest, DuplicateScheduleValueThrows) {
+  EXPECT_THROW(IterativeGainScheduledPosPIDController({{1, {0.1, 0, 0, 0}}, {1, {0.2, 0, 0, 0}}},
+                                                      scheduleInput,
+                                                      createConstantTimeUtil(10_ms)),
+               std::invalid_argument);
+}
+
+TEST_F(IterativeGainScheduledPosPIDControllerTest, SettledWhenDisabled) {
+  assertControllerIsSettledWhenDisabled(*controller, 100.0);
+}
+
+TEST_F(IterativeGainScheduledPosPIDControllerTest, DisabledLifecycle) {
+  assertIterativeControllerFollowsDisableLifecycle(*controller);
+}
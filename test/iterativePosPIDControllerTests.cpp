@@ -146,3 +146,33 @@ TEST_F(IterativePosPIDControllerTest, TestDerivativeTermWithDefaultFilter) {
   EXPECT_EQ(controller->step(2), -1);
   EXPECT_EQ(controller->step(2), 0);
 }
+
+TEST_F(IterativePosPIDControllerTest, StepWithTimestampRespectsSampleTime) {
+  controller->setTarget(1);
+  EXPECT_DOUBLE_EQ(controller->step(0, 100_ms), 0.1);
+
+  // Not enough time has passed for another update, so the new reading is ignored
+  EXPECT_DOUBLE_EQ(controller->step(2, 105_ms), 0.1);
+  EXPECT_DOUBLE_EQ(controller->getError(), 1);
+
+  EXPECT_DOUBLE_EQ(controller->step(2, 110_ms), -0.1);
+  EXPECT_DOUBLE_EQ(controller->getError(), -1);
+}
+
+TEST_F(IterativePosPIDControllerTest, StepWithTimestampIsDeterministic) {
+  MockIterativePosPIDController other(0.1, 0, 0, 0, createTimeUtil());
+  controller->setTarget(10);
+  other.setTarget(10);
+
+  for (int i = 0; i < 10; i++) {
+    const QTime now = i * 10_ms;
+    EXPECT_DOUBLE_EQ(controller->step(i, now), other.step(i, now));
+  }
+}
+
+TEST_F(IterativePosPIDControllerTest, StepWithTimestampWhenDisabled) {
+  controller->setTarget(1);
+  controller->flipDisable(true);
+  EXPECT_EQ(controller->step(0, 0_ms), 0);
+  EXPECT_EQ(controller->getOutput(), 0);
+}
@@ -141,3 +141,55 @@ TEST_F(IterativeVelPIDControllerTest, TestDerivativeTermWithDefaultFilter) {
   EXPECT_NEAR(controller->step(2), -0.349, 0.0001);
   EXPECT_EQ(controller->step(2), 0);
 }
+
+TEST_F(IterativeVelPIDControllerTest, StepWithTimestampUsesTimestampForVelocity) {
+  controller->setGains(0, 0, 0, 0);
+
+  // The first step only records the position
+  controller->step(0, 0_ms);
+  EXPECT_DOUBLE_EQ(controller->getVel().convert(rpm), 0);
+
+  // 30 ticks in 10 ms at 1800 ticks per rev is 100 rpm
+  controller->step(30, 10_ms);
+  EXPECT_NEAR(controller->getVel().convert(rpm), 100, 0.0001);
+
+  // The same motion over 20 ms is half the velocity
+  controller->step(60, 30_ms);
+  EXPECT_NEAR(controller->getVel().convert(rpm), 50, 0.0001);
+}
+
+TEST_F(IterativeVelPIDControllerTest, StepWithMotorOnlyUpdatesOnNewSamples) {
+  controller->setGains(0, 1, 0, 0);
+  SampledMockMotor motor;
+
+  controller->step(motor);
+  EXPECT_DOUBLE_EQ(controller->getVel().convert(rpm), 0);
+
+  // 30 ticks in 10 ms at 1800 ticks per rev is 100 rpm
+  motor.rawPosition = 30;
+  motor.sampleTimestamp = 10;
+  const double output = controller->step(motor);
+  EXPECT_NEAR(controller->getVel().convert(rpm), 100, 0.0001);
+  EXPECT_NE(output, 0);
+
+  // The derivative term would go to zero if the repeated sample were used again
+  EXPECT_EQ(controller->step(motor), output);
+  EXPECT_NEAR(controller->getVel().convert(rpm), 100, 0.0001);
+}
+
+TEST_F(IterativeVelPIDControllerTest, StepWithMotorDoesNotUpdateOnTheFirstSample) {
+  controller->setGains(1, 0, 0, 0);
+  controller->setTarget(0.5);
+  SampledMockMotor motor;
+
+  // The first sample has no velocity yet, so it must not add the whole target to the output
+  motor.rawPosition = 100;
+  motor.sampleTimestamp = 5000;
+  EXPECT_EQ(controller->step(motor), 0);
+
+  // 30 ticks in 10 ms at 1800 ticks per rev is 100 rpm, far above the target
+  motor.rawPosition = 130;
+  motor.sampleTimestamp = 5010;
+  EXPECT_EQ(controller->step(motor), -1);
+  EXPECT_NEAR(controller->getVel().convert(rpm), 100, 0.0001);
+}
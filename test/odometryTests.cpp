@@ -0,0 +1,251 @@
+/**
+ * @author Ryan Benasutti, WPI
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "okapi/api/chassis/model/threeEncoderSkidSteerModel.hpp"
+#include "okapi/api/odometry/odometry.hpp"
+#include "okapi/api/odometry/poseHistory.hpp"
+#include "okapi/api/util/mathUtil.hpp"
+#include "test/tests/api/implMocks.hpp"
+#include <chrono>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+#include <thread>
+
+using namespace okapi;
+
+class OdometryTest : public ::testing::Test {
+  protected:
+  void SetUp() override {
+    leftSensor = std::make_shared<MockContinuousRotarySensor>();
+    rightSensor = std::make_shared<MockContinuousRotarySensor>();
+    middleSensor = std::make_shared<MockContinuousRotarySensor>();
+    model = std::make_shared<ThreeEncoderSkidSteerModel>(std::make_shared<MockMotor>(),
+                                                         std::make_shared<MockMotor>(),
+                                                         leftSensor,
+                                                         middleSensor,
+                                                         rightSensor,
+                                                         100);
+  }
+
+  std::unique_ptr<Odometry> createOdometry(
+    const QLength imiddleWheelDistance = 0_m,
+    const std::shared_ptr<ContinuousRotarySensor> &igyro = nullptr) {
+    auto odom = std::make_unique<Odometry>(
+      model, scales, createConstantTimeUtil(10_ms), 5_ms, imiddleWheelDistance, igyro);
+    odom->step();
+    return odom;
+  }
+
+  /**
+   * Moves each tracking wheel by a distance in meters, then steps the odometry.
+   */
+  void move(Odometry &odom, const double ileft, const double iright, const double imiddle = 0) {
+    left += ileft;
+    right += iright;
+    middle += imiddle;
+    leftSensor->value = static_cast<std::int32_t>(std::lround(left * straight));
+    rightSensor->value = static_cast<std::int32_t>(std::lround(right * straight));
+    middleSensor->value = static_cast<std::int32_t>(std::lround(middle * straight));
+    odom.step();
+  }
+
+  static constexpr double straight = 10000; // ticks/m
+  static constexpr double width = 0.3;      // m
+  const ChassisScales scales{{straight, width * straight * pi / 360}};
+
+  std::shared_ptr<MockContinuousRotarySensor> leftSensor;
+  std::shared_ptr<MockContinuousRotarySensor> rightSensor;
+  std::shared_ptr<MockContinuousRotarySensor> middleSensor;
+  std::shared_ptr<ThreeEncoderSkidSteerModel> model;
+  double left{0};
+  double right{0};
+  double middle{0};
+};
+
+TEST_F(OdometryTest, FirstStepOnlyRecordsTheReadings) {
+  leftSensor->value = 500;
+  rightSensor->value = 700;
+  middleSensor->value = 300;
+  auto odom = createOdometry();
+
+  const auto state = odom->getState();
+  EXPECT_DOUBLE_EQ(state.x.convert(meter), 0);
+  EXPECT_DOUBLE_EQ(state.y.convert(meter), 0);
+  EXPECT_DOUBLE_EQ(state.theta.convert(degree), 0);
+}
+
+TEST_F(OdometryTest, DrivesStraight) {
+  auto odom = createOdometry();
+  move(*odom, 0.5, 0.5);
+  move(*odom, 0.5, 0.5);
+
+  const auto state = odom->getState();
+  EXPECT_NEAR(state.x.convert(meter), 1, 1e-9);
+  EXPECT_NEAR(state.y.convert(meter), 0, 1e-9);
+  EXPECT_NEAR(state.theta.convert(degree), 0, 1e-9);
+}
+
+TEST_F(OdometryTest, ArcUpdatesAreExactForAnArcWithLargeSteps) {
+  auto odom = createOdometry();
+
+  // A quarter of a circle with a radius of 1 m to the left, in only four steps
+  const double radius = 1;
+  const double dTheta = pi / 8;
+  for (int i = 0; i < 4; i++) {
+    move(*odom, (radius - width / 2) * dTheta, (radius + width / 2) * dTheta);
+  }
+
+  // Within the rounding of the encoder ticks
+  const auto state = odom->getState();
+  EXPECT_NEAR(state.x.convert(meter), radius, 1e-3);
+  EXPECT_NEAR(state.y.convert(meter), radius, 1e-3);
+  EXPECT_NEAR(state.theta.convert(degree), 90, 1e-2);
+}
+
+TEST_F(OdometryTest, MiddleEncoderTracksStrafing) {
+  auto odom = createOdometry();
+  move(*odom, 0, 0, 0.5);
+  move(*odom, 0.25, 0.25, 0);
+
+  const auto state = odom->getState();
+  EXPECT_NEAR(state.x.convert(meter), 0.25, 1e-9);
+  EXPECT_NEAR(state.y.convert(meter), 0.5, 1e-9);
+  EXPECT_NEAR(state.theta.convert(degree), 0, 1e-9);
+}
+
+TEST_F(OdometryTest, TurningInPlaceDoesNotMoveTheChassisWithAnOffsetMiddleWheel) {
+  const double middleWheelDistance = 0.1;
+  auto odom = createOdometry(middleWheelDistance * meter);
+
+  // The middle wheel is behind the center, so it is dragged to the right while turning left
+  const double dTheta = pi / 4;
+  for (int i = 0; i < 2; i++) {
+    move(*odom, -width / 2 * dTheta, width / 2 * dTheta, -middleWheelDistance * dTheta);
+  }
+
+  const auto state = odom->getState();
+  EXPECT_NEAR(state.x.convert(meter), 0, 1e-4);
+  EXPECT_NEAR(state.y.convert(meter), 0, 1e-4);
+  EXPECT_NEAR(state.theta.convert(degree), 90, 1e-2);
+}
+
+TEST_F(OdometryTest, GyroSetsTheHeading) {
+  auto gyro = std::make_shared<MockContinuousRotarySensor>();
+  auto odom = createOdometry(0_m, gyro);
+
+  // The encoders say the chassis drove straight, but the gyro says it turned 90 degrees left
+  gyro->value = 900;
+  move(*odom, 1, 1);
+
+  const auto state = odom->getState();
+  EXPECT_NEAR(state.x.convert(meter), 2 / pi, 1e-9);
+  EXPECT_NEAR(state.y.convert(meter), 2 / pi, 1e-9);
+  EXPECT_NEAR(state.theta.convert(degree), 90, 1e-9);
+}
+
+TEST_F(OdometryTest, StepIsSkippedWhenASensorReturnsProsErr) {
+  auto odom = createOdometry();
+  middleSensor->value = std::numeric_limits<std::int32_t>::max();
+  leftSensor->value = 5000;
+  rightSensor->value = 5000;
+  odom->step();
+  EXPECT_DOUBLE_EQ(odom->getState().x.convert(meter), 0);
+
+  middleSensor->value = 0;
+  odom->step();
+  EXPECT_NEAR(odom->getState().x.convert(meter), 0.5, 1e-9);
+}
+
+TEST_F(OdometryTest, SetStateMovesTheStartingPose) {
+  auto odom = createOdometry();
+  odom->setState(OdomState{1_m, 2_m, 90_deg});
+  move(*odom, 0.5, 0.5);
+
+  const auto state = odom->getState();
+  EXPECT_NEAR(state.x.convert(meter), 1, 1e-9);
+  EXPECT_NEAR(state.y.convert(meter), 2.5, 1e-9);
+  EXPECT_NEAR(state.theta.convert(degree), 90, 1e-9);
+}
+
+TEST_F(OdometryTest, ConstructorThrowsOnInvalidArguments) {
+  EXPECT_THROW(Odometry(model, ChassisScales({4_in, 0_in}), createTimeUtil()),
+               std::invalid_argument);
+  EXPECT_THROW(Odometry(model, scales, createTimeUtil(), 0_ms), std::invalid_argument);
+}
+
+TEST_F(OdometryTest, RunsInATask) {
+  leftSensor->value = 5000;
+  rightSensor->value = 5000;
+  Odometry odom(model, scales, createTimeUtil(), 1_ms);
+  odom.startThread();
+
+  // Wait for the first step, then for a few more
+  auto waitForTimeAfter = [&](const QTime itime) {
+    for (int i = 0; i < 1000 && odom.getState().time <= itime; i++) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  };
+  waitForTimeAfter(0_ms);
+  const QTime start = odom.getState().time;
+  waitForTimeAfter(start + 5_ms);
+
+  const auto state = odom.getState();
+  EXPECT_GT(state.time.convert(millisecond), start.convert(millisecond) + 5);
+  EXPECT_DOUBLE_EQ(state.x.convert(meter), 0);
+}
+
+TEST(PoseHistoryTest, InterpolatesPoses) {
+  PoseHistory history(10);
+  EXPECT_TRUE(history.add(OdomState{0_m, 0_m, 0_deg, 100_ms}));
+  EXPECT_TRUE(history.add(OdomState{1_m, 2_m, 90_deg, 200_ms}));
+
+  OdomState state;
+  EXPECT_TRUE(history.get(150_ms, state));
+  EXPECT_NEAR(state.x.convert(meter), 0.5, 1e-9);
+  EXPECT_NEAR(state.y.convert(meter), 1, 1e-9);
+  EXPECT_NEAR(state.theta.convert(degree), 45, 1e-9);
+  EXPECT_NEAR(state.time.convert(millisecond), 150, 1e-9);
+}
+
+/**
+ * A timer which advances by a constant time every time it is read.
+ */
+class SteppingMockTimer : public ConstantMockTimer {
+  public:
+  using ConstantMockTimer::ConstantMockTimer;
+
+  QTime millis() const override {
+    time += dtToReturn;
+    return time;
+  }
+
+  mutable QTime time{0_ms};
+};
+
+TEST_F(OdometryTest, PoseHistoryCompensatesForMeasurementLatency) {
+  // Odometry is read every 10 ms
+  Odometry odom(model,
+                scales,
+                createTimeUtil(Supplier<std::unique_ptr<AbstractTimer>>(
+                  []() { return std::make_unique<SteppingMockTimer>(10_ms); })));
+  odom.step();
+  PoseHistory history(50);
+
+  // Drive forward at 1 m/s, recording the pose every step
+  for (int i = 0; i < 20; i++) {
+    move(odom, 0.01, 0.01);
+    EXPECT_TRUE(history.add(odom));
+    EXPECT_FALSE(history.add(odom));
+  }
+
+  // A measurement which arrives now but was taken 45 ms ago sees the pose from 45 ms ago
+  const QTime now = odom.getState().time;
+  OdomState then;
+  EXPECT_TRUE(history.get(now - 45_ms, then));
+  EXPECT_NEAR(then.x.convert(meter), odom.getState().x.convert(meter) - 0.045, 1e-9);
+}
@@ -5,8 +5,18 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this
  * file, You can obtain one at http://mozilla.org/MPL/2.0/.
  */
+#include "okapi/api/util/leftRightBuffer.hpp"
 #include "okapi/api/util/mathUtil.hpp"
+#include "okapi/api/util/matrix.hpp"
+#include "okapi/api/util/parallelFor.hpp"
+#include "okapi/api/util/timestampedHistory.hpp"
+#include "test/tests/api/implMocks.hpp"
+#include <array>
+#include <atomic>
 #include <gtest/gtest.h>
+#include <iostream>
+#include <thread>
+#include <vector>
 
 using namespace okapi;
 
@@ -56,3 +66,267 @@ TEST(TrueModTest, Tests) {
   EXPECT_EQ(modulus(-1800, 3600), 1800);
   EXPECT_EQ(modulus(1, -3), -2);
 }
+
+TEST(MatrixTest, ArithmeticTest) {
+  const Matrix<2, 3> a{1, 2, 3, 4, 5, 6};
+  const Matrix<3, 2> b{7, 8, 9, 10, 11, 12};
+
+  EXPECT_EQ(a * b, (Matrix<2, 2>{58, 64, 139, 154}));
+  EXPECT_EQ(a.transpose(), (Matrix<3, 2>{1, 4, 2, 5, 3, 6}));
+  EXPECT_EQ(a + a, a * 2);
+  EXPECT_EQ(a - a, (Matrix<2, 3>()));
+  EXPECT_EQ(-a, -1 * a);
+  EXPECT_EQ((Matrix<2, 2>::identity() * Matrix<2, 2>{1, 2, 3, 4}), (Matrix<2, 2>{1, 2, 3, 4}));
+
+  Matrix<3, 1> v{1, 2, 3};
+  v[1] = 5;
+  EXPECT_EQ(v(1, 0), 5);
+}
+
+TEST(MatrixTest, InvertTest) {
+  const Matrix<3, 3> a{0, 2, 1, 1, 1, 0, 3, 0, 4};
+  Matrix<3, 3> inverse;
+  ASSERT_TRUE(a.invert(inverse));
+
+  const auto product = a * inverse;
+  for (std::size_t r = 0; r < 3; r++) {
+    for (std::size_t c = 0; c < 3; c++) {
+      EXPECT_NEAR(product(r, c), r == c ? 1 : 0, 1e-12);
+    }
+  }
+}
+
+TEST(MatrixTest, SingularMatrixIsNotInverted) {
+  const Matrix<2, 2> a{1, 2, 2, 4};
+  Matrix<2, 2> inverse{9, 9, 9, 9};
+  EXPECT_FALSE(a.invert(inverse));
+  EXPECT_EQ(inverse, (Matrix<2, 2>{9, 9, 9, 9}));
+}
+
+/**
+ * Exposes the read indicators so a test can pretend a reader is in the middle of reading.
+ */
+class HeldLeftRightBuffer : public LeftRightBuffer<int> {
+  public:
+  using LeftRightBuffer<int>::LeftRightBuffer;
+
+  void enterRead() {
+    readIndicators[versionIndex.load()].fetch_add(1);
+  }
+
+  void leaveRead(const int iversion) {
+    readIndicators[iversion].fetch_sub(1);
+  }
+
+  int getVersion() const {
+    return versionIndex.load();
+  }
+};
+
+TEST(LeftRightBufferTest, ReadsTheNewestWrite) {
+  LeftRightBuffer<int> buffer(1);
+  EXPECT_EQ(buffer.read(), 1);
+
+  for (int i = 2; i < 10; i++) {
+    buffer.write(i);
+    EXPECT_EQ(buffer.read(), i);
+  }
+}
+
+TEST(LeftRightBufferTest, WriteIsHeldBackWhileAReaderCouldSeeTheOtherCopy) {
+  HeldLeftRightBuffer buffer(0);
+  const int version = buffer.getVersion();
+  buffer.enterRead();
+
+  // The first write uses the free copy, then must wait for the reader before reusing the other
+  buffer.write(1);
+  EXPECT_EQ(buffer.read(), 1);
+  buffer.write(2);
+  EXPECT_EQ(buffer.read(), 1);
+  buffer.write(3);
+  EXPECT_EQ(buffer.read(), 1);
+  EXPECT_FALSE(buffer.flush());
+
+  // Once the reader leaves, the newest value is published and the older held value is dropped
+  buffer.leaveRead(version);
+  EXPECT_TRUE(buffer.flush());
+  EXPECT_EQ(buffer.read(), 3);
+}
+
+TEST(LeftRightBufferTest, ConcurrentReadsAreNeverTorn) {
+  using Value = std::array<double, 4>;
+  LeftRightBuffer<Value> buffer(Value{0, 0, 0, 0});
+  std::atomic_bool done{false};
+  std::atomic_int tornReads{0};
+  std::atomic_int backwardReads{0};
+
+  auto reader = [&]() {
+    double last = 0;
+    while (!done.load()) {
+      const Value value = buffer.read();
+      if (value[1] != value[0] || value[2] != value[0] || value[3] != value[0]) {
+        tornReads++;
+      }
+      if (value[0] < last) {
+        backwardReads++;
+      }
+      last = value[0];
+    }
+  };
+
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 3; i++) {
+    readers.emplace_back(reader);
+  }
+
+  for (int i = 1; i <= 200000; i++) {
+    const auto value = static_cast<double>(i);
+    buffer.write(Value{value, value, value, value});
+  }
+
+  // Keep flushing until a held back value is published
+  while (!buffer.flush()) {
+    std::this_thread::yield();
+  }
+
+  done.store(true);
+  for (auto &thread : readers) {
+    thread.join();
+  }
+
+  EXPECT_EQ(tornReads.load(), 0);
+  EXPECT_EQ(backwardReads.load(), 0);
+  EXPECT_EQ(buffer.read()[0], 200000);
+}
+
+TEST(ParallelForTest, CallsEveryIndexOnce) {
+  for (const std::size_t numThreads : {1, 4}) {
+    std::vector<std::atomic_int> calls(100);
+    MockRate rate;
+    parallelFor(calls.size(), numThreads, [&](const std::size_t i) { calls.at(i)++; }, rate);
+
+    for (const auto &count : calls) {
+      EXPECT_EQ(count.load(), 1);
+    }
+  }
+}
+
+TEST(ParallelForTest, OneThreadRunsOnTheCallingThread) {
+  const auto caller = std::this_thread::get_id();
+  std::size_t numCalls = 0;
+  MockRate rate;
+  parallelFor(
+    3,
+    1,
+    [&](std::size_t) {
+      EXPECT_EQ(std::this_thread::get_id(), caller);
+      numCalls++;
+    },
+    rate);
+
+  EXPECT_EQ(numCalls, 3);
+}
+
+TEST(TimestampedHistoryTest, InterpolatesBetweenValues) {
+  TimestampedHistory<double> history(4);
+  history.add(10_ms, 1);
+  history.add(20_ms, 3);
+  history.add(40_ms, -1);
+
+  double value = 0;
+  EXPECT_TRUE(history.get(10_ms, value));
+  EXPECT_DOUBLE_EQ(value, 1);
+  EXPECT_TRUE(history.get(15_ms, value));
+  EXPECT_DOUBLE_EQ(value, 2);
+  EXPECT_TRUE(history.get(20_ms, value));
+  EXPECT_DOUBLE_EQ(value, 3);
+  EXPECT_TRUE(history.get(35_ms, value));
+  EXPECT_NEAR(value, 0, 1e-12);
+  EXPECT_TRUE(history.get(40_ms, value));
+  EXPECT_DOUBLE_EQ(value, -1);
+}
+
+TEST(TimestampedHistoryTest, TimesOutsideTheHistoryAreNotFound) {
+  TimestampedHistory<double> history(4);
+  double value = 5;
+  EXPECT_FALSE(history.get(0_ms, value));
+
+  history.add(10_ms, 1);
+  history.add(20_ms, 3);
+  EXPECT_FALSE(history.get(9_ms, value));
+  EXPECT_FALSE(history.get(21_ms, value));
+  EXPECT_DOUBLE_EQ(value, 5);
+}
+
+TEST(TimestampedHistoryTest, ValuesMustBeAddedInOrder) {
+  TimestampedHistory<double> history(4);
+  EXPECT_TRUE(history.add(10_ms, 1));
+  EXPECT_FALSE(history.add(10_ms, 2));
+  EXPECT_FALSE(history.add(5_ms, 2));
+  EXPECT_EQ(history.size(), 1);
+}
+
+TEST(TimestampedHistoryTest, OldestValuesAreReplacedWhenFull) {
+  TimestampedHistory<double> history(3);
+  for (int i = 1; i <= 7; i++) {
+    history.add(i * 10_ms, i);
+  }
+
+  EXPECT_EQ(history.size(), 3);
+  EXPECT_EQ(history.capacity(), 3);
+  EXPECT_EQ(history.oldestTime(), 50_ms);
+  EXPECT_EQ(history.newestTime(), 70_ms);
+
+  double value = 0;
+  EXPECT_FALSE(history.get(45_ms, value));
+  EXPECT_TRUE(history.get(55_ms, value));
+  EXPECT_DOUBLE_EQ(value, 5.5);
+  EXPECT_TRUE(history.get(65_ms, value));
+  EXPECT_DOUBLE_EQ(value, 6.5);
+
+  history.clear();
+  EXPECT_EQ(history.size(), 0);
+  EXPECT_FALSE(history.get(65_ms, value));
+}
+
+TEST(TimestampedHistoryTest, InterpolatesSnapshotsOfSeveralSensors) {
+  TimestampedHistory<std::array<double, 3>> history(2);
+  history.add(0_ms, {0, 10, 100});
+  history.add(10_ms, {2, 20, 0});
+
+  std::array<double, 3> value{};
+  EXPECT_TRUE(history.get(5_ms, value));
+  EXPECT_DOUBLE_EQ(value[0], 1);
+  EXPECT_DOUBLE_EQ(value[1], 15);
+  EXPECT_DOUBLE_EQ(value[2], 50);
+}
+
+TEST(TimestampedHistoryTest, ConstructorThrowsOnZeroCapacity) {
+  EXPECT_THROW(TimestampedHistory<double>(0), std::invalid_argument);
+}
+
+TEST(TimestampedHistoryTest, DISABLED_BenchmarkLookup) {
+  // A lookup is a binary search, so its time grows with the log of the size
+  for (const std::size_t capacity : {16, 256, 4096}) {
+    TimestampedHistory<double> history(capacity);
+    for (std::size_t i = 0; i < capacity + capacity / 2; i++) {
+      history.add(static_cast<double>(i) * millisecond, static_cast<double>(i));
+    }
+
+    const double oldest = history.oldestTime().convert(millisecond);
+    const double span = history.newestTime().convert(millisecond) - oldest;
+    double value = 0;
+    double sum = 0;
+    std::size_t i = 0;
+    const double ns = benchmarkNsPerCall(
+      [&]() {
+        history.get((oldest + span * static_cast<double>(i++ % 97) / 97) * millisecond, value);
+        sum += value;
+      },
+      100000);
+
+    std::cout << "TimestampedHistory lookup with " << capacity << " values: " << ns << " ns"
+              << std::endl;
+    EXPECT_TRUE(std::isfinite(sum));
+  }
+}
@@ -105,6 +105,62 @@ TEST_F(XDriveModelTest, StopTest) {
   assertAllMotorsLastVelocity(0);
 }
 
+TEST_F(XDriveModelTest, SetWheelCommandsVelocity) {
+  model.setWheelCommands({0.5, -0.25, 1, -1}, XDriveModel::commandMode::velocity);
+
+  assertAllMotorsLastVoltage(0);
+  EXPECT_EQ(topLeftMotor->lastVelocity, 63);
+  EXPECT_EQ(topRightMotor->lastVelocity, -31);
+  EXPECT_EQ(bottomRightMotor->lastVelocity, 127);
+  EXPECT_EQ(bottomLeftMotor->lastVelocity, -127);
+}
+
+TEST_F(XDriveModelTest, SetWheelCommandsVoltage) {
+  model.setWheelCommands({0.5, -0.25, 1, -1}, XDriveModel::commandMode::voltage);
+
+  assertAllMotorsLastVelocity(0);
+  EXPECT_EQ(topLeftMotor->lastVoltage, 6000);
+  EXPECT_EQ(topRightMotor->lastVoltage, -3000);
+  EXPECT_EQ(bottomRightMotor->lastVoltage, 12000);
+  EXPECT_EQ(bottomLeftMotor->lastVoltage, -12000);
+}
+
+TEST_F(XDriveModelTest, SetWheelCommandsScalesDownTogether) {
+  model.setWheelCommands({2, -1, 0.5, 0}, XDriveModel::commandMode::voltage);
+
+  EXPECT_EQ(topLeftMotor->lastVoltage, 12000);
+  EXPECT_EQ(topRightMotor->lastVoltage, -6000);
+  EXPECT_EQ(bottomRightMotor->lastVoltage, 3000);
+  EXPECT_EQ(bottomLeftMotor->lastVoltage, 0);
+}
+
+TEST_F(XDriveModelTest, DriveHolonomicStrafe) {
+  model.driveHolonomic(0, 0.5, 0);
+
+  assertAllMotorsLastVelocity(0);
+  EXPECT_EQ(topLeftMotor->lastVoltage, 6000);
+  EXPECT_EQ(topRightMotor->lastVoltage, -6000);
+  EXPECT_EQ(bottomRightMotor->lastVoltage, 6000);
+  EXPECT_EQ(bottomLeftMotor->lastVoltage, -6000);
+}
+
+TEST_F(XDriveModelTest, DriveHolonomicDesaturatesInsteadOfClamping) {
+  // xArcade clamps these to {1, -1, 1, 1}, which turns the robot; desaturation keeps the ratios
+  model.driveHolonomic(1, 1, 1);
+
+  EXPECT_EQ(topLeftMotor->lastVoltage, 12000);
+  EXPECT_EQ(topRightMotor->lastVoltage, -4000);
+  EXPECT_EQ(bottomRightMotor->lastVoltage, 4000);
+  EXPECT_EQ(bottomLeftMotor->lastVoltage, 4000);
+}
+
+TEST_F(XDriveModelTest, DriveHolonomicVelocityMode) {
+  model.driveHolonomic(0.5, 0, 0, XDriveModel::commandMode::velocity);
+
+  assertAllMotorsLastVoltage(0);
+  assertAllMotorsLastVelocity(63);
+}
+
 TEST_F(XDriveModelTest, LeftHalfPower) {
   model.left(0.5);
   assertLeftAndRightMotorsLastVelocity(63, 0);